@@ -0,0 +1,179 @@
+APPNAME = 'ns'
+AR = ['/usr/bin/ar']
+ARFLAGS = ['rcs']
+BINDIR = '/usr/local/bin'
+BOOST_VERSION = '1_74'
+BUILD_PROFILE = 'debug'
+BUILD_SUFFIX = '-debug'
+CC = ['/usr/bin/gcc']
+CCDEFINES = ['_DEBUG']
+CCFLAGS = ['-O0', '-ggdb', '-g3', '-Wall', '-O0', '-ggdb', '-g3', '-Wall', '-std=c++11', '-fstrict-aliasing', '-Wstrict-aliasing']
+CCFLAGS_PTHREAD = '-pthread'
+CCFLAGS_PYEXT = ['-fvisibility=hidden']
+CCLNK_SRC_F = []
+CCLNK_TGT_F = ['-o']
+CC_NAME = 'gcc'
+CC_SRC_F = []
+CC_TGT_F = ['-c', '-o']
+CC_VERSION = ('12', '2', '0')
+CFLAGS_MACBUNDLE = ['-fPIC']
+CFLAGS_PYEMBED = ['-fno-strict-aliasing', '-g', '-O2', '-g', '-fwrapv', '-O3']
+CFLAGS_PYEXT = ['-fno-strict-aliasing', '-g', '-O2', '-g', '-fwrapv', '-O3']
+CFLAGS_cshlib = ['-fPIC']
+COMPILER_CC = 'gcc'
+COMPILER_CXX = 'g++'
+CPPPATH_ST = '-I%s'
+CXX = ['/usr/bin/g++']
+CXXDEFINES = ['_DEBUG']
+CXXFLAGS = ['-O0', '-ggdb', '-g3', '-Wall', '-std=c++11', '-fstrict-aliasing', '-Wstrict-aliasing']
+CXXFLAGS_MACBUNDLE = ['-fPIC']
+CXXFLAGS_PTHREAD = '-pthread'
+CXXFLAGS_PYEMBED = ['-fno-strict-aliasing', '-g', '-O2', '-g', '-fwrapv', '-O3']
+CXXFLAGS_PYEXT = ['-fno-strict-aliasing', '-g', '-O2', '-g', '-fwrapv', '-O3', '-fvisibility=hidden', '-Wno-array-bounds']
+CXXFLAGS_cxxshlib = ['-fPIC']
+CXXLNK_SRC_F = []
+CXXLNK_TGT_F = ['-o']
+CXX_NAME = 'gcc'
+CXX_SRC_F = []
+CXX_TGT_F = ['-c', '-o']
+DATADIR = '/usr/local/share'
+DATAROOTDIR = '/usr/local/share'
+DEFINES = ['NS3_BUILD_PROFILE_DEBUG', 'NS3_ASSERT_ENABLE', 'NS3_LOG_ENABLE', 'HAVE_SYS_IOCTL_H=1', 'HAVE_IF_NETS_H=1', 'HAVE_NET_ETHERNET_H=1', 'HAVE_PACKET_H=1', 'HAVE_SQLITE3=1', 'HAVE_SYS_MMAN_H=1', 'HAVE_IF_TUN_H=1', 'HAVE_CRYPTO=1']
+DEFINES_PYEMBED = ['NDEBUG']
+DEFINES_PYEXT = ['NDEBUG']
+DEFINES_ST = '-D%s'
+DEFINE_COMMENTS = {'HAVE_SYS_IOCTL_H': '', 'HAVE_IF_NETS_H': '', 'HAVE_SIGNAL_H': '', 'HAVE_SYS_TYPES_H': '', 'PYTHONDIR': '', 'INT64X64_USE_128': '', 'HAVE_DIRENT_H': '', 'HAVE_STDINT_H': '', 'HAVE_SQLITE3': '', 'HAVE_LIBXML2': '', 'HAVE_NET_ETHERNET_H': '', 'HAVE_PYEXT': '', 'HAVE_CRYPTO': '', 'HAVE_SYS_STAT_H': '', 'HAVE_PACKET_H': '', 'HAVE_INTTYPES_H': '', 'HAVE_STDLIB_H': '', 'HAVE_PTHREAD_H': '', 'HAVE_PYTHON_H': '', 'HAVE___UINT128_T': '', 'HAVE_PYEMBED': '', 'PYTHONARCHDIR': '', 'HAVE_SYS_MMAN_H': '', 'HAVE_GETENV': '', 'HAVE_RT': '', 'HAVE_IF_TUN_H': '', 'HAVE_SYS_INT_TYPES_H': '', 'HAVE_UINT128_T': ''}
+DEST_BINFMT = 'elf'
+DEST_CPU = 'x86_64'
+DEST_OS = 'linux'
+DOCDIR = '/usr/local/share/doc/ns'
+DVIDIR = '/usr/local/share/doc/ns'
+ENABLE_BRITE = False
+ENABLE_EMU = True
+ENABLE_EXAMPLES = False
+ENABLE_FDNETDEV = True
+ENABLE_GSL = None
+ENABLE_GTK = None
+ENABLE_LIBXML2 = '-I/usr/include/libxml2 -lxml2 \n'
+ENABLE_NSC = False
+ENABLE_OPTIONAL_TRACES = True
+ENABLE_PYTHON_BINDINGS = False
+ENABLE_PYVIZ = False
+ENABLE_REAL_TIME = True
+ENABLE_SHARED_MEMORY_METRICS = True
+ENABLE_STATIC_NS3 = False
+ENABLE_SUDO = False
+ENABLE_TAP = True
+ENABLE_TESTS = True
+ENABLE_THREADING = True
+EXAMPLE_DIRECTORIES = ['tcp', 'energy', 'routing', 'stats', 'udp-client-server', 'error-model', 'wireless', 'tutorial', 'udp', 'socket', 'realtime', 'naming', 'ipv6', 'traffic-control', 'matrix-topology']
+EXEC_PREFIX = '/usr/local'
+HAVE_CRYPTO = 1
+HAVE_DIRENT_H = 1
+HAVE_INTTYPES_H = 1
+HAVE_LIBXML2 = 1
+HAVE_LINUX_IF_TUN_H = 1
+HAVE_NETPACKET_PACKET_H = 1
+HAVE_NET_ETHERNET_H = 1
+HAVE_NET_IF_H = 1
+HAVE_PTHREAD_H = 1
+HAVE_PYEMBED = 1
+HAVE_PYEXT = 1
+HAVE_PYTHON_H = 1
+HAVE_RT = 1
+HAVE_SIGNAL_H = 1
+HAVE_SQLITE3 = 1
+HAVE_STDINT_H = 1
+HAVE_STDLIB_H = 1
+HAVE_SYS_IOCTL_H = 1
+HAVE_SYS_MMAN_H = 1
+HAVE_SYS_STAT_H = 1
+HAVE_SYS_TYPES_H = 1
+HAVE___UINT128_T = 1
+HTMLDIR = '/usr/local/share/doc/ns'
+INCLUDEDIR = '/usr/local/include'
+INCLUDES_BOOST = '/usr/include'
+INCLUDES_LIBXML2 = ['/usr/include/libxml2']
+INCLUDES_PYEMBED = ['/root/.pyenv/versions/2.7.18/include/python2.7']
+INCLUDES_PYEXT = ['/root/.pyenv/versions/2.7.18/include/python2.7']
+INFODIR = '/usr/local/share/info'
+INT64X64_USE_128 = 1
+LIBDIR = '/usr/local/lib64'
+LIBEXECDIR = '/usr/local/libexec'
+LIBGCRYPT_CONFIG = ['/usr/bin/libgcrypt-config']
+LIBPATH_GCRYPT = ['/usr/lib/x86_64-linux-gnu']
+LIBPATH_PYEMBED = ['/root/.pyenv/versions/2.7.18/lib']
+LIBPATH_PYEXT = ['/root/.pyenv/versions/2.7.18/lib']
+LIBPATH_ST = '-L%s'
+LIB_BOOST = []
+LIB_GCRYPT = ['gcrypt']
+LIB_LIBXML2 = ['xml2']
+LIB_PYEMBED = ['python2.7', 'dl', 'm', 'python2.7', 'dl', 'm']
+LIB_PYEXT = ['python2.7', 'dl', 'm', 'python2.7', 'dl', 'm']
+LIB_RT = ['rt']
+LIB_SQLITE3 = ['sqlite3']
+LIB_ST = '-l%s'
+LINKFLAGS_MACBUNDLE = ['-bundle', '-undefined', 'dynamic_lookup']
+LINKFLAGS_PTHREAD = '-pthread'
+LINKFLAGS_PYEMBED = ['-Xlinker', '-export-dynamic']
+LINKFLAGS_PYEXT = ['-Xlinker', '-export-dynamic']
+LINKFLAGS_cshlib = ['-shared']
+LINKFLAGS_cstlib = ['-Wl,-Bstatic']
+LINKFLAGS_cxxshlib = ['-shared']
+LINKFLAGS_cxxstlib = ['-Wl,-Bstatic']
+LINK_CC = ['/usr/bin/gcc']
+LINK_CXX = ['/usr/bin/g++']
+LOCALEDIR = '/usr/local/share/locale'
+LOCALSTATEDIR = '/usr/local/var'
+MANDIR = '/usr/local/share/man'
+MODULES_NOT_BUILT = ['brite', 'click', 'openflow', 'visualizer']
+NS3_CONTRIBUTED_MODULES = ['ns3-helics']
+NS3_ENABLED_CONTRIBUTED_MODULES = []
+NS3_ENABLED_MODULES = ['ns3-core', 'ns3-network', 'ns3-point-to-point', 'ns3-csma', 'ns3-stats', 'ns3-flow-monitor', 'ns3-netanim', 'ns3-wifi', 'ns3-spectrum', 'ns3-propagation', 'ns3-mobility', 'ns3-internet', 'ns3-traffic-control', 'ns3-applications', 'ns3-config-store']
+NS3_EXECUTABLE_PATH = ['/root/repo/build/src/fd-net-device', '/root/repo/build/src/tap-bridge']
+NS3_MODULES = ['ns3-antenna', 'ns3-aodv', 'ns3-applications', 'ns3-bridge', 'ns3-brite', 'ns3-buildings', 'ns3-click', 'ns3-config-store', 'ns3-core', 'ns3-csma', 'ns3-csma-layout', 'ns3-dsdv', 'ns3-dsr', 'ns3-energy', 'ns3-fd-net-device', 'ns3-flow-monitor', 'ns3-internet', 'ns3-internet-apps', 'ns3-lr-wpan', 'ns3-lte', 'ns3-mesh', 'ns3-mobility', 'ns3-mpi', 'ns3-netanim', 'ns3-network', 'ns3-nix-vector-routing', 'ns3-olsr', 'ns3-openflow', 'ns3-point-to-point', 'ns3-point-to-point-layout', 'ns3-propagation', 'ns3-sixlowpan', 'ns3-spectrum', 'ns3-stats', 'ns3-tap-bridge', 'ns3-test', 'ns3-topology-read', 'ns3-traffic-control', 'ns3-uan', 'ns3-virtual-net-device', 'ns3-visualizer', 'ns3-wave', 'ns3-wifi', 'ns3-wimax']
+NS3_MODULE_PATH = ['/usr/lib/gcc/x86_64-linux-gnu/12', '/root/repo/build/lib']
+NS3_OPTIONAL_FEATURES = [('python', 'Python Bindings', False, 'PyBindGen missing'), ('brite', 'BRITE Integration', False, 'BRITE not enabled (see option --with-brite)'), ('nsclick', 'NS-3 Click Integration', False, 'nsclick not enabled (see option --with-nsclick)'), ('GtkConfigStore', 'GtkConfigStore', [], "library 'gtk+-3.0 >= 3.0' not found"), ('XmlIo', 'XmlIo', '-I/usr/include/libxml2 -lxml2 \n', "library 'libxml-2.0 >= 2.7' not found"), ('Threading', 'Threading Primitives', True, '<pthread.h> include not detected'), ('RealTime', 'Real Time Simulator', True, 'threading not enabled'), ('FdNetDevice', 'File descriptor NetDevice', True, 'FdNetDevice module enabled'), ('TapFdNetDevice', 'Tap FdNetDevice', True, 'Tap support enabled'), ('EmuFdNetDevice', 'Emulation FdNetDevice', True, 'Emulation support enabled'), ('PlanetLabFdNetDevice', 'PlanetLab FdNetDevice', False, 'PlanetLab operating system not detected (see option --force-planetlab)'), ('nsc', 'Network Simulation Cradle', False, 'NSC not found (see option --with-nsc)'), ('mpi', 'MPI Support', False, 'option --enable-mpi not selected'), ('openflow', 'NS-3 OpenFlow Integration', False, 'Required boost libraries not found'), ('SqliteDataOutput', 'SQlite stats data output', '-lsqlite3 \n', "library 'sqlite3' not found"), ('SharedMemoryMetrics', 'Shared memory live metrics', True, '<sys/mman.h> include not detected'), ('TapBridge', 'Tap Bridge', True, '<linux/if_tun.h> include not detected'), ('PyViz', 'PyViz visualizer', False, 'Python Bindings are needed but not enabled'), ('helics', 'helics integration', False, 'Required boost libraries not found'), ('ENABLE_SUDO', 'Use sudo to set suid bit', False, 'option --enable-sudo not selected'), ('ENABLE_TESTS', 'Tests', True, 'option --enable-tests selected'), ('ENABLE_EXAMPLES', 'Examples', False, 'option --disable-examples selected'), ('GSL', 'GNU Scientific Library (GSL)', [], 'GSL not found'), ('libgcrypt', 'Gcrypt library', [], 'libgcrypt not found: you can use libgcrypt-config to find its location.'), ('DES Metrics', 'DES Metrics event collection', [], 'defaults to disabled'), ('OptionalTraces', 'Optional (hot path) trace sources', True, 'enabled')]
+OLDINCLUDEDIR = '/usr/include'
+PACKAGE = 'ns'
+PDFDIR = '/usr/local/share/doc/ns'
+PKGCONFIG = ['/usr/bin/pkg-config']
+PLATFORM = 'linux2'
+PREFIX = '/usr/local'
+PRINT_BUILT_MODULES_AT_END = False
+PSDIR = '/usr/local/share/doc/ns'
+PYC = 1
+PYFLAGS = ''
+PYFLAGS_OPT = '-O'
+PYO = 1
+PYTHON = ['/root/.pyenv/versions/2.7.18/bin/python']
+PYTHONARCHDIR = '/usr/local/lib/python2.7/site-packages'
+PYTHONDIR = '/usr/local/lib/python2.7/site-packages'
+PYTHON_CONFIG = ['/root/.pyenv/versions/2.7.18/bin/python-config']
+PYTHON_VERSION = '2.7'
+REQUIRED_BOOST_LIBS = ['system', 'signals', 'filesystem']
+RPATH_PYEMBED = ['/root/.pyenv/versions/2.7.18/lib', '/root/.pyenv/versions/2.7.18/lib']
+RPATH_PYEXT = ['/root/.pyenv/versions/2.7.18/lib', '/root/.pyenv/versions/2.7.18/lib']
+RPATH_ST = '-Wl,-rpath,%s'
+SBINDIR = '/usr/local/sbin'
+SHAREDSTATEDIR = '/usr/local/com'
+SHLIB_MARKER = '-Wl,-Bdynamic'
+SONAME_ST = '-Wl,-h,%s'
+SQLITE_STATS = '-lsqlite3 \n'
+STLIBPATH_ST = '-L%s'
+STLIB_MARKER = '-Wl,-Bstatic'
+STLIB_ST = '-l%s'
+SYSCONFDIR = '/usr/local/etc'
+VALGRIND_FOUND = False
+VERSION = '3-dev'
+WL_SONAME_SUPPORTED = True
+cfg_files = ['/root/repo/build/ns3/config-store-config.h', '/root/repo/build/ns3/core-config.h']
+cprogram_PATTERN = '%s'
+cshlib_PATTERN = 'lib%s.so'
+cstlib_PATTERN = 'lib%s.a'
+cxxprogram_PATTERN = '%s'
+cxxshlib_PATTERN = 'lib%s.so'
+cxxstlib_PATTERN = 'lib%s.a'
+define_key = ['HAVE_SYS_IOCTL_H', 'HAVE_IF_NETS_H', 'HAVE_NET_ETHERNET_H', 'HAVE_IF_TUN_H', 'HAVE_PACKET_H', 'HAVE_SQLITE3', 'HAVE_SYS_MMAN_H', 'HAVE_CRYPTO']
+macbundle_PATTERN = '%s.bundle'
+pyext_PATTERN = '%s.so'
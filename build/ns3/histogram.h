@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// Copyright (c) 2009 INESC Porto
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// Author: Pedro Fortuna  <pedro.fortuna@inescporto.pt> <pedro.fortuna@gmail.com>
+//
+
+#ifndef NS3_HISTOGRAM_H
+#define NS3_HISTOGRAM_H
+
+#include <vector>
+#include <stdint.h>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \brief Class used to store data and make an histogram of the data frequency.
+ *
+ * Data are grouped in "bins", i.e., intervals. Each value is assigned to the
+ * bin according to the following formula: floor(value/binWidth).
+ * Hence, bin \a i groups the data from [i*binWidth, (i+1)binWidth).
+ *
+ * Alternatively, SetLogScaledBins selects log-scaled bins, in the style of
+ * HDR histograms: the first bins have the minimum width, and the width
+ * then doubles every time the value doubles, so that the relative error
+ * stays bounded and the number of bins only grows with the logarithm of
+ * the largest value.
+ *
+ * This class only handles \a positive bins, i.e., it does \a not handles negative data.
+ *
+ * \todo Add support for negative data.
+ *
+ * \todo Add method(s) to estimate parameters from the histogram,
+ * see http://www.dspguide.com/ch2/4.htm
+ *
+ */
+class Histogram
+{
+public:
+
+  // --- basic methods ---
+  /**
+   * \brief Constructor
+   * \param binWidth width of the histogram "bin".
+   */
+  Histogram (double binWidth);
+  Histogram ();
+
+  // Methods for Getting the Histogram Results
+  /**
+   * \brief Returns the number of bins in the histogram.
+   * \return the number of bins in the histogram
+   */
+  uint32_t GetNBins () const;
+  /**
+   * \brief Returns the bin start, i.e., index*binWidth
+   * \param index the bin index
+   * \return the bin start
+   */
+  double GetBinStart (uint32_t index) const;
+  /**
+   * \brief Returns the bin end, i.e., (index+1)*binWidth
+   * \param index the bin index
+   * \return the bin start
+   */
+  double GetBinEnd (uint32_t index) const;
+  /**
+   * \brief Returns the bin width.
+   *
+   * Note that all the bins have the same width, unless log-scaled bins
+   * are used.
+   *
+   * \param index the bin index
+   * \return the bin width
+   */
+  double GetBinWidth (uint32_t index) const;
+  /**
+   * \brief Set the bin width.
+   *
+   * Note that you can change the bin width only if the histogram is empty.
+   *
+   * \param binWidth the bin width
+   */
+  void SetDefaultBinWidth (double binWidth);
+  /**
+   * \brief Use log-scaled bins.
+   *
+   * The first \p subBins bins have a width of \p minBinWidth.  Each
+   * following range [subBins * 2^(b-1), subBins * 2^b) * minBinWidth,
+   * for b >= 1, is split in subBins / 2 bins of width 2^b * minBinWidth.
+   * The width of a bin is thus at most 2 / subBins of the values it holds.
+   *
+   * Note that the bins can be changed only if the histogram is empty.
+   *
+   * \param minBinWidth the width of the smallest bins
+   * \param subBins the number of bins of the smallest width, a power of
+   *        two not smaller than 2
+   */
+  void SetLogScaledBins (double minBinWidth, uint32_t subBins);
+  /**
+   * \brief Get the number of data added to the bin.
+   * \param index the bin index
+   * \return the number of data added to the bin
+   */
+  uint32_t GetBinCount (uint32_t index);
+
+  // Method for adding values
+  /**
+   * \brief Add a value to the histogram
+   * \param value the value to add
+   */
+  void AddValue (double value);
+  /**
+   * \brief Add values to the histogram
+   *
+   * Equivalent to calling AddValue for each value, but the bin indices
+   * are computed in tight loops which the compiler can vectorize, and
+   * the histogram is resized at most once.
+   *
+   * \param values the values to add
+   * \param n the number of values
+   */
+  void AddValues (const double *values, uint32_t n);
+
+  /**
+   * \brief Serializes the results to an std::ostream in XML format.
+   * \param os the output stream
+   * \param indent number of spaces to use as base indentation level
+   * \param elementName name of the element to serialize.
+   */
+  void SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string elementName) const;
+
+
+private:
+  /**
+   * \brief Get the bin of a value
+   * \param value the value
+   * \return the bin index
+   */
+  uint32_t GetIndex (double value) const;
+
+  std::vector<uint32_t> m_histogram; //!< Histogram data
+  double m_binWidth; //!< Bin width, or smallest bin width if m_subBins is not 0
+  uint32_t m_subBins; //!< Number of smallest bins if log-scaled, 0 otherwise
+};
+
+
+} // namespace ns3
+
+#endif /* NS3_HISTOGRAM_H */
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup memory-accounting
+ * ns3::MemoryAccounting declaration.
+ */
+
+namespace ns3 {
+
+class TypeId;
+class Time;
+
+/**
+ * \ingroup core
+ * \defgroup memory-accounting Memory accounting
+ *
+ * Opt-in accounting of the number and size of live objects.
+ */
+
+/**
+ * \ingroup memory-accounting
+ *
+ * \brief Count the live objects and bytes per TypeId or C++ type.
+ *
+ * Once enabled, every ns3::Object is accounted under its TypeId, with
+ * the size registered in the TypeId, and every other SimpleRefCount
+ * instance (Packet, EventImpl, ...) under its C++ type, with the size
+ * of that type.  Variable size blocks such as the Buffer data and the
+ * packet tag lists are accounted explicitly by their owners.
+ *
+ * Accounting costs a test of a global flag per construction and
+ * destruction when disabled.  It should be enabled before any object
+ * is created, e.g., at the start of main:
+ *
+ * \code
+ *   MemoryAccounting::Enable ();
+ *   MemoryAccounting::ScheduleReport (Seconds (10), std::cout);
+ *   MemoryAccounting::EnableDestroyReport (std::cout);
+ * \endcode
+ *
+ * Objects which are still alive once Simulator::Destroy has run are
+ * likely to be leaks, hence the report at Destroy.
+ *
+ * The counters are not synchronized: with the multithreaded simulator
+ * implementations, the counts are approximate.
+ */
+class MemoryAccounting
+{
+public:
+  /// The usage of one type
+  struct Counter
+  {
+    std::string name;     //!< Type name
+    int64_t count;        //!< Number of live instances
+    int64_t bytes;        //!< Size of the live instances
+    int64_t peakCount;    //!< Largest number of live instances
+    int64_t peakBytes;    //!< Largest size of the live instances
+    uint64_t allocations; //!< Number of instances created
+  };
+
+  /** Start accounting. */
+  static void Enable (void);
+  /** Stop accounting. */
+  static void Disable (void);
+  /**
+   * \returns true if accounting is enabled
+   */
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+
+  /**
+   * \param name the type name
+   * \returns the counter of this type name, created if needed
+   */
+  static Counter * GetCounter (const std::string &name);
+  /**
+   * \param tid the TypeId
+   * \returns the counter of this TypeId
+   */
+  static Counter * GetCounter (TypeId tid);
+  /**
+   * \tparam T \deduced the C++ type
+   * \returns the counter of this C++ type
+   */
+  template <typename T>
+  static Counter * GetCounter (void);
+
+  /**
+   * Account for a new instance.
+   * \param counter the counter of the type
+   * \param bytes the size of the instance
+   */
+  static void Allocate (Counter *counter, std::size_t bytes)
+  {
+    counter->count++;
+    counter->bytes += bytes;
+    counter->allocations++;
+    if (counter->bytes > counter->peakBytes)
+      {
+        counter->peakBytes = counter->bytes;
+      }
+    if (counter->count > counter->peakCount)
+      {
+        counter->peakCount = counter->count;
+      }
+  }
+  /**
+   * Account for a destroyed instance.
+   * \param counter the counter of the type
+   * \param bytes the size of the instance
+   */
+  static void Free (Counter *counter, std::size_t bytes)
+  {
+    counter->count--;
+    counter->bytes -= bytes;
+  }
+  /**
+   * Move a live instance to another type, e.g., when an Object
+   * gets its final TypeId.
+   * \param from the counter of the previous type
+   * \param fromBytes the previous size of the instance
+   * \param to the counter of the new type
+   * \param toBytes the new size of the instance
+   */
+  static void Retype (Counter *from, std::size_t fromBytes, Counter *to, std::size_t toBytes);
+
+  /**
+   * \returns a copy of the counters with live or past instances,
+   * by decreasing live bytes
+   */
+  static std::vector<Counter> GetSnapshot (void);
+  /**
+   * Print the counters of the types with live or past instances, by
+   * decreasing live bytes.
+   * \param os the output stream
+   */
+  static void Print (std::ostream &os);
+  /**
+   * Print the counters after some simulation time.
+   * \param delay the delay after which to print
+   * \param os the output stream, which must outlive the report
+   */
+  static void ScheduleReport (const Time &delay, std::ostream &os);
+  /**
+   * Print the counters once Simulator::Destroy has disposed every
+   * other object.
+   * \param os the output stream, which must outlive the report
+   */
+  static void EnableDestroyReport (std::ostream &os);
+
+private:
+  /**
+   * Print the counters, preceded by the simulation time.
+   * \param os the output stream
+   */
+  static void Report (std::ostream *os);
+  /**
+   * Schedule the report after the destroy events scheduled so far.
+   * \param os the output stream
+   */
+  static void ScheduleDestroyReport (std::ostream *os);
+  /**
+   * \param mangled a mangled C++ type name
+   * \returns the demangled name
+   */
+  static std::string Demangle (const char *mangled);
+
+  static bool m_enabled; //!< True if accounting is enabled
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+MemoryAccounting::Counter *
+MemoryAccounting::GetCounter (void)
+{
+  static Counter *counter = GetCounter (Demangle (typeid (T).name ()));
+  return counter;
+}
+
+} // namespace ns3
+
+#endif /* MEMORY_ACCOUNTING_H */
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <map>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Find the mobility models close to a position.
+ *
+ * The items, identified by their index in the order they were added,
+ * are kept in a uniform grid of square cells in the x-y plane.  The
+ * grid follows the CourseChange trace of the mobility models.
+ *
+ * Between two course changes, a model moves at a constant velocity,
+ * away from the cell in which it was last filed.  Rather than filing
+ * the moving models again on every query, the queries are widened by
+ * the distance that the fastest model may have traveled since the
+ * last time all the moving models were filed again, which happens
+ * once that distance exceeds half a cell.  Hence the mobility models
+ * whose velocity changes without a course change, like
+ * ConstantAccelerationMobilityModel, are not supported.
+ *
+ * The candidates returned by a query are a superset of the items
+ * within range: the callers check the actual distance or power.
+ */
+class SpatialIndex : public Object
+{
+public:
+  /**
+   * Register this type with the TypeId system.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  SpatialIndex ();
+  virtual ~SpatialIndex ();
+
+  /**
+   * \param cellSize the side of the square cells, in meters
+   *
+   * The items already added are filed again.
+   */
+  void SetCellSize (double cellSize);
+  /**
+   * \return the side of the square cells, in meters
+   */
+  double GetCellSize (void) const;
+
+  /**
+   * \param mobility the mobility model of the new item
+   * \return the index of the new item, i.e., the number of items
+   * added before
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * \return the number of items added
+   */
+  uint32_t GetN (void) const;
+  /**
+   * Get the items which may be within a range of a position.
+   *
+   * \param position the position
+   * \param range the range, in meters
+   * \param candidates the indexes of the candidate items, in
+   * increasing order
+   */
+  void GetCandidates (const Vector &position, double range, std::vector<uint32_t> &candidates);
+
+private:
+  virtual void DoDispose (void);
+  /**
+   * Remove all the items, and stop following their mobility models.
+   */
+  void Clear (void);
+
+  /// An item of the grid
+  struct Item
+  {
+    Ptr<MobilityModel> mobility; //!< Mobility model of the item
+    Vector position;             //!< Position when last filed
+    uint64_t cell;               //!< Key of the cell in which the item is filed
+  };
+
+  /**
+   * \param position a position
+   * \return the key of the cell containing this position
+   */
+  uint64_t GetCell (const Vector &position) const;
+  /**
+   * \param x the cell column
+   * \param y the cell row
+   * \return the key of this cell
+   */
+  static uint64_t GetCell (int64_t x, int64_t y);
+  /**
+   * File an item in the cell of its current position.
+   * \param index the index of the item
+   */
+  void File (uint32_t index);
+  /**
+   * Remove an item from its cell.
+   * \param index the index of the item
+   */
+  void Unfile (uint32_t index);
+  /**
+   * File again all the items, at their current position.
+   */
+  void Refresh (void);
+  /**
+   * Follow the course changes of a mobility model.
+   * \param mobility the mobility model
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  double m_cellSize;                   //!< Side of the cells, in meters
+  std::vector<Item> m_items;           //!< Items, by index
+  std::map<uint64_t, std::vector<uint32_t> > m_cells; //!< Indexes of the items in each non-empty cell
+  std::map<const MobilityModel *, std::vector<uint32_t> > m_byMobility; //!< Indexes of the items of each mobility model
+  double m_maxSpeed;                   //!< Largest speed since the last refresh, in m/s
+  Time m_lastRefresh;                  //!< Time at which all items were last filed
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_INDEX_H */
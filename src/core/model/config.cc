@@ -274,9 +274,24 @@ public:
    * \param [in] path The Config path.
    */
   Resolver (std::string path);
+  /**
+   * Construct from an already tokenized Config path.
+   *
+   * \param [in] tokens The Config path tokens, as returned by Tokenize().
+   */
+  Resolver (const std::vector<std::string> &tokens);
   /** Destructor. */
   virtual ~Resolver ();
 
+  /**
+   * Split a Config path into its tokens, ensuring first that the path
+   * starts and ends with a '/'.
+   *
+   * \param [in] path The Config path.
+   * \returns The tokens found between the slashes of the path.
+   */
+  static std::vector<std::string> Tokenize (std::string path);
+
   /**
    * Parse the stored Config path into an object reference,
    * beginning at the indicated root object.
@@ -287,23 +302,21 @@ public:
   void Resolve (Ptr<Object> root);
   
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] index The index of the next token of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t index, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] index The index of the next token of the Config path.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t index, const ObjectPtrContainerValue &vector);
   /**
    * Handle one object found on the path.
    *
@@ -326,39 +339,55 @@ private:
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The tokens of the Config path. */
+  std::vector<std::string> m_tokens;
 
 };  // class Resolver
 
 Resolver::Resolver (std::string path)
-  : m_path (path)
+  : m_tokens (Tokenize (path))
 {
   NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
 }
-Resolver::~Resolver ()
+Resolver::Resolver (const std::vector<std::string> &tokens)
+  : m_tokens (tokens)
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
+Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
+}
+
+std::vector<std::string>
+Resolver::Tokenize (std::string path)
+{
+  NS_LOG_FUNCTION (path);
 
   // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
+  std::string::size_type tmp = path.find ("/");
   if (tmp != 0)
     {
       // no slash at start
-      m_path = "/" + m_path;
+      path = "/" + path;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
     {
       // no slash at end
-      m_path = m_path + "/";
+      path = path + "/";
     }
+
+  std::vector<std::string> tokens;
+  std::string::size_type cur = 0;
+  std::string::size_type next = path.find ("/", 1);
+  while (next != std::string::npos)
+    {
+      tokens.push_back (path.substr (cur + 1, next - (cur + 1)));
+      cur = next;
+      next = path.find ("/", cur + 1);
+    }
+  return tokens;
 }
 
 void 
@@ -366,7 +395,7 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -392,13 +421,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t index, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << index << root);
 
-  if (next == std::string::npos)
+  if (index == m_tokens.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -414,8 +441,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const std::string &item = m_tokens[index];
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -426,11 +452,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (index + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -447,7 +472,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (index + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -477,7 +502,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (index + 1, object);
       m_workStack.pop_back ();
     }
   else 
@@ -516,7 +541,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                     }
                   foundMatch = true;
                   m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
+                  DoResolve (index + 1, object);
                   m_workStack.pop_back ();
                 }
               // attempt to cast to an object vector.
@@ -524,12 +549,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                 dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
               if (vectorChecker != 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
+                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath ());
                   foundMatch = true;
                   ObjectPtrContainerValue vector;
                   root->GetAttribute (info.name, vector);
                   m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
+                  DoArrayResolve (index + 1, vector);
                   m_workStack.pop_back ();
                 }
               // this could be anything else and we don't know what to do with it.
@@ -548,20 +573,15 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t index, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION(this << index << &container);
+  if (index == m_tokens.size ())
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  ArrayMatcher matcher = ArrayMatcher (m_tokens[index]);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -570,7 +590,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (index + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -583,6 +603,9 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
 class ConfigImpl : public Singleton<ConfigImpl>
 {
 public:
+  /** Constructor. */
+  ConfigImpl ();
+
   /** \copydoc Config::Set() */
   void Set (std::string path, const AttributeValue &value);
   /** \copydoc Config::ConnectWithoutContext() */
@@ -595,6 +618,22 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Find the objects matching an already tokenized Config path.
+   *
+   * \param [in] tokens The Config path tokens.
+   * \param [in] path The Config path.
+   * \returns The matching objects.
+   */
+  MatchContainer LookupMatches (const std::vector<std::string> &tokens, std::string path);
+
+  /** \copydoc Config::InvalidateCompiledPaths() */
+  void InvalidateCompiledPaths (void);
+  /**
+   * \returns The current generation of the Config namespace, which changes
+   *          every time InvalidateCompiledPaths() is called.
+   */
+  uint64_t GetGeneration (void) const;
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -622,8 +661,16 @@ private:
   /** The list of Config path roots. */
   Roots m_roots;
 
+  /** The generation of the Config namespace. */
+  uint64_t m_generation;
+
 };  // class ConfigImpl
 
+ConfigImpl::ConfigImpl ()
+  : m_generation (1)
+{
+}
+
 void 
 ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
 {
@@ -687,13 +734,20 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
 
 MatchContainer 
 ConfigImpl::LookupMatches (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  return LookupMatches (Resolver::Tokenize (path), path);
+}
+
+MatchContainer 
+ConfigImpl::LookupMatches (const std::vector<std::string> &tokens, std::string path)
 {
   NS_LOG_FUNCTION (this << path);
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const std::vector<std::string> &tokens)
+      : Resolver (tokens)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path)
     {
@@ -702,7 +756,7 @@ ConfigImpl::LookupMatches (std::string path)
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver = LookupMatchesResolver (tokens);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -723,6 +777,7 @@ ConfigImpl::RegisterRootNamespaceObject (Ptr<Object> obj)
 {
   NS_LOG_FUNCTION (this << obj);
   m_roots.push_back (obj);
+  InvalidateCompiledPaths ();
 }
 
 void 
@@ -735,11 +790,25 @@ ConfigImpl::UnregisterRootNamespaceObject (Ptr<Object> obj)
       if (*i == obj)
         {
           m_roots.erase (i);
+          InvalidateCompiledPaths ();
           return;
         }
     }
 }
 
+void
+ConfigImpl::InvalidateCompiledPaths (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_generation++;
+}
+
+uint64_t
+ConfigImpl::GetGeneration (void) const
+{
+  return m_generation;
+}
+
 std::size_t
 ConfigImpl::GetRootNamespaceObjectN (void) const
 {
@@ -881,6 +950,79 @@ Ptr<Object> GetRootNamespaceObject (uint32_t i)
   return ConfigImpl::Get ()->GetRootNamespaceObject (i);
 }
 
+void InvalidateCompiledPaths (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  ConfigImpl::Get ()->InvalidateCompiledPaths ();
+}
+
+CompiledPath::CompiledPath (std::string path)
+  : m_path (path),
+    m_generation (0)
+{
+  NS_LOG_FUNCTION (this << path);
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT_MSG (slash != std::string::npos, "Invalid Config path " << path);
+  m_leaf = path.substr (slash+1, path.size ()-(slash+1));
+  m_tokens = Resolver::Tokenize (path.substr (0, slash));
+}
+
+std::string
+CompiledPath::GetPath (void) const
+{
+  return m_path;
+}
+
+MatchContainer
+CompiledPath::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t generation = ConfigImpl::Get ()->GetGeneration ();
+  if (m_generation != generation)
+    {
+      NS_LOG_LOGIC ("Resolving " << m_path);
+      std::string root = m_path.substr (0, m_path.size () - (m_leaf.size () + 1));
+      m_matches = ConfigImpl::Get ()->LookupMatches (m_tokens, root);
+      m_generation = generation;
+    }
+  return m_matches;
+}
+
+void
+CompiledPath::Set (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << &value);
+  LookupMatches ().Set (m_leaf, value);
+}
+
+void
+CompiledPath::Connect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  LookupMatches ().Connect (m_leaf, cb);
+}
+
+void
+CompiledPath::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  LookupMatches ().ConnectWithoutContext (m_leaf, cb);
+}
+
+void
+CompiledPath::Disconnect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  LookupMatches ().Disconnect (m_leaf, cb);
+}
+
+void
+CompiledPath::DisconnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  LookupMatches ().DisconnectWithoutContext (m_leaf, cb);
+}
+
 } // namespace Config
 
 } // namespace ns3
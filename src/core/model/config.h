@@ -287,6 +287,103 @@ std::size_t GetRootNamespaceObjectN (void);
  */
 Ptr<Object> GetRootNamespaceObject (uint32_t i);
 
+/**
+ * \ingroup config
+ * Invalidate the object sets cached by every CompiledPath.
+ *
+ * This is called automatically whenever the object tree reachable from
+ * the Config namespace changes structurally: when a root namespace object
+ * is registered or unregistered, when a name is added, renamed or cleared
+ * in the Names service, when objects are aggregated, and when nodes,
+ * devices or applications are added.  It must be called explicitly after
+ * changing the value of a Pointer attribute which is traversed by a
+ * cached path.
+ */
+void InvalidateCompiledPaths (void);
+
+/**
+ * \ingroup config
+ * A Config path which is parsed only once and whose matching objects
+ * are cached across calls.
+ *
+ * Config::Set, Config::Connect and friends tokenize their path and walk
+ * the whole object tree every time they are called, which becomes very
+ * expensive with wildcard paths in large topologies.  A CompiledPath
+ * splits its path into the object path and the trailing attribute (or
+ * trace source) name once, at construction, and resolves the object path
+ * lazily the first time it is needed.  The resulting set of objects is
+ * reused by later calls until Config::InvalidateCompiledPaths is called.
+ *
+ * \code
+ *   Config::CompiledPath path ("/NodeList/[0-999]/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxBegin");
+ *   path.ConnectWithoutContext (MakeCallback (&PhyTxBegin));
+ *   ...
+ *   path.DisconnectWithoutContext (MakeCallback (&PhyTxBegin));
+ * \endcode
+ *
+ * Note that a CompiledPath holds references to the objects it matched
+ * until its cache is invalidated or the CompiledPath is destroyed.
+ */
+class CompiledPath
+{
+public:
+  /**
+   * Parse a Config path.
+   *
+   * \param [in] path The Config path, whose last token is the name of
+   *             the attribute or trace source to operate on.
+   */
+  CompiledPath (std::string path);
+
+  /**
+   * \returns The Config path.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns The objects which match the path, up to (but excluding)
+   *          the trailing attribute or trace source name.
+   */
+  MatchContainer LookupMatches (void) const;
+
+  /**
+   * \param [in] value Value to set to the attribute
+   * \sa ns3::Config::Set
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \param [in] cb The sink to connect to the trace source
+   * \sa ns3::Config::Connect
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to connect to the trace source
+   * \sa ns3::Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to disconnect from the trace source
+   * \sa ns3::Config::Disconnect
+   */
+  void Disconnect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The sink to disconnect from the trace source
+   * \sa ns3::Config::DisconnectWithoutContext
+   */
+  void DisconnectWithoutContext (const CallbackBase &cb) const;
+
+private:
+  /** The full Config path. */
+  std::string m_path;
+  /** The trailing attribute or trace source name. */
+  std::string m_leaf;
+  /** The tokens of the object path. */
+  std::vector<std::string> m_tokens;
+  /** The cached matching objects. */
+  mutable MatchContainer m_matches;
+  /** The generation of the cached matching objects; zero if never resolved. */
+  mutable uint64_t m_generation;
+};
+
 } // namespace Config
 
 } // namespace ns3
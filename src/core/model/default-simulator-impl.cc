@@ -413,6 +413,12 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint32_t
+DefaultSimulatorImpl::GetPendingEventCount (void) const
+{
+  return static_cast<uint32_t> (m_unscheduledEvents);
+}
+
 uint64_t
 DefaultSimulatorImpl::GetEventCount (void) const
 {
@@ -78,6 +78,7 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;;
+  virtual uint32_t GetPendingEventCount (void) const;
 
 private:
   virtual void DoDispose (void);
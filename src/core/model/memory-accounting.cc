@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include "memory-accounting.h"
+#include "type-id.h"
+#include "simulator.h"
+#include "log.h"
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup memory-accounting
+ * ns3::MemoryAccounting implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MemoryAccounting");
+
+bool MemoryAccounting::m_enabled = false;
+
+namespace {
+
+/**
+ * \ingroup memory-accounting
+ * \returns the counters by name.  The counters are never deleted, so
+ * that objects destroyed at exit can still be accounted.
+ */
+std::map<std::string, MemoryAccounting::Counter *> &
+GetCounters (void)
+{
+  static std::map<std::string, MemoryAccounting::Counter *> *counters =
+    new std::map<std::string, MemoryAccounting::Counter *> ();
+  return *counters;
+}
+
+/**
+ * \ingroup memory-accounting
+ * \returns the counters by TypeId uid
+ */
+std::vector<MemoryAccounting::Counter *> &
+GetTypeIdCounters (void)
+{
+  static std::vector<MemoryAccounting::Counter *> *counters =
+    new std::vector<MemoryAccounting::Counter *> ();
+  return *counters;
+}
+
+/**
+ * \ingroup memory-accounting
+ * Order the counters by decreasing live bytes, then by name.
+ * \param a the first counter
+ * \param b the second counter
+ * \returns true if \p a comes first
+ */
+bool
+CompareCounters (const MemoryAccounting::Counter &a, const MemoryAccounting::Counter &b)
+{
+  if (a.bytes != b.bytes)
+    {
+      return a.bytes > b.bytes;
+    }
+  return a.name < b.name;
+}
+
+} // unnamed namespace
+
+void
+MemoryAccounting::Enable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = true;
+}
+
+void
+MemoryAccounting::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+}
+
+MemoryAccounting::Counter *
+MemoryAccounting::GetCounter (const std::string &name)
+{
+  std::map<std::string, Counter *> &counters = GetCounters ();
+  std::map<std::string, Counter *>::iterator it = counters.find (name);
+  if (it != counters.end ())
+    {
+      return it->second;
+    }
+  Counter *counter = new Counter ();
+  counter->name = name;
+  counter->count = 0;
+  counter->bytes = 0;
+  counter->peakCount = 0;
+  counter->peakBytes = 0;
+  counter->allocations = 0;
+  counters[name] = counter;
+  return counter;
+}
+
+MemoryAccounting::Counter *
+MemoryAccounting::GetCounter (TypeId tid)
+{
+  std::vector<Counter *> &counters = GetTypeIdCounters ();
+  uint16_t uid = tid.GetUid ();
+  if (uid >= counters.size ())
+    {
+      counters.resize (uid + 1, 0);
+    }
+  if (counters[uid] == 0)
+    {
+      counters[uid] = GetCounter (tid.GetName ());
+    }
+  return counters[uid];
+}
+
+void
+MemoryAccounting::Retype (Counter *from, std::size_t fromBytes, Counter *to, std::size_t toBytes)
+{
+  if (from == to && fromBytes == toBytes)
+    {
+      return;
+    }
+  Free (from, fromBytes);
+  from->allocations--;
+  Allocate (to, toBytes);
+}
+
+std::vector<MemoryAccounting::Counter>
+MemoryAccounting::GetSnapshot (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<Counter> snapshot;
+  std::map<std::string, Counter *> &counters = GetCounters ();
+  for (std::map<std::string, Counter *>::const_iterator i = counters.begin (); i != counters.end (); ++i)
+    {
+      if (i->second->allocations > 0)
+        {
+          snapshot.push_back (*i->second);
+        }
+    }
+  std::sort (snapshot.begin (), snapshot.end (), CompareCounters);
+  return snapshot;
+}
+
+void
+MemoryAccounting::Print (std::ostream &os)
+{
+  NS_LOG_FUNCTION (&os);
+  std::vector<Counter> snapshot = GetSnapshot ();
+  int64_t count = 0;
+  int64_t bytes = 0;
+  os << std::setw (12) << "live" << std::setw (14) << "live bytes"
+     << std::setw (12) << "peak" << std::setw (14) << "peak bytes"
+     << std::setw (14) << "allocations" << "  type" << std::endl;
+  for (std::vector<Counter>::const_iterator i = snapshot.begin (); i != snapshot.end (); ++i)
+    {
+      os << std::setw (12) << i->count << std::setw (14) << i->bytes
+         << std::setw (12) << i->peakCount << std::setw (14) << i->peakBytes
+         << std::setw (14) << i->allocations << "  " << i->name << std::endl;
+      count += i->count;
+      bytes += i->bytes;
+    }
+  os << std::setw (12) << count << std::setw (14) << bytes << std::setw (40) << "" << "  total" << std::endl;
+}
+
+void
+MemoryAccounting::Report (std::ostream *os)
+{
+  NS_LOG_FUNCTION (os);
+  *os << "Memory accounting at " << Simulator::Now ().As (Time::S) << std::endl;
+  Print (*os);
+}
+
+void
+MemoryAccounting::ScheduleReport (const Time &delay, std::ostream &os)
+{
+  NS_LOG_FUNCTION (delay << &os);
+  Simulator::Schedule (delay, &MemoryAccounting::Report, &os);
+}
+
+void
+MemoryAccounting::ScheduleDestroyReport (std::ostream *os)
+{
+  NS_LOG_FUNCTION (os);
+  Simulator::ScheduleDestroy (&MemoryAccounting::Report, os);
+}
+
+void
+MemoryAccounting::EnableDestroyReport (std::ostream &os)
+{
+  NS_LOG_FUNCTION (&os);
+  // Destroy events run in order, and the ones scheduled while they run
+  // are appended: reschedule once so that the report comes after every
+  // destroy event scheduled before Simulator::Destroy.
+  Simulator::ScheduleDestroy (&MemoryAccounting::ScheduleDestroyReport, &os);
+}
+
+#if (__GNUC__ >= 3)
+
+std::string
+MemoryAccounting::Demangle (const char *mangled)
+{
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  std::string name = mangled;
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+  return name;
+}
+
+#else
+
+std::string
+MemoryAccounting::Demangle (const char *mangled)
+{
+  return mangled;
+}
+
+#endif
+
+} // namespace ns3
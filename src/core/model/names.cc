@@ -23,6 +23,7 @@
 #include "abort.h"
 #include "names.h"
 #include "singleton.h"
+#include "config.h"
 
 /**
  * \file
@@ -417,6 +418,7 @@ NamesPriv::Add (Ptr<Object> context, std::string name, Ptr<Object> object)
   NameNode *newNode = new NameNode (node, name, object);
   node->m_nameMap[name] = newNode;
   m_objectMap[object] = newNode;
+  Config::InvalidateCompiledPaths ();
 
   return true;
 }
@@ -539,6 +541,7 @@ NamesPriv::Rename (Ptr<Object> context, std::string oldname, std::string newname
       node->m_nameMap.erase (i);
       changeNode->m_name = newname;
       node->m_nameMap[newname] = changeNode;
+      Config::InvalidateCompiledPaths ();
       return true;
     }
 }
@@ -833,6 +836,7 @@ void
 Names::Clear (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  Config::InvalidateCompiledPaths ();
   return NamesPriv::Get ()->Clear ();
 }
 
@@ -25,6 +25,8 @@
 #include "attribute.h"
 #include "log.h"
 #include "string.h"
+#include "config.h"
+#include "memory-accounting.h"
 #include <vector>
 #include <sstream>
 #include <cstdlib>
@@ -46,6 +48,24 @@ NS_LOG_COMPONENT_DEFINE ("Object");
 
 NS_OBJECT_ENSURE_REGISTERED (Object);
 
+/**
+ * \ingroup object
+ * The size of an Object for MemoryAccounting: the size registered in
+ * its TypeId, or in the closest parent TypeId with a registered size.
+ * \param [in] tid The TypeId of the Object.
+ * \returns The size of the Object.
+ */
+static std::size_t
+GetAccountedSize (TypeId tid)
+{
+  while (tid.GetSize () == static_cast<std::size_t> (-1) && tid.HasParent () && tid.GetParent () != tid)
+    {
+      tid = tid.GetParent ();
+    }
+  std::size_t size = tid.GetSize ();
+  return size == static_cast<std::size_t> (-1) ? sizeof (Object) : size;
+}
+
 Object::AggregateIterator::AggregateIterator ()
   : m_object (0),
     m_current (0)
@@ -103,11 +123,19 @@ Object::Object ()
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  if (MemoryAccounting::IsEnabled ())
+    {
+      MemoryAccounting::Allocate (MemoryAccounting::GetCounter (m_tid), GetAccountedSize (m_tid));
+    }
 }
 Object::~Object () 
 {
   // remove this object from the aggregate list
   NS_LOG_FUNCTION (this);
+  if (MemoryAccounting::IsEnabled ())
+    {
+      MemoryAccounting::Free (MemoryAccounting::GetCounter (m_tid), GetAccountedSize (m_tid));
+    }
   uint32_t n = m_aggregates->n;
   for (uint32_t i = 0; i < n; i++)
     {
@@ -137,6 +165,10 @@ Object::Object (const Object &o)
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  if (MemoryAccounting::IsEnabled ())
+    {
+      MemoryAccounting::Allocate (MemoryAccounting::GetCounter (m_tid), GetAccountedSize (m_tid));
+    }
 }
 void
 Object::Construct (const AttributeConstructionList &attributes)
@@ -316,6 +348,9 @@ Object::AggregateObject (Ptr<Object> o)
   // Now that we are done with them, we can free our old aggregate buffers
   std::free (a);
   std::free (b);
+
+  // "$" tokens of Config paths may now resolve differently
+  Config::InvalidateCompiledPaths ();
 }
 /**
  * This function must be implemented in the stack that needs to notify
@@ -339,6 +374,11 @@ Object::SetTypeId (TypeId tid)
 {
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (Check ());
+  if (MemoryAccounting::IsEnabled ())
+    {
+      MemoryAccounting::Retype (MemoryAccounting::GetCounter (m_tid), GetAccountedSize (m_tid),
+                                MemoryAccounting::GetCounter (tid), GetAccountedSize (tid));
+    }
   m_tid = tid;
 }
 
@@ -34,6 +34,7 @@
 #include "rng-stream.h"
 #include "rng-seed-manager.h"
 #include "unused.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -138,6 +139,16 @@ RandomVariableStream::Peek(void) const
   return m_rng;
 }
 
+void
+RandomVariableStream::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId 
@@ -208,6 +219,21 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  Peek ()->RandU01 (values, n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      double v = m_min + values[i] * (m_max - m_min);
+      if (IsAntithetic ())
+        {
+          v = m_min + (m_max - v);
+        }
+      values[i] = v;
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
@@ -778,6 +804,69 @@ NormalRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_mean, m_variance, m_bound);
 }
+void
+NormalRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  const uint32_t maxUniforms = 256;
+  double uniforms[maxUniforms];
+  uint32_t count = 0;
+  uint32_t used = 0;
+  RngStream state (*Peek ());
+  double sigma = std::sqrt (m_variance);
+  uint32_t i = 0;
+  while (i < n)
+    {
+      if (m_nextValid)
+        {
+          m_nextValid = false;
+          values[i++] = m_next;
+          continue;
+        }
+      if (used == count)
+        {
+          // Two uniforms per attempt, and 4/pi attempts per good pair
+          uint32_t remaining = n - i;
+          count = std::min (maxUniforms, 2 * (remaining / 2 + remaining / 6 + 1));
+          state = *Peek ();
+          Peek ()->RandU01 (uniforms, count);
+          used = 0;
+        }
+      // Same algorithm as GetValue (double, double, double)
+      double u1 = uniforms[used++];
+      double u2 = uniforms[used++];
+      if (IsAntithetic ())
+        {
+          u1 = (1 - u1);
+          u2 = (1 - u2);
+        }
+      double v1 = 2 * u1 - 1;
+      double v2 = 2 * u2 - 1;
+      double w = v1 * v1 + v2 * v2;
+      if (w <= 1.0)
+        {
+          double y = std::sqrt ((-2 * std::log (w)) / w);
+          m_next = m_mean + v2 * y * sigma;
+          m_nextValid = std::fabs (m_next - m_mean) <= m_bound;
+          double x1 = m_mean + v1 * y * sigma;
+          if (std::fabs (x1 - m_mean) <= m_bound)
+            {
+              values[i++] = x1;
+            }
+          else if (m_nextValid)
+            {
+              m_nextValid = false;
+              values[i++] = m_next;
+            }
+        }
+    }
+  if (used < count)
+    {
+      // Give back the uniforms drawn but not consumed
+      *Peek () = state;
+      Peek ()->Advance (used);
+    }
+}
 
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
@@ -1131,13 +1220,26 @@ ErlangRandomVariable::GetValue (uint32_t k, double lambda)
 {
   NS_LOG_FUNCTION (this << k << lambda);
   double mean = lambda;
-  double bound = 0.0;
 
+  // The exponential values are not bounded, so each one takes exactly
+  // one uniform: draw them in blocks
+  const uint32_t maxUniforms = 64;
+  double uniforms[maxUniforms];
   double result = 0;
-  for (unsigned int i = 0; i < k; ++i)
+  while (k > 0)
     {
-      result += GetExponentialValue (mean, bound);
-
+      uint32_t count = std::min (k, maxUniforms);
+      Peek ()->RandU01 (uniforms, count);
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          double v = uniforms[i];
+          if (IsAntithetic ())
+            {
+              v = (1 - v);
+            }
+          result += -mean*std::log (v);
+        }
+      k -= count;
     }
 
   return result;
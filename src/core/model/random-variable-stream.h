@@ -149,6 +149,19 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Fill a block with the next random values drawn from the distribution.
+   *
+   * The block holds the same values, in the same order, as \p n
+   * successive calls to GetValue().  The default implementation calls
+   * GetValue(); distributions which draw their uniforms in blocks
+   * override it.
+   *
+   * \param [out] values The block to fill.
+   * \param [in] n The number of values to generate.
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RngStream.
@@ -294,6 +307,12 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  /**
+   * \brief Fill a block with the next random values drawn from the distribution.
+   * \param [out] values The block to fill.
+   * \param [in] n The number of values to generate.
+   */
+  virtual void GetValues (double *values, uint32_t n);
   
 private:
   /** The lower bound on values that can be returned by this RNG stream. */
@@ -1234,6 +1253,20 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+  /**
+   * \brief Fill a block with the next random values drawn from the distribution.
+   *
+   * The uniforms are drawn in blocks.  As the number of uniforms
+   * consumed by the rejection method is not known in advance, the
+   * unused ones are given back by jumping the RngStream ahead from
+   * its state before the last block, so that the stream stays in
+   * step with successive calls to GetValue().
+   *
+   * \param [out] values The block to fill.
+   * \param [in] n The number of values to generate.
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
 private:
   /** The mean value for the normal distribution returned by this RNG stream. */
   double m_mean;
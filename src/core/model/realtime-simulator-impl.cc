@@ -819,6 +819,12 @@ RealtimeSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint32_t
+RealtimeSimulatorImpl::GetPendingEventCount (void) const
+{
+  return static_cast<uint32_t> (m_unscheduledEvents);
+}
+
 uint64_t
 RealtimeSimulatorImpl::GetEventCount (void) const
 {
@@ -70,6 +70,25 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Fill a block with the next random numbers for this stream.
+   * Uniformly distributed between 0 and 1.
+   *
+   * The block holds the same numbers, in the same order, as \p n
+   * successive calls to RandU01(), but the generator state stays in
+   * registers for the whole block.
+   *
+   * \param [out] values The block to fill.
+   * \param [in] n The number of values to generate.
+   */
+  void RandU01 (double *values, uint32_t n);
+  /**
+   * Jump ahead in this stream, as if RandU01() had been called
+   * \p n times, in O(log n) operations.
+   *
+   * \param [in] n The number of random numbers to skip.
+   */
+  void Advance (uint64_t n);
 
 private:
   /**
@@ -26,8 +26,10 @@
 #include "default-deleter.h"
 #include "assert.h"
 #include "unused.h"
+#include "memory-accounting.h"
 #include <stdint.h>
 #include <limits>
+#include <type_traits>
 
 /**
  * \file
@@ -37,6 +39,8 @@
 
 namespace ns3 {
 
+class Object;
+
 /**
  * \ingroup ptr
  * \brief A template-based reference counting class
@@ -76,7 +80,9 @@ public:
   /** Default constructor.  */
   SimpleRefCount ()
     : m_count (1)
-  {}
+  {
+    AccountAllocation ();
+  }
   /**
    * Copy constructor
    * \param [in] o The object to copy into this one.
@@ -85,6 +91,16 @@ public:
     : m_count (1)
   {
     NS_UNUSED (o);
+    AccountAllocation ();
+  }
+  /** Destructor. */
+  ~SimpleRefCount ()
+  {
+    // Objects are accounted per TypeId by Object itself
+    if (MemoryAccounting::IsEnabled () && !std::is_same<T, Object>::value)
+      {
+        MemoryAccounting::Free (MemoryAccounting::GetCounter<T> (), sizeof (T));
+      }
   }
   /**
    * Assignment operator
@@ -134,6 +150,15 @@ public:
   }
 
 private:
+  /** Account for this instance if MemoryAccounting is enabled. */
+  void AccountAllocation (void)
+  {
+    if (MemoryAccounting::IsEnabled () && !std::is_same<T, Object>::value)
+      {
+        MemoryAccounting::Allocate (MemoryAccounting::GetCounter<T> (), sizeof (T));
+      }
+  }
+
   /**
    * The reference count.
    *
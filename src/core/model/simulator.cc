@@ -330,6 +330,12 @@ Simulator::GetEventCount (void)
   return GetImpl ()-> GetEventCount ();
 }
 
+uint32_t
+Simulator::GetPendingEventCount (void)
+{
+  return GetImpl ()->GetPendingEventCount ();
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
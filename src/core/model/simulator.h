@@ -203,6 +203,13 @@ public:
    * \returns The total number of events executed.
    */
   static uint64_t GetEventCount (void);
+
+  /**
+   * Get the number of events scheduled but not executed yet,
+   * i.e., the current size of the scheduler.
+   * \returns The number of pending events.
+   */
+  static uint32_t GetPendingEventCount (void);
   
 
   /**
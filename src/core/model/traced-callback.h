@@ -30,6 +30,65 @@
  * ns3::TracedCallback declaration and template implementation.
  */
 
+/**
+ * \ingroup tracing
+ * Invoke a TracedCallback only if at least one sink is connected.
+ *
+ * Calling the TracedCallback directly evaluates every argument
+ * before the (possibly empty) chain of Callbacks is visited.  This
+ * macro checks TracedCallback::IsEmpty first, so arguments which are
+ * expensive to build cost nothing while the trace source is unused.
+ *
+ * \param [in] tc The TracedCallback to invoke.
+ * \param [in] ... The arguments to pass to the Callbacks.
+ */
+#define NS_TRACE(tc, ...)                       \
+  do                                            \
+    {                                           \
+      if (!(tc).IsEmpty ())                     \
+        {                                       \
+          (tc) (__VA_ARGS__);                   \
+        }                                       \
+    }                                           \
+  while (false)
+
+#ifdef NS3_OPTIONAL_TRACES_DISABLE
+
+#define NS_TRACE_OPTIONAL_ENABLED(tc) false
+#define NS_TRACE_OPTIONAL(tc, ...)
+
+#else /* NS3_OPTIONAL_TRACES_DISABLE */
+
+/**
+ * \ingroup tracing
+ * Check if an optional trace source should be fired.
+ *
+ * Use this to guard code which only computes the arguments of an
+ * NS_TRACE_OPTIONAL() invocation.
+ *
+ * \param [in] tc The TracedCallback.
+ * \returns \c false if optional traces are compiled out or no sink
+ *          is connected to \p tc.
+ */
+#define NS_TRACE_OPTIONAL_ENABLED(tc) (!(tc).IsEmpty ())
+
+/**
+ * \ingroup tracing
+ * Invoke a TracedCallback on a hot path.
+ *
+ * This behaves like NS_TRACE() unless ns-3 was configured with
+ * \c --disable-optional-traces, in which case the invocation and its
+ * arguments are compiled out entirely, in the same way NS_LOG()
+ * statements are removed from optimized builds.  Sinks may still be
+ * connected to such a trace source, but they are never called.
+ *
+ * \param [in] tc The TracedCallback to invoke.
+ * \param [in] ... The arguments to pass to the Callbacks.
+ */
+#define NS_TRACE_OPTIONAL(tc, ...) NS_TRACE (tc, __VA_ARGS__)
+
+#endif /* NS3_OPTIONAL_TRACES_DISABLE */
+
 namespace ns3 {
 
 /**
@@ -93,6 +152,15 @@ public:
    * \param [in] path Context path which was used to connect the Callback.
    */
   void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * Check if the chain of Callbacks is empty.
+   *
+   * This is used by NS_TRACE() to skip evaluating the arguments
+   * when no sink is connected.
+   *
+   * \returns \c true if no Callback is connected.
+   */
+  bool IsEmpty (void) const;
   /**
    * \name Functors taking various numbers of arguments.
    *
@@ -314,6 +382,15 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Disconnect (const CallbackBase & callba
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
   DisconnectWithoutContext (realCb);
 }
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+inline bool
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::IsEmpty (void) const
+{
+  return m_callbackList.empty ();
+}
 template<typename T1, typename T2, 
          typename T3, typename T4,
          typename T5, typename T6,
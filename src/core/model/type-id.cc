@@ -24,6 +24,7 @@
 #include "trace-source-accessor.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -78,6 +79,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -270,6 +273,26 @@ public:
    * \returns \c true if this TypeId should be hidden from the user.
    */
   bool MustHideFromDocumentation (uint16_t uid) const;
+  /**
+   * Find an Attribute by name in a type id or any of its parents.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \param [out] owner The id which registered the Attribute.
+   * \param [out] index The index of the Attribute within \p owner.
+   * \returns \c true if the Attribute was found.
+   */
+  bool LookupAttribute (uint16_t uid, const std::string &name,
+                        uint16_t *owner, std::size_t *index) const;
+  /**
+   * Find a TraceSource by name in a type id or any of its parents.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \param [out] owner The id which registered the TraceSource.
+   * \param [out] index The index of the TraceSource within \p owner.
+   * \returns \c true if the TraceSource was found.
+   */
+  bool LookupTraceSource (uint16_t uid, const std::string &name,
+                          uint16_t *owner, std::size_t *index) const;
 
 private:
   /**
@@ -293,6 +316,10 @@ private:
    */
   static TypeId::hash_t Hasher (const std::string name);
 
+  /** Type of the by-name index of Attributes and TraceSources. */
+  typedef std::unordered_map<std::string,
+                             std::pair<uint16_t, std::size_t> > memberindex_t;
+
   /** The information record about a single type id. */
   struct IidInformation {
     /** The type id name. */
@@ -319,6 +346,15 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /**
+     * Attributes of this type and its parents, by name.
+     * Built on first lookup, see IidManager::UpdateIndexes.
+     */
+    memberindex_t attributeIndex;
+    /** TraceSources of this type and its parents, by name. */
+    memberindex_t traceSourceIndex;
+    /** Value of m_generation when the indexes were built. */
+    uint32_t indexGeneration;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
@@ -330,9 +366,28 @@ private:
    */
   struct IidManager::IidInformation *LookupInformation (uint16_t uid) const;
 
+  /**
+   * Rebuild the by-name indexes of a type id if any type id has been
+   * modified since they were last built.
+   *
+   * Attributes and TraceSources of derived types hide those of the
+   * same name in their parents, matching the order in which
+   * TypeId::LookupAttributeByName used to walk the hierarchy.
+   *
+   * \param [in] information The information record to update.
+   */
+  void UpdateIndexes (struct IidInformation *information) const;
+
   /** The container of all type id records. */
   std::vector<struct IidInformation> m_information;
 
+  /**
+   * Incremented whenever an Attribute, TraceSource or parent is added,
+   * to invalidate the by-name indexes.  Starts at 1 so that freshly
+   * allocated records (generation 0) are always rebuilt.
+   */
+  uint32_t m_generation;
+
   /** Type of the by-name index. */
   typedef std::map<std::string, uint16_t> namemap_t;
   /** The by-name index. */
@@ -378,6 +433,12 @@ IidManager::Hasher (const std::string name)
  */
 #define IIDL IID << ": "
 
+IidManager::IidManager ()
+  : m_generation (1)
+{
+  NS_LOG_FUNCTION (IID);
+}
+
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
@@ -439,6 +500,7 @@ IidManager::AllocateUid (std::string name)
   information.size = (std::size_t)(-1);
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.indexGeneration = 0;
   m_information.push_back (information);
   std::size_t tuid = m_information.size();
   NS_ASSERT (tuid <= 0xffff);
@@ -460,6 +522,80 @@ IidManager::LookupInformation (uint16_t uid) const
   return const_cast<struct IidInformation *> (&m_information[uid-1]);
 }
 
+void
+IidManager::UpdateIndexes (struct IidInformation *information) const
+{
+  NS_LOG_FUNCTION (IID << information->name);
+  if (information->indexGeneration == m_generation)
+    {
+      return;
+    }
+  information->attributeIndex.clear ();
+  information->traceSourceIndex.clear ();
+  struct IidInformation *current = information;
+  uint16_t uid = GetUid (information->hash);
+  while (true)
+    {
+      // insert () never overwrites, so the most derived entry wins
+      for (std::size_t i = 0; i < current->attributes.size (); i++)
+        {
+          information->attributeIndex.insert
+            (std::make_pair (current->attributes[i].name, std::make_pair (uid, i)));
+        }
+      for (std::size_t i = 0; i < current->traceSources.size (); i++)
+        {
+          information->traceSourceIndex.insert
+            (std::make_pair (current->traceSources[i].name, std::make_pair (uid, i)));
+        }
+      if (current->parent == 0 || current->parent == uid)
+        {
+          // top of inheritance tree
+          break;
+        }
+      uid = current->parent;
+      current = LookupInformation (uid);
+    }
+  information->indexGeneration = m_generation;
+}
+
+bool
+IidManager::LookupAttribute (uint16_t uid, const std::string &name,
+                             uint16_t *owner, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupInformation (uid);
+  UpdateIndexes (information);
+  memberindex_t::const_iterator it = information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *owner = it->second.first;
+  *index = it->second.second;
+  NS_LOG_LOGIC (IIDL << *owner << " " << *index);
+  return true;
+}
+
+bool
+IidManager::LookupTraceSource (uint16_t uid, const std::string &name,
+                               uint16_t *owner, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupInformation (uid);
+  UpdateIndexes (information);
+  memberindex_t::const_iterator it = information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *owner = it->second.first;
+  *index = it->second.second;
+  NS_LOG_LOGIC (IIDL << *owner << " " << *index);
+  return true;
+}
+
 void 
 IidManager::SetParent (uint16_t uid, uint16_t parent)
 {
@@ -467,6 +603,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -676,6 +813,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void 
@@ -767,6 +905,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -877,38 +1016,27 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  uint16_t owner;
+  std::size_t i;
+  if (!IidManager::Get ()->LookupAttribute (m_tid, name, &owner, &i))
+    {
+      return false;
+    }
+  struct TypeId::AttributeInformation tmp =
+    IidManager::Get ()->GetAttribute (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name
+                      << "' is obsolete, with no fallback: "
+                      << tmp.supportMsg);
+    }
+  *info = tmp;
+  return true;
 }
 
 TypeId 
@@ -1137,39 +1265,27 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                   return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else  if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  uint16_t owner;
+  std::size_t i;
+  if (!IidManager::Get ()->LookupTraceSource (m_tid, name, &owner, &i))
+    {
+      return 0;
+    }
+  struct TypeId::TraceSourceInformation tmp =
+    IidManager::Get ()->GetTraceSource (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "TraceSource '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("TraceSource '" << name
+                      << "' is obsolete, with no fallback: "
+                      << tmp.supportMsg);
+    }
+  *info = tmp;
+  return tmp.accessor;
 }
 
 Ptr<const TraceSourceAccessor> 
@@ -830,6 +830,78 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for Config::CompiledPath, and the invalidation of its cache.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CompiledPathConfigTestCase ();
+  /** Destructor. */
+  virtual ~CompiledPathConfigTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase ()
+  : TestCase ("Check that compiled paths cache their matches until invalidated")
+{
+}
+
+void
+CompiledPathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Names::Add ("CompiledPathRoot", root);
+
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj3 = CreateObject<ConfigTestObject> ();
+  root->AddNodeB (obj0);
+  root->AddNodeB (obj1);
+
+  Config::CompiledPath path ("/Names/CompiledPathRoot/NodesB/*/A");
+  NS_TEST_ASSERT_MSG_EQ (path.GetPath (), "/Names/CompiledPathRoot/NodesB/*/A", "Unexpected path");
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 2, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetMatchedPath (1), "/Names/CompiledPathRoot/NodesB/1/",
+                         "Unexpected matched path");
+
+  path.Set (IntegerValue (3));
+  obj0->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 3, "Object Attribute \"A\" not set as expected");
+  obj1->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 3, "Object Attribute \"A\" not set as expected");
+
+  //
+  // Changing an object vector is not tracked, so the cached matches are
+  // reused until they are explicitly invalidated.
+  //
+  root->AddNodeB (obj2);
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 2, "Matches should have been cached");
+  Config::InvalidateCompiledPaths ();
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 3, "Matches should have been invalidated");
+
+  //
+  // Adding a name invalidates the cached matches.
+  //
+  root->AddNodeB (obj3);
+  Names::Add ("CompiledPathObj3", obj3);
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 4, "Matches should have been invalidated");
+
+  path.Set (IntegerValue (-4));
+  obj3->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), -4, "Object Attribute \"A\" not set as expected");
+
+  Names::Clear ();
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -848,6 +920,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new CompiledPathConfigTestCase);
 }
 
 /**
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/memory-accounting.h"
+#include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+
+/**
+ * \file
+ * \ingroup memory-accounting-tests
+ * MemoryAccounting test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup memory-accounting-tests MemoryAccounting test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup memory-accounting-tests
+ * An Object accounted under its TypeId.
+ */
+class AccountedObject : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+private:
+  uint8_t m_data[100]; //!< Payload
+};
+
+NS_OBJECT_ENSURE_REGISTERED (AccountedObject);
+
+TypeId
+AccountedObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::tests::AccountedObject")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddConstructor<AccountedObject> ()
+  ;
+  return tid;
+}
+
+/**
+ * \ingroup memory-accounting-tests
+ * A SimpleRefCount type accounted under its C++ type.
+ */
+class AccountedRefCount : public SimpleRefCount<AccountedRefCount>
+{
+  uint8_t m_data[40]; //!< Payload
+};
+
+/**
+ * \ingroup memory-accounting-tests
+ * Check the counts of live Objects and SimpleRefCount instances, and
+ * the reports.
+ */
+class MemoryAccountingTestCase : public TestCase
+{
+public:
+  MemoryAccountingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MemoryAccountingTestCase::MemoryAccountingTestCase ()
+  : TestCase ("Check live counts per TypeId and C++ type")
+{
+}
+
+void
+MemoryAccountingTestCase::DoRun (void)
+{
+  MemoryAccounting::Enable ();
+
+  MemoryAccounting::Counter *objects = MemoryAccounting::GetCounter (AccountedObject::GetTypeId ());
+  MemoryAccounting::Counter *refCounts = MemoryAccounting::GetCounter<AccountedRefCount> ();
+  NS_TEST_EXPECT_MSG_EQ (objects->name, "ns3::tests::AccountedObject", "Unexpected TypeId counter name");
+  NS_TEST_EXPECT_MSG_EQ (refCounts->name, "ns3::tests::AccountedRefCount", "Unexpected C++ type counter name");
+  int64_t objectCount = objects->count;
+  int64_t objectBytes = objects->bytes;
+  int64_t refCount = refCounts->count;
+
+  {
+    std::vector<Ptr<AccountedObject> > created;
+    for (uint32_t i = 0; i < 10; ++i)
+      {
+        created.push_back (CreateObject<AccountedObject> ());
+      }
+    Ptr<AccountedRefCount> a = Create<AccountedRefCount> ();
+    Ptr<AccountedRefCount> b = Create<AccountedRefCount> ();
+
+    NS_TEST_EXPECT_MSG_EQ (objects->count, objectCount + 10, "Unexpected live Object count");
+    NS_TEST_EXPECT_MSG_EQ (objects->bytes, objectBytes + 10 * static_cast<int64_t> (sizeof (AccountedObject)), "Unexpected live Object bytes");
+    NS_TEST_EXPECT_MSG_GT (objects->peakCount, objectCount + 9, "Unexpected peak Object count");
+    NS_TEST_EXPECT_MSG_EQ (refCounts->count, refCount + 2, "Unexpected live SimpleRefCount count");
+
+    std::ostringstream oss;
+    MemoryAccounting::Print (oss);
+    NS_TEST_EXPECT_MSG_NE (oss.str ().find ("ns3::tests::AccountedObject"), std::string::npos, "Object missing from report");
+    NS_TEST_EXPECT_MSG_NE (oss.str ().find ("ns3::tests::AccountedRefCount"), std::string::npos, "SimpleRefCount missing from report");
+  }
+  NS_TEST_EXPECT_MSG_EQ (objects->count, objectCount, "Objects not accounted as freed");
+  NS_TEST_EXPECT_MSG_EQ (objects->bytes, objectBytes, "Object bytes not accounted as freed");
+  NS_TEST_EXPECT_MSG_EQ (refCounts->count, refCount, "SimpleRefCount instances not accounted as freed");
+
+  // A leaked object shows up in the report at Destroy
+  std::ostringstream scheduled;
+  std::ostringstream destroyed;
+  MemoryAccounting::ScheduleReport (Seconds (1), scheduled);
+  MemoryAccounting::EnableDestroyReport (destroyed);
+  Ptr<AccountedObject> leaked = CreateObject<AccountedObject> ();
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_NE (scheduled.str ().find ("at +1"), std::string::npos, "Missing scheduled report");
+  NS_TEST_EXPECT_MSG_NE (destroyed.str ().find ("ns3::tests::AccountedObject"), std::string::npos, "Missing leaked object");
+  NS_TEST_EXPECT_MSG_EQ (objects->count, objectCount + 1, "Unexpected live Object count");
+  leaked = 0;
+
+  MemoryAccounting::Disable ();
+}
+
+/**
+ * \ingroup memory-accounting-tests
+ * MemoryAccounting TestSuite
+ */
+class MemoryAccountingTestSuite : public TestSuite
+{
+public:
+  MemoryAccountingTestSuite ();
+};
+
+MemoryAccountingTestSuite::MemoryAccountingTestSuite ()
+  : TestSuite ("memory-accounting", UNIT)
+{
+  AddTestCase (new MemoryAccountingTestCase, TestCase::QUICK);
+}
+
+static MemoryAccountingTestSuite g_memoryAccountingTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
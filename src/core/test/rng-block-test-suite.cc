@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/rng-stream.h"
+#include "ns3/random-variable-stream.h"
+#include <vector>
+
+/**
+ * \file
+ * \ingroup randomvariable-tests
+ * Test that the block generation of random numbers gives the same
+ * sequences as one value at a time.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup randomvariable-tests
+ * Check RngStream::RandU01 (double *, uint32_t) and RngStream::Advance
+ * against successive calls to RngStream::RandU01 (void).
+ */
+class RngStreamBlockTestCase : public TestCase
+{
+public:
+  RngStreamBlockTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamBlockTestCase::RngStreamBlockTestCase ()
+  : TestCase ("Check the RngStream blocks and jump-ahead")
+{
+}
+
+void
+RngStreamBlockTestCase::DoRun (void)
+{
+  RngStream scalar (12345, 7, 3);
+  RngStream block (scalar);
+  uint32_t sizes[] = { 0, 1, 2, 17, 1000 };
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      std::vector<double> values (sizes[s] + 1);
+      block.RandU01 (&values[0], sizes[s]);
+      for (uint32_t i = 0; i < sizes[s]; ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[i], scalar.RandU01 (), "Block value " << i << " differs");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (block.RandU01 (), scalar.RandU01 (), "Streams out of step after the blocks");
+
+  uint64_t jumps[] = { 0, 1, 2, 3, 64, 12345 };
+  for (uint32_t j = 0; j < sizeof (jumps) / sizeof (jumps[0]); ++j)
+    {
+      RngStream jumped (scalar);
+      jumped.Advance (jumps[j]);
+      for (uint64_t i = 0; i < jumps[j]; ++i)
+        {
+          scalar.RandU01 ();
+        }
+      NS_TEST_ASSERT_MSG_EQ (jumped.RandU01 (), scalar.RandU01 (), "Wrong jump ahead by " << jumps[j]);
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Check RandomVariableStream::GetValues against successive calls to
+ * GetValue, for the distributions which draw their uniforms in blocks.
+ */
+class RandomVariableStreamBlockTestCase : public TestCase
+{
+public:
+  RandomVariableStreamBlockTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the blocks of \p block with the values of \p scalar,
+   * then check that both are still in step.
+   * \param block the variable drawing values in blocks
+   * \param scalar the variable drawing values one at a time, on the same stream
+   * \param name the name of the distribution
+   */
+  void Compare (Ptr<RandomVariableStream> block, Ptr<RandomVariableStream> scalar, std::string name);
+};
+
+RandomVariableStreamBlockTestCase::RandomVariableStreamBlockTestCase ()
+  : TestCase ("Check the random variable blocks")
+{
+}
+
+void
+RandomVariableStreamBlockTestCase::Compare (Ptr<RandomVariableStream> block, Ptr<RandomVariableStream> scalar, std::string name)
+{
+  uint32_t sizes[] = { 1, 2, 3, 100, 1000 };
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      std::vector<double> values (sizes[s]);
+      block->GetValues (&values[0], sizes[s]);
+      for (uint32_t i = 0; i < sizes[s]; ++i)
+        {
+          NS_TEST_EXPECT_MSG_EQ (values[i], scalar->GetValue (), name << " block value " << i << " differs");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (block->GetValue (), scalar->GetValue (), name << " streams out of step after the blocks");
+}
+
+void
+RandomVariableStreamBlockTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> uniform[2];
+  Ptr<NormalRandomVariable> normal[2];
+  Ptr<NormalRandomVariable> bounded[2];
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      uniform[i] = CreateObject<UniformRandomVariable> ();
+      uniform[i]->SetAttribute ("Min", DoubleValue (-3));
+      uniform[i]->SetAttribute ("Max", DoubleValue (5));
+      uniform[i]->SetAttribute ("Antithetic", BooleanValue (true));
+      uniform[i]->SetStream (1);
+      normal[i] = CreateObject<NormalRandomVariable> ();
+      normal[i]->SetAttribute ("Mean", DoubleValue (2));
+      normal[i]->SetAttribute ("Variance", DoubleValue (4));
+      normal[i]->SetStream (2);
+      // A tight bound rejects most pairs, and many single values
+      bounded[i] = CreateObject<NormalRandomVariable> ();
+      bounded[i]->SetAttribute ("Bound", DoubleValue (0.2));
+      bounded[i]->SetStream (3);
+    }
+  Compare (uniform[0], uniform[1], "Uniform");
+  Compare (normal[0], normal[1], "Normal");
+  Compare (bounded[0], bounded[1], "Bounded normal");
+
+  // Erlang values are sums of exponential values
+  Ptr<ErlangRandomVariable> erlang = CreateObject<ErlangRandomVariable> ();
+  Ptr<ExponentialRandomVariable> exponential = CreateObject<ExponentialRandomVariable> ();
+  erlang->SetStream (4);
+  exponential->SetStream (4);
+  uint32_t ks[] = { 1, 3, 64, 200 };
+  for (uint32_t j = 0; j < sizeof (ks) / sizeof (ks[0]); ++j)
+    {
+      double sum = 0;
+      for (uint32_t i = 0; i < ks[j]; ++i)
+        {
+          sum += exponential->GetValue (0.5, 0);
+        }
+      NS_TEST_EXPECT_MSG_EQ (erlang->GetValue (ks[j], 0.5), sum, "Wrong Erlang value for k=" << ks[j]);
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Block random number generation TestSuite
+ */
+class RngBlockTestSuite : public TestSuite
+{
+public:
+  RngBlockTestSuite ();
+};
+
+RngBlockTestSuite::RngBlockTestSuite ()
+  : TestSuite ("rng-block", UNIT)
+{
+  AddTestCase (new RngStreamBlockTestCase, TestCase::QUICK);
+  AddTestCase (new RandomVariableStreamBlockTestCase, TestCase::QUICK);
+}
+
+static RngBlockTestSuite g_rngBlockTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
@@ -113,6 +113,68 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class FastPathTracedCallbackTestCase : public TestCase
+{
+public:
+  FastPathTracedCallbackTestCase ();
+  virtual ~FastPathTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  void Cb (uint8_t a, double b);
+  double Argument (void);
+
+  uint32_t m_calls;
+  uint32_t m_evaluations;
+};
+
+FastPathTracedCallbackTestCase::FastPathTracedCallbackTestCase ()
+  : TestCase ("Check NS_TRACE skips argument evaluation without sinks")
+{
+}
+
+void
+FastPathTracedCallbackTestCase::Cb (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_calls++;
+}
+
+double
+FastPathTracedCallbackTestCase::Argument (void)
+{
+  m_evaluations++;
+  return 2;
+}
+
+void
+FastPathTracedCallbackTestCase::DoRun (void)
+{
+  TracedCallback<uint8_t, double> trace;
+  m_calls = 0;
+  m_evaluations = 0;
+
+  //
+  // With nothing connected, the arguments must not be evaluated.
+  //
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New TracedCallback not empty");
+  NS_TRACE (trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations, 0, "Argument evaluated without sinks");
+
+  trace.ConnectWithoutContext (MakeCallback (&FastPathTracedCallbackTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "TracedCallback empty after Connect");
+  NS_TRACE (trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations, 1, "Argument not evaluated");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback not called");
+
+  trace.DisconnectWithoutContext (MakeCallback (&FastPathTracedCallbackTestCase::Cb, this));
+  NS_TRACE (trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations, 1, "Argument evaluated after Disconnect");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback called after Disconnect");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +185,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new FastPathTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -325,6 +325,172 @@ DeprecatedAttributeTestCase::DoRun (void)
        << endl;
 }
 
+
+//----------------------------
+//
+// Lookup by name test
+
+class LookupParent : public Object
+{
+public:
+  TracedValue<int> m_trace; //!< The trace sources of the test
+
+  // Register a type with an attribute and a trace source
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("LookupParent")
+      .SetParent<Object> ()
+      .AddAttribute ("attribute",
+                     "the parent attribute",
+                     EmptyAttributeValue (),
+                     MakeEmptyAttributeAccessor (),
+                     MakeEmptyAttributeChecker ())
+      .AddTraceSource ("trace",
+                       "the parent trace source",
+                       MakeTraceSourceAccessor (&LookupParent::m_trace),
+                       "ns3::TracedValueCallback::Int32");
+    return tid;
+  }
+};
+
+class LookupChild : public LookupParent
+{
+public:
+  // Register a type with its own attribute and trace source
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("LookupChild")
+      .SetParent<LookupParent> ()
+      .AddAttribute ("shadowed",
+                     "the child shadowed attribute",
+                     EmptyAttributeValue (),
+                     MakeEmptyAttributeAccessor (),
+                     MakeEmptyAttributeChecker ())
+      .AddTraceSource ("shadowedTrace",
+                       "the child shadowed trace source",
+                       MakeTraceSourceAccessor (&LookupParent::m_trace),
+                       "ns3::TracedValueCallback::Int32");
+    return tid;
+  }
+};
+
+
+class LookupByNameTestCase : public TestCase
+{
+public:
+  LookupByNameTestCase ();
+  virtual ~LookupByNameTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Check that an attribute is found, and resolved to the given one.
+   * \param tid The TypeId to look the attribute up in.
+   * \param name The name of the attribute.
+   * \param owner The TypeId which registered the expected attribute.
+   * \param index The index of the expected attribute within \p owner.
+   */
+  void CheckAttribute (TypeId tid, std::string name, TypeId owner, std::size_t index);
+  /**
+   * Check that a trace source is found, and resolved to the given one.
+   * \param tid The TypeId to look the trace source up in.
+   * \param name The name of the trace source.
+   * \param owner The TypeId which registered the expected trace source.
+   * \param index The index of the expected trace source within \p owner.
+   */
+  void CheckTraceSource (TypeId tid, std::string name, TypeId owner, std::size_t index);
+};
+
+LookupByNameTestCase::LookupByNameTestCase ()
+  : TestCase ("Check Attribute and TraceSource lookups by name")
+{
+}
+
+LookupByNameTestCase::~LookupByNameTestCase ()
+{
+}
+
+void
+LookupByNameTestCase::CheckAttribute (TypeId tid, std::string name, TypeId owner, std::size_t index)
+{
+  struct TypeId::AttributeInformation info;
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (name, &info), true,
+                         "attribute " << name << " not found in " << tid.GetName ());
+  struct TypeId::AttributeInformation expected = owner.GetAttribute (index);
+  NS_TEST_EXPECT_MSG_EQ (info.name, name, "wrong attribute name");
+  NS_TEST_EXPECT_MSG_EQ (info.help, expected.help,
+                         "attribute " << name << " of " << tid.GetName () << " not resolved to " << owner.GetName ());
+  NS_TEST_EXPECT_MSG_EQ (info.accessor, expected.accessor, "wrong accessor for attribute " << name);
+}
+
+void
+LookupByNameTestCase::CheckTraceSource (TypeId tid, std::string name, TypeId owner, std::size_t index)
+{
+  struct TypeId::TraceSourceInformation info;
+  Ptr<const TraceSourceAccessor> accessor = tid.LookupTraceSourceByName (name, &info);
+  NS_TEST_ASSERT_MSG_NE (accessor, 0, "trace source " << name << " not found in " << tid.GetName ());
+  struct TypeId::TraceSourceInformation expected = owner.GetTraceSource (index);
+  NS_TEST_EXPECT_MSG_EQ (info.name, name, "wrong trace source name");
+  NS_TEST_EXPECT_MSG_EQ (info.help, expected.help,
+                         "trace source " << name << " of " << tid.GetName () << " not resolved to " << owner.GetName ());
+  NS_TEST_EXPECT_MSG_EQ (accessor, expected.accessor, "wrong accessor for trace source " << name);
+}
+
+void
+LookupByNameTestCase::DoRun (void)
+{
+  TypeId parent = LookupParent::GetTypeId ();
+  TypeId child = LookupChild::GetTypeId ();
+
+  // Inherited members are resolved to the parent entries
+  CheckAttribute (child, "attribute", parent, 0);
+  CheckTraceSource (child, "trace", parent, 0);
+  // Own members
+  CheckAttribute (child, "shadowed", child, 0);
+  CheckTraceSource (child, "shadowedTrace", child, 0);
+
+  // Misses
+  struct TypeId::AttributeInformation ainfo;
+  NS_TEST_EXPECT_MSG_EQ (child.LookupAttributeByName ("missing", &ainfo), false,
+                         "missing attribute found");
+  NS_TEST_EXPECT_MSG_EQ (parent.LookupAttributeByName ("shadowed", &ainfo), false,
+                         "child attribute found in the parent");
+  NS_TEST_EXPECT_MSG_EQ (child.LookupTraceSourceByName ("missing"), 0,
+                         "missing trace source found");
+  NS_TEST_EXPECT_MSG_EQ (parent.LookupTraceSourceByName ("shadowedTrace"), 0,
+                         "child trace source found in the parent");
+
+  // Members added to the parent once the index of the child has been
+  // built, including some with the names of members of the child
+  parent.AddAttribute ("late",
+                       "the parent late attribute",
+                       EmptyAttributeValue (),
+                       MakeEmptyAttributeAccessor (),
+                       MakeEmptyAttributeChecker ());
+  parent.AddAttribute ("shadowed",
+                       "the parent shadowed attribute",
+                       EmptyAttributeValue (),
+                       MakeEmptyAttributeAccessor (),
+                       MakeEmptyAttributeChecker ());
+  parent.AddTraceSource ("lateTrace",
+                         "the parent late trace source",
+                         MakeTraceSourceAccessor (&LookupParent::m_trace),
+                         "ns3::TracedValueCallback::Int32");
+  parent.AddTraceSource ("shadowedTrace",
+                         "the parent shadowed trace source",
+                         MakeTraceSourceAccessor (&LookupParent::m_trace),
+                         "ns3::TracedValueCallback::Int32");
+
+  CheckAttribute (child, "late", parent, 1);
+  CheckTraceSource (child, "lateTrace", parent, 1);
+  // The derived class entries win
+  CheckAttribute (child, "shadowed", child, 0);
+  CheckTraceSource (child, "shadowedTrace", child, 0);
+  CheckAttribute (parent, "shadowed", parent, 2);
+  CheckTraceSource (parent, "shadowedTrace", parent, 2);
+  CheckAttribute (child, "attribute", parent, 0);
+  CheckTraceSource (child, "trace", parent, 0);
+}
+
   
 //----------------------------
 //
@@ -383,6 +549,26 @@ LookupTimeTestCase::DoRun (void)
   }
   stop = clock ();
   Report ("hash", stop - start);
+
+  start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+      for (uint16_t i = 0; i < nids; ++i)
+        {
+          const TypeId tid = TypeId::GetRegistered (i);
+          struct TypeId::AttributeInformation info;
+          for (std::size_t a = 0; a < tid.GetAttributeN (); ++a)
+            {
+              // Deprecated and obsolete Attributes complain on lookup
+              if (tid.GetAttribute (a).supportLevel == TypeId::SUPPORTED)
+                {
+                  tid.LookupAttributeByName (tid.GetAttribute (a).name, &info);
+                }
+            }
+        }
+  }
+  stop = clock ();
+  Report ("attribute name", stop - start);
   
 }
 
@@ -437,6 +623,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new LookupByNameTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
@@ -21,6 +21,7 @@
 #include "csma-channel.h"
 #include "csma-net-device.h"
 #include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 
@@ -56,6 +57,7 @@ CsmaChannel::CsmaChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_state = IDLE;
+  m_currentBurst = false;
   m_deviceList.clear ();
 }
 
@@ -189,11 +191,50 @@ CsmaChannel::TransmitStart (Ptr<const Packet> p, uint32_t srcId)
 
   NS_LOG_LOGIC ("switch to TRANSMITTING");
   m_currentPkt = p->Copy ();
+  m_currentBurst = false;
   m_currentSrc = srcId;
   m_state = TRANSMITTING;
   return true;
 }
 
+bool
+CsmaChannel::TransmitBurstStart (Ptr<const PacketBurst> burst, uint32_t srcId,
+                                 const std::vector<Time> &txTimes, Time interframeGap)
+{
+  NS_LOG_FUNCTION (this << burst << srcId);
+  NS_ASSERT (burst->GetNPackets () == txTimes.size ());
+  NS_ASSERT (!txTimes.empty ());
+
+  if (!TransmitStart (*burst->Begin (), srcId))
+    {
+      return false;
+    }
+  m_currentBurst = true;
+
+  //
+  // The end of each packet is known now, so schedule all the receptions
+  // rather than waiting for TransmitEnd, which is called after the last one.
+  //
+  Time txEnd = Seconds (0);
+  std::vector<Time>::const_iterator txTime = txTimes.begin ();
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i, ++txTime)
+    {
+      txEnd += *txTime;
+      for (std::vector<CsmaDeviceRec>::iterator it = m_deviceList.begin (); it < m_deviceList.end (); it++)
+        {
+          if (it->IsActive ())
+            {
+              Simulator::ScheduleWithContext (it->devicePtr->GetNode ()->GetId (),
+                                              txEnd + m_delay,
+                                              &CsmaNetDevice::Receive, it->devicePtr,
+                                              (*i)->Copy (), m_deviceList[m_currentSrc].devicePtr);
+            }
+        }
+      txEnd += interframeGap;
+    }
+  return true;
+}
+
 bool
 CsmaChannel::IsActive (uint32_t deviceId)
 {
@@ -226,7 +267,7 @@ CsmaChannel::TransmitEnd ()
   uint32_t devId = 0;
   for (it = m_deviceList.begin (); it < m_deviceList.end (); it++)
     {
-      if (it->IsActive ())
+      if (it->IsActive () && !m_currentBurst)
         {
           // schedule reception events
           Simulator::ScheduleWithContext (it->devicePtr->GetNode ()->GetId (),
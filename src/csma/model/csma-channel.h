@@ -25,10 +25,12 @@
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include <vector>
 
 namespace ns3 {
 
 class Packet;
+class PacketBurst;
 
 class CsmaNetDevice;
 
@@ -186,6 +188,28 @@ public:
    */
   bool TransmitStart (Ptr<const Packet> p, uint32_t srcId);
 
+  /**
+   * \brief Start transmitting a burst of packets over the channel
+   *
+   * Same as TransmitStart for a single packet, except that the channel
+   * stays busy until the end of the last packet of the burst.  The
+   * reception of each packet by the net devices which are active now is
+   * scheduled at the time the last bit of the packet arrives, as if the
+   * packets had been transmitted one by one.
+   *
+   * \param burst The packets that will be transmitted back to back
+   * over the channel
+   * \param srcId The device Id of the net device that wants to
+   * transmit on the channel.
+   * \param txTimes Transmit time of each packet of the burst
+   * \param interframeGap Gap between the end of a packet and the start
+   * of the next one
+   * \return True if the channel is not busy and the transmitting net
+   * device is currently active.
+   */
+  bool TransmitBurstStart (Ptr<const PacketBurst> burst, uint32_t srcId,
+                           const std::vector<Time> &txTimes, Time interframeGap);
+
   /**
    * \brief Indicates that the net device has finished transmitting
    * the packet over the channel
@@ -338,6 +362,13 @@ private:
    */
   Ptr<Packet> m_currentPkt;
 
+  /**
+   * Whether the current transmission is a burst (m_currentPkt is then
+   * the first packet of the burst), whose receptions have already been
+   * scheduled by TransmitBurstStart.
+   */
+  bool m_currentBurst;
+
   /**
    * Device Id of the source that is currently transmitting on the
    * channel. Or last source to have transmitted a packet on the
@@ -30,6 +30,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/packet-burst.h"
 #include "csma-net-device.h"
 #include "csma-channel.h"
 
@@ -77,6 +78,15 @@ CsmaNetDevice::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&CsmaNetDevice::m_receiveErrorModel),
                    MakePointerChecker<ErrorModel> ())
+    .AddAttribute ("MaxBurstPackets",
+                   "The maximum number of packets transmitted back to back once "
+                   "the device has acquired the channel (frame bursting), with a "
+                   "single transmit complete event.  Each packet is still "
+                   "delivered to the receivers at its own arrival time.  "
+                   "A value of 1 disables burst mode.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&CsmaNetDevice::m_maxBurstPackets),
+                   MakeUintegerChecker<uint32_t> (1))
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -190,6 +200,7 @@ CsmaNetDevice::CsmaNetDevice ()
   m_txMachineState = READY;
   m_tInterframeGap = Seconds (0);
   m_channel = 0;
+  m_maxBurstPackets = 1;
 
   // 
   // We would like to let the attribute system take care of initializing the 
@@ -218,6 +229,7 @@ CsmaNetDevice::DoDispose ()
   m_channel = 0;
   m_node = 0;
   m_queue = 0;
+  m_currentBurst = 0;
   NetDevice::DoDispose ();
 }
 
@@ -503,13 +515,49 @@ CsmaNetDevice::TransmitStart (void)
   else 
     {
       //
-      // The channel is free, transmit the packet
+      // The channel is free, transmit the packet.  In burst mode, the packets
+      // waiting behind the current one are transmitted back to back with it
+      // while we hold the channel.
       //
       m_phyTxBeginTrace (m_currentPkt);
-      if (m_channel->TransmitStart (m_currentPkt, m_deviceId) == false)
+      Time tEvent = m_bps.CalculateBytesTxTime (m_currentPkt->GetSize ());
+      std::vector<Time> txTimes;
+      if (m_maxBurstPackets > 1 && !m_queue->IsEmpty ())
+        {
+          m_currentBurst = CreateObject<PacketBurst> ();
+          m_currentBurst->AddPacket (m_currentPkt);
+          txTimes.push_back (tEvent);
+          while (m_currentBurst->GetNPackets () < m_maxBurstPackets && !m_queue->IsEmpty ())
+            {
+              Ptr<Packet> packet = m_queue->Dequeue ();
+              m_currentBurst->AddPacket (packet);
+              Time txTime = m_bps.CalculateBytesTxTime (packet->GetSize ());
+              txTimes.push_back (txTime);
+              //
+              // The interframe gap separates the packets of the burst
+              //
+              tEvent += m_tInterframeGap + txTime;
+            }
+        }
+
+      bool started = (m_currentBurst != 0) ?
+        m_channel->TransmitBurstStart (m_currentBurst, m_deviceId, txTimes, m_tInterframeGap) :
+        m_channel->TransmitStart (m_currentPkt, m_deviceId);
+      if (started == false)
         {
           NS_LOG_WARN ("Channel TransmitStart returns an error");
-          m_phyTxDropTrace (m_currentPkt);
+          if (m_currentBurst != 0)
+            {
+              for (std::list<Ptr<Packet> >::const_iterator i = m_currentBurst->Begin (); i != m_currentBurst->End (); ++i)
+                {
+                  m_phyTxDropTrace (*i);
+                }
+              m_currentBurst = 0;
+            }
+          else
+            {
+              m_phyTxDropTrace (m_currentPkt);
+            }
           m_currentPkt = 0;
           m_txMachineState = READY;
         } 
@@ -522,13 +570,64 @@ CsmaNetDevice::TransmitStart (void)
           m_backoff.ResetBackoffTime ();
           m_txMachineState = BUSY;
 
-          Time tEvent = m_bps.CalculateBytesTxTime (m_currentPkt->GetSize ());
+          if (m_currentBurst != 0)
+            {
+              ScheduleBurstTraces (txTimes);
+            }
+
           NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << tEvent.GetSeconds () << "sec");
           Simulator::Schedule (tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
     }
 }
 
+void
+CsmaNetDevice::ScheduleBurstTraces (const std::vector<Time> &txTimes)
+{
+  NS_LOG_FUNCTION (this);
+
+  //
+  // The traces of the first packet are fired as usual, by the dequeue, by
+  // TransmitStart and by TransmitCompleteEvent.  Those of the other packets
+  // are fired at the times they would be in the default mode.
+  //
+  bool traceTxBegin = !m_snifferTrace.IsEmpty () || !m_promiscSnifferTrace.IsEmpty ()
+    || !m_phyTxBeginTrace.IsEmpty ();
+  bool traceTxEnd = !m_phyTxEndTrace.IsEmpty ();
+  uint32_t last = m_currentBurst->GetNPackets () - 1;
+  uint32_t n = 0;
+  Time txStart = Seconds (0);
+  std::vector<Time>::const_iterator txTime = txTimes.begin ();
+  for (std::list<Ptr<Packet> >::const_iterator i = m_currentBurst->Begin (); i != m_currentBurst->End (); ++i, ++txTime, ++n)
+    {
+      if (n > 0 && traceTxBegin)
+        {
+          Simulator::Schedule (txStart, &CsmaNetDevice::NotifyBurstTxBegin, this, *i);
+        }
+      if (n < last && traceTxEnd)
+        {
+          Simulator::Schedule (txStart + *txTime, &CsmaNetDevice::NotifyBurstTxEnd, this, *i);
+        }
+      txStart += *txTime + m_tInterframeGap;
+    }
+}
+
+void
+CsmaNetDevice::NotifyBurstTxBegin (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_snifferTrace (p);
+  m_promiscSnifferTrace (p);
+  m_phyTxBeginTrace (p);
+}
+
+void
+CsmaNetDevice::NotifyBurstTxEnd (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_phyTxEndTrace (p);
+}
+
 void
 CsmaNetDevice::TransmitAbort (void)
 {
@@ -598,7 +697,16 @@ CsmaNetDevice::TransmitCompleteEvent (void)
   NS_LOG_LOGIC ("Pkt UID is " << m_currentPkt->GetUid () << ")");
 
   m_channel->TransmitEnd (); 
-  m_phyTxEndTrace (m_currentPkt);
+  if (m_currentBurst != 0)
+    {
+      // The other packets of the burst have been handled by NotifyBurstTxEnd
+      m_phyTxEndTrace (m_currentBurst->GetPackets ().back ());
+      m_currentBurst = 0;
+    }
+  else
+    {
+      m_phyTxEndTrace (m_currentPkt);
+    }
   m_currentPkt = 0;
 
   NS_LOG_LOGIC ("Schedule TransmitReadyEvent in " << m_tInterframeGap.GetSeconds () << "sec");
@@ -22,6 +22,7 @@
 #define CSMA_NET_DEVICE_H
 
 #include <cstring>
+#include <vector>
 #include "ns3/node.h"
 #include "ns3/backoff.h"
 #include "ns3/address.h"
@@ -39,6 +40,7 @@ namespace ns3 {
 template <typename Item> class Queue;
 class CsmaChannel;
 class ErrorModel;
+class PacketBurst;
 
 /** 
  * \defgroup csma CSMA Network Device
@@ -399,6 +401,32 @@ private:
    */
   void TransmitStart ();
 
+  /**
+   * Schedule the transmit trace sources of the packets of m_currentBurst
+   * after the first one, at the times each packet starts and completes
+   * its transmission.  Nothing is scheduled for the trace sources which
+   * are not connected.
+   *
+   * \param txTimes the transmission time of each packet of the burst
+   */
+  void ScheduleBurstTraces (const std::vector<Time> &txTimes);
+
+  /**
+   * Fire the sniffer and PhyTxBegin trace sources for a packet of a burst
+   * whose transmission starts now.
+   *
+   * \param p the packet
+   */
+  void NotifyBurstTxBegin (Ptr<const Packet> p);
+
+  /**
+   * Fire the PhyTxEnd trace source for a packet of a burst whose
+   * transmission completes now.
+   *
+   * \param p the packet
+   */
+  void NotifyBurstTxEnd (Ptr<const Packet> p);
+
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
    *
@@ -516,6 +544,19 @@ private:
    */
   Ptr<Packet> m_currentPkt;
 
+  /**
+   * Packets being transmitted back to back with m_currentPkt (which is
+   * the first packet of the burst) when the device operates in burst
+   * mode, zero otherwise.
+   */
+  Ptr<PacketBurst> m_currentBurst;
+
+  /**
+   * Maximum number of packets transmitted as a single burst once the
+   * device has acquired the channel.  A value of one disables burst mode.
+   */
+  uint32_t m_maxBurstPackets;
+
   /**
    * The CsmaChannel to which this CsmaNetDevice has been
    * attached.
@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/uinteger.h"
+#include "ns3/csma-net-device.h"
+#include "ns3/csma-channel.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup csma
+ * \defgroup csma-test csma module tests
+ */
+
+/**
+ * \ingroup csma-test
+ * \ingroup tests
+ *
+ * \brief Test class for the burst mode of the Csma model
+ *
+ * It sends a few packets back to back from one NetDevice to two others,
+ * with and without burst mode, and checks that they are received, and
+ * reported by the PromiscSniffer, PhyTxBegin and PhyTxEnd trace sources
+ * of the sender, at the same times while burst mode uses fewer simulator
+ * events.  Without
+ * propagation delay, the channel is idle at the end of each interframe
+ * gap, so that the device does not back off between two packets.  The
+ * burst is then sent again over a channel with a propagation delay, which
+ * must be added to the time between the start of the transmission of
+ * each packet and its reception.
+ */
+class CsmaBurstTest : public TestCase
+{
+public:
+  CsmaBurstTest ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Send some packets back to back from the device specified
+   *
+   * \param device NetDevice to send from
+   */
+  void SendPackets (Ptr<CsmaNetDevice> device);
+
+  /**
+   * \brief Receive callback
+   *
+   * \param device the receiving NetDevice
+   * \param packet the received packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  /**
+   * \brief PhyTxBegin trace sink of the sender
+   *
+   * \param packet the packet being transmitted
+   */
+  void PhyTxBegin (Ptr<const Packet> packet);
+
+  /**
+   * \brief PhyTxEnd trace sink of the sender
+   *
+   * \param packet the packet transmitted
+   */
+  void PhyTxEnd (Ptr<const Packet> packet);
+
+  /**
+   * \brief PromiscSniffer trace sink of the sender
+   *
+   * \param packet the packet transmitted
+   */
+  void Sniffer (Ptr<const Packet> packet);
+
+  /**
+   * \brief Run one simulation
+   *
+   * \param maxBurstPackets value of the MaxBurstPackets attribute
+   * \param delay propagation delay of the channel
+   * \param traceTx whether to connect the transmit trace sources of the
+   *        sender, which cost events per packet of a burst
+   * \returns the number of simulator events executed
+   */
+  uint64_t RunOne (uint32_t maxBurstPackets, Time delay, bool traceTx);
+
+  /**
+   * \brief Check that a list of trace times matches the one of the default mode
+   *
+   * \param times the times in burst mode
+   * \param expected the times in default mode
+   * \param name the name of the trace
+   */
+  void CheckTimes (const std::vector<Time> &times, const std::vector<Time> &expected, std::string name);
+
+  uint32_t m_nPackets;  //!< Number of packets sent
+  std::vector<Time> m_rxTimes;  //!< Time each packet is received
+  std::vector<Time> m_txTimes;  //!< Time the transmission of each packet starts
+  std::vector<Time> m_txEndTimes;  //!< Time the transmission of each packet ends
+  std::vector<Time> m_snifferTimes;  //!< Times of the PromiscSniffer traces
+};
+
+CsmaBurstTest::CsmaBurstTest ()
+  : TestCase ("Csma burst mode"),
+    m_nPackets (10)
+{
+}
+
+void
+CsmaBurstTest::SendPackets (Ptr<CsmaNetDevice> device)
+{
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100 + i);
+      device->Send (p, device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+CsmaBurstTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+CsmaBurstTest::PhyTxBegin (Ptr<const Packet> packet)
+{
+  m_txTimes.push_back (Simulator::Now ());
+}
+
+void
+CsmaBurstTest::PhyTxEnd (Ptr<const Packet> packet)
+{
+  m_txEndTimes.push_back (Simulator::Now ());
+}
+
+void
+CsmaBurstTest::Sniffer (Ptr<const Packet> packet)
+{
+  m_snifferTimes.push_back (Simulator::Now ());
+}
+
+uint64_t
+CsmaBurstTest::RunOne (uint32_t maxBurstPackets, Time delay, bool traceTx)
+{
+  Ptr<CsmaChannel> channel = CreateObject<CsmaChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (delay));
+  std::vector<Ptr<CsmaNetDevice> > devices;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<CsmaNetDevice> device = CreateObject<CsmaNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      device->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+      device->SetInterframeGap (MicroSeconds (1));
+      device->SetAttribute ("MaxBurstPackets", UintegerValue (maxBurstPackets));
+      node->AddDevice (device);
+      device->Attach (channel);
+      device->SetReceiveCallback (MakeCallback (&CsmaBurstTest::Receive, this));
+      devices.push_back (device);
+    }
+
+  if (traceTx)
+    {
+      devices[0]->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&CsmaBurstTest::PhyTxBegin, this));
+      devices[0]->TraceConnectWithoutContext ("PhyTxEnd", MakeCallback (&CsmaBurstTest::PhyTxEnd, this));
+      devices[0]->TraceConnectWithoutContext ("PromiscSniffer", MakeCallback (&CsmaBurstTest::Sniffer, this));
+    }
+  m_rxTimes.clear ();
+  m_txTimes.clear ();
+  m_txEndTimes.clear ();
+  m_snifferTimes.clear ();
+  Simulator::Schedule (Seconds (1.0), &CsmaBurstTest::SendPackets, this, devices[0]);
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_txTimes.size (), traceTx ? m_nPackets : 0, "Not all the packets have been transmitted");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes.size (), 2 * m_nPackets, "Not all the packets have been received");
+  return events;
+}
+
+void
+CsmaBurstTest::CheckTimes (const std::vector<Time> &times, const std::vector<Time> &expected, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (times.size (), expected.size (), "Unexpected number of " << name << " times");
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (times[i], expected[i], "Different " << name << " time " << i << " in burst mode");
+    }
+}
+
+void
+CsmaBurstTest::DoRun (void)
+{
+  uint64_t eventsNoBurst = RunOne (1, Seconds (0), false);
+  uint64_t eventsBurst = RunOne (m_nPackets, Seconds (0), false);
+  NS_TEST_EXPECT_MSG_LT (eventsBurst, eventsNoBurst, "Burst mode should schedule fewer events");
+
+  RunOne (1, Seconds (0), true);
+  std::vector<Time> rxTimes = m_rxTimes;
+  std::vector<Time> txTimes = m_txTimes;
+  std::vector<Time> txEndTimes = m_txEndTimes;
+  std::vector<Time> snifferTimes = m_snifferTimes;
+  RunOne (m_nPackets, Seconds (0), true);
+  CheckTimes (m_rxTimes, rxTimes, "receive");
+  CheckTimes (m_txTimes, txTimes, "PhyTxBegin");
+  CheckTimes (m_txEndTimes, txEndTimes, "PhyTxEnd");
+  CheckTimes (m_snifferTimes, snifferTimes, "PromiscSniffer");
+
+  // Each packet is received by two devices
+  rxTimes = m_rxTimes;
+  txTimes = m_txTimes;
+  RunOne (m_nPackets, MicroSeconds (10), true);
+  NS_TEST_ASSERT_MSG_EQ (m_rxTimes.size (), rxTimes.size (), "Unexpected number of packets received");
+  for (uint32_t i = 0; i < rxTimes.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_rxTimes[i] - m_txTimes[i / 2], rxTimes[i] - txTimes[i / 2] + MicroSeconds (10),
+                             "Packet " << i << " not delayed by the channel");
+    }
+}
+
+/**
+ * \ingroup csma-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the Csma module
+ */
+class CsmaTestSuite : public TestSuite
+{
+public:
+  CsmaTestSuite ();
+};
+
+CsmaTestSuite::CsmaTestSuite ()
+  : TestSuite ("devices-csma", UNIT)
+{
+  AddTestCase (new CsmaBurstTest, TestCase::QUICK);
+}
+
+static CsmaTestSuite g_csmaTestSuite; //!< Static variable for test initialization
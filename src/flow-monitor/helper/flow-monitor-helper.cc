@@ -71,6 +71,13 @@ FlowMonitorHelper::GetMonitor ()
 }
 
 
+int64_t
+FlowMonitorHelper::AssignStreams (int64_t stream)
+{
+  return GetMonitor ()->AssignStreams (stream);
+}
+
+
 Ptr<FlowClassifier>
 FlowMonitorHelper::GetClassifier ()
 {
@@ -86,6 +86,17 @@ public:
    */
   Ptr<FlowClassifier> GetClassifier6 ();
 
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by the FlowMonitor object (created if needed), i.e., the packet
+   * sampling decisions.  Return the number of streams (possibly zero)
+   * that have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this helper
+   */
+  int64_t AssignStreams (int64_t stream);
+
   /**
    * Serializes the results to an std::ostream in XML format
    * \param os the output stream
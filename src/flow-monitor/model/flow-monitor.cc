@@ -21,11 +21,18 @@
 #include "flow-monitor.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
 #include <fstream>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
+// Number of delays of a flow buffered before they are added to its histogram
+#define DELAY_BATCH_SIZE 64
 
 namespace ns3 {
 
@@ -53,6 +60,13 @@ FlowMonitor::GetTypeId (void)
                    DoubleValue (0.001),
                    MakeDoubleAccessor (&FlowMonitor::m_delayBinWidth),
                    MakeDoubleChecker <double> ())
+    .AddAttribute ("DelaySubBins", ("If not 0, the delay histogram uses log-scaled bins: this number "
+                                    "(a power of two) of bins of width DelayBinWidth, then bins "
+                                    "whose width doubles each time the delay doubles."),
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlowMonitor::SetDelaySubBins,
+                                         &FlowMonitor::GetDelaySubBins),
+                   MakeUintegerChecker<uint32_t> ())
     .AddAttribute ("JitterBinWidth", ("The width used in the jitter histogram."),
                    DoubleValue (0.001),
                    MakeDoubleAccessor (&FlowMonitor::m_jitterBinWidth),
@@ -69,6 +83,23 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (0.5)),
                    MakeTimeAccessor (&FlowMonitor::m_flowInterruptionsMinTime),
                    MakeTimeChecker ())
+    .AddAttribute ("EnableHistograms", ("Whether the delay, jitter, packet size and flow interruptions "
+                                        "histograms are updated."),
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&FlowMonitor::m_enableHistograms),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SamplingMode", ("Whether all packets, the packets of a subset of the flows, "
+                                    "or a random subset of the packets are monitored."),
+                   EnumValue (SAMPLE_NONE),
+                   MakeEnumAccessor (&FlowMonitor::m_samplingMode),
+                   MakeEnumChecker (SAMPLE_NONE, "None",
+                                    SAMPLE_FLOWS, "Flows",
+                                    SAMPLE_PACKETS, "Packets"))
+    .AddAttribute ("SamplingRate", ("One flow or packet in SamplingRate is monitored "
+                                    "when SamplingMode is not None."),
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FlowMonitor::m_samplingRate),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -80,7 +111,10 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_trackedWheelFirstSlot (0),
+    m_enabled (false),
+    m_samplingMode (SAMPLE_NONE),
+    m_samplingRate (1)
 {
   // m_histogramBinWidth=DEFAULT_BIN_WIDTH;
 }
@@ -99,17 +133,37 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  Simulator::Cancel (m_exportEvent);
+  m_exportStream = 0;
+  m_samplingRv = 0;
   Object::DoDispose ();
 }
 
-inline FlowMonitor::FlowStats&
-FlowMonitor::GetStatsForFlow (FlowId flowId)
+void
+FlowMonitor::SetDelaySubBins (uint32_t subBins)
+{
+  NS_LOG_FUNCTION (this << subBins);
+  NS_ABORT_MSG_UNLESS (subBins == 0 || (subBins >= 2 && (subBins & (subBins - 1)) == 0),
+                       "DelaySubBins must be 0 or a power of two not smaller than 2, got " << subBins);
+  m_delaySubBins = subBins;
+}
+
+uint32_t
+FlowMonitor::GetDelaySubBins (void) const
+{
+  return m_delaySubBins;
+}
+
+inline FlowMonitor::FlowStatsIndexEntry&
+FlowMonitor::GetIndexEntryForFlow (FlowId flowId)
 {
-  FlowStatsContainerI iter;
-  iter = m_flowStats.find (flowId);
-  if (iter == m_flowStats.end ())
+  std::unordered_map<FlowId, FlowStatsIndexEntry>::iterator iter;
+  iter = m_flowStatsIndex.find (flowId);
+  if (iter == m_flowStatsIndex.end ())
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
+      FlowStatsIndexEntry &entry = m_flowStatsIndex[flowId];
+      entry.stats = &ref;
       ref.delaySum = Seconds (0);
       ref.jitterSum = Seconds (0);
       ref.lastDelay = Seconds (0);
@@ -120,10 +174,14 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.lostPackets = 0;
       ref.timesForwarded = 0;
       ref.delayHistogram.SetDefaultBinWidth (m_delayBinWidth);
+      if (m_delaySubBins)
+        {
+          ref.delayHistogram.SetLogScaledBins (m_delayBinWidth, m_delaySubBins);
+        }
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
-      return ref;
+      return entry;
     }
   else
     {
@@ -131,6 +189,49 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
     }
 }
 
+inline FlowMonitor::FlowStats&
+FlowMonitor::GetStatsForFlow (FlowId flowId)
+{
+  return *GetIndexEntryForFlow (flowId).stats;
+}
+
+void
+FlowMonitor::FlushPendingDelays () const
+{
+  for (std::unordered_map<FlowId, FlowStatsIndexEntry>::iterator iter = m_flowStatsIndex.begin ();
+       iter != m_flowStatsIndex.end (); ++iter)
+    {
+      std::vector<double> &delays = iter->second.pendingDelays;
+      if (!delays.empty ())
+        {
+          iter->second.stats->delayHistogram.AddValues (&delays[0], static_cast<uint32_t> (delays.size ()));
+          delays.clear ();
+        }
+    }
+}
+
+void
+FlowMonitor::ScheduleTrackedPacket (uint64_t key, TrackedPacket &tracked)
+{
+  int64_t slot = tracked.lastSeenTime.GetTimeStep () / PERIODIC_CHECK_INTERVAL.GetTimeStep ();
+  if (slot == tracked.slot)
+    {
+      return;
+    }
+  tracked.slot = slot;
+  if (m_trackedWheel.empty ())
+    {
+      m_trackedWheelFirstSlot = slot;
+    }
+  NS_ASSERT (slot >= m_trackedWheelFirstSlot);
+  std::size_t index = static_cast<std::size_t> (slot - m_trackedWheelFirstSlot);
+  if (index >= m_trackedWheel.size ())
+    {
+      m_trackedWheel.resize (index + 1);
+    }
+  m_trackedWheel[index].push_back (key);
+}
+
 
 void
 FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetId, uint32_t packetSize)
@@ -140,10 +241,18 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  uint64_t key = (static_cast<uint64_t> (flowId) << 32) | packetId;
+  std::pair<TrackedPacketMap::iterator, bool> insert
+    = m_trackedPackets.insert (std::make_pair (key, TrackedPacket ()));
+  TrackedPacket &tracked = insert.first->second;
+  if (insert.second)
+    {
+      tracked.slot = -1;
+    }
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
+  ScheduleTrackedPacket (key, tracked);
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -167,7 +276,7 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
     {
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
+  uint64_t key = (static_cast<uint64_t> (flowId) << 32) | packetId;
   TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
   if (tracked == m_trackedPackets.end ())
     {
@@ -178,6 +287,7 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
 
   tracked->second.timesForwarded++;
   tracked->second.lastSeenTime = Simulator::Now ();
+  ScheduleTrackedPacket (key, tracked->second);
 
   Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
@@ -191,7 +301,8 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  uint64_t key = (static_cast<uint64_t> (flowId) << 32) | packetId;
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
   if (tracked == m_trackedPackets.end ())
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
@@ -203,27 +314,46 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
   Time delay = (now - tracked->second.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
-  FlowStats &stats = GetStatsForFlow (flowId);
+  FlowStatsIndexEntry &entry = GetIndexEntryForFlow (flowId);
+  FlowStats &stats = *entry.stats;
   stats.delaySum += delay;
-  stats.delayHistogram.AddValue (delay.GetSeconds ());
+  if (m_enableHistograms)
+    {
+      // The delays are added to the histogram by batches
+      entry.pendingDelays.push_back (delay.GetSeconds ());
+      if (entry.pendingDelays.size () == DELAY_BATCH_SIZE)
+        {
+          stats.delayHistogram.AddValues (&entry.pendingDelays[0], DELAY_BATCH_SIZE);
+          entry.pendingDelays.clear ();
+        }
+    }
   if (stats.rxPackets > 0 )
     {
       Time jitter = stats.lastDelay - delay;
       if (jitter > Seconds (0))
         {
           stats.jitterSum += jitter;
-          stats.jitterHistogram.AddValue (jitter.GetSeconds ());
+          if (m_enableHistograms)
+            {
+              stats.jitterHistogram.AddValue (jitter.GetSeconds ());
+            }
         }
       else 
         {
           stats.jitterSum -= jitter;
-          stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+          if (m_enableHistograms)
+            {
+              stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+            }
         }
     }
   stats.lastDelay = delay;
 
   stats.rxBytes += packetSize;
-  stats.packetSizeHistogram.AddValue ((double) packetSize);
+  if (m_enableHistograms)
+    {
+      stats.packetSizeHistogram.AddValue ((double) packetSize);
+    }
   stats.rxPackets++;
   if (stats.rxPackets == 1)
     {
@@ -233,7 +363,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       // measure possible flow interruptions
       Time interArrivalTime = now - stats.timeLastRxPacket;
-      if (interArrivalTime > m_flowInterruptionsMinTime)
+      if (m_enableHistograms && interArrivalTime > m_flowInterruptionsMinTime)
         {
           stats.flowInterruptionsHistogram.AddValue (interArrivalTime.GetSeconds ());
         }
@@ -269,7 +399,8 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  uint64_t key = (static_cast<uint64_t> (flowId) << 32) | packetId;
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
   if (tracked != m_trackedPackets.end ())
     {
       // we don't need to track this packet anymore
@@ -283,32 +414,149 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
 const FlowMonitor::FlowStatsContainer&
 FlowMonitor::GetFlowStats () const
 {
+  FlushPendingDelays ();
   return m_flowStats;
 }
 
+bool
+FlowMonitor::IsSampled (FlowId flowId)
+{
+  if (m_samplingRate == 1)
+    {
+      return true;
+    }
+  switch (m_samplingMode)
+    {
+    case SAMPLE_FLOWS:
+      {
+        // FlowIds are handed out in order of appearance: mix them with
+        // the run number so that each run samples different flows
+        uint32_t h = flowId ^ (RngSeedManager::GetRun () * 0x9e3779b9U);
+        h ^= h >> 16;
+        h *= 0x85ebca6bU;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35U;
+        h ^= h >> 16;
+        return h % m_samplingRate == 0;
+      }
+    case SAMPLE_PACKETS:
+      if (!m_samplingRv)
+        {
+          m_samplingRv = CreateObject<UniformRandomVariable> ();
+        }
+      return m_samplingRv->GetInteger (0, m_samplingRate - 1) == 0;
+    default:
+      return true;
+    }
+}
+
+uint32_t
+FlowMonitor::GetSamplingRate () const
+{
+  return m_samplingMode == SAMPLE_NONE ? 1 : m_samplingRate;
+}
+
+FlowMonitor::AggregateStats
+FlowMonitor::EstimateAggregateStats () const
+{
+  AggregateStats aggregate;
+  aggregate.txPackets = 0;
+  aggregate.txBytes = 0;
+  aggregate.rxPackets = 0;
+  aggregate.rxBytes = 0;
+  aggregate.lostPackets = 0;
+  Time delaySum = Seconds (0);
+  Time jitterSum = Seconds (0);
+  int64_t delaySamples = 0;
+  int64_t jitterSamples = 0;
+  for (FlowStatsContainerCI iter = m_flowStats.begin (); iter != m_flowStats.end (); ++iter)
+    {
+      const FlowStats &stats = iter->second;
+      aggregate.txPackets += stats.txPackets;
+      aggregate.txBytes += stats.txBytes;
+      aggregate.rxPackets += stats.rxPackets;
+      aggregate.rxBytes += stats.rxBytes;
+      aggregate.lostPackets += stats.lostPackets;
+      delaySum += stats.delaySum;
+      jitterSum += stats.jitterSum;
+      delaySamples += stats.rxPackets;
+      if (stats.rxPackets > 1)
+        {
+          jitterSamples += stats.rxPackets - 1;
+        }
+    }
+  aggregate.meanDelay = delaySamples > 0 ? delaySum / delaySamples : Seconds (0);
+  aggregate.meanJitter = jitterSamples > 0 ? jitterSum / jitterSamples : Seconds (0);
+
+  double rate = GetSamplingRate ();
+  aggregate.txPackets *= rate;
+  aggregate.txBytes *= rate;
+  aggregate.rxPackets *= rate;
+  aggregate.rxBytes *= rate;
+  aggregate.lostPackets *= rate;
+  return aggregate;
+}
+
+int64_t
+FlowMonitor::AssignStreams (int64_t stream)
+{
+  if (!m_samplingRv)
+    {
+      m_samplingRv = CreateObject<UniformRandomVariable> ();
+    }
+  m_samplingRv->SetStream (stream);
+  return 1;
+}
+
 
 void
 FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
-  Time now = Simulator::Now ();
+  FlushPendingDelays ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // A packet is lost if it was last seen at or before this time
+  Time threshold = Simulator::Now () - maxDelay;
+  int64_t slotWidth = PERIODIC_CHECK_INTERVAL.GetTimeStep ();
+
+  // Only the slots which are old enough are visited: the packets of a
+  // slot ending before the threshold are all lost, those of the slot
+  // containing the threshold must be checked one by one.
+  while (!m_trackedWheel.empty ()
+         && TimeStep (m_trackedWheelFirstSlot * slotWidth) <= threshold)
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      bool expired = TimeStep ((m_trackedWheelFirstSlot + 1) * slotWidth) <= threshold;
+      std::vector<uint64_t> &keys = m_trackedWheel.front ();
+      std::vector<uint64_t> kept;
+      for (std::vector<uint64_t>::const_iterator i = keys.begin (); i != keys.end (); ++i)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          TrackedPacketMap::iterator tracked = m_trackedPackets.find (*i);
+          if (tracked == m_trackedPackets.end () || tracked->second.slot != m_trackedWheelFirstSlot)
+            {
+              // received, dropped, or seen again later
+              continue;
+            }
+          if (expired || tracked->second.lastSeenTime <= threshold)
+            {
+              // packet is considered lost, add it to the loss statistics
+              FlowId flowId = static_cast<FlowId> (*i >> 32);
+              NS_ASSERT (m_flowStatsIndex.find (flowId) != m_flowStatsIndex.end ());
+              m_flowStatsIndex[flowId].stats->lostPackets++;
+
+              // we won't track it anymore
+              m_trackedPackets.erase (tracked);
+            }
+          else
+            {
+              kept.push_back (*i);
+            }
         }
-      else
+      if (!expired)
         {
-          iter++;
+          keys.swap (kept);
+          break;
         }
+      m_trackedWheel.pop_front ();
+      m_trackedWheelFirstSlot++;
     }
 }
 
@@ -325,6 +573,102 @@ FlowMonitor::PeriodicCheckForLostPackets ()
   Simulator::Schedule (PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::EnablePeriodicExport (Ptr<OutputStreamWrapper> stream, Time interval)
+{
+  NS_ASSERT (interval.IsStrictlyPositive ());
+  DisablePeriodicExport ();
+  m_exportStream = stream;
+  m_exportInterval = interval;
+  *m_exportStream->GetStream () << "# time flowId txPackets txBytes rxPackets rxBytes delaySum jitterSum "
+                                << "lostPackets droppedPackets droppedBytes" << std::endl;
+  m_exportEvent = Simulator::Schedule (m_exportInterval, &FlowMonitor::PeriodicExport, this);
+}
+
+void
+FlowMonitor::DisablePeriodicExport ()
+{
+  if (m_exportStream == 0)
+    {
+      return;
+    }
+  Simulator::Cancel (m_exportEvent);
+  ExportDeltas ();
+  m_exportStream = 0;
+}
+
+void
+FlowMonitor::PeriodicExport ()
+{
+  ExportDeltas ();
+  m_exportEvent = Simulator::Schedule (m_exportInterval, &FlowMonitor::PeriodicExport, this);
+}
+
+void
+FlowMonitor::ExportDeltas ()
+{
+  CheckForLostPackets ();
+
+  std::ostream &os = *m_exportStream->GetStream ();
+  double now = Simulator::Now ().GetSeconds ();
+  for (FlowStatsContainerCI flowI = m_flowStats.begin ();
+       flowI != m_flowStats.end (); flowI++)
+    {
+      const FlowStats &stats = flowI->second;
+      uint32_t droppedPackets = 0;
+      uint64_t droppedBytes = 0;
+      for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size (); reasonCode++)
+        {
+          droppedPackets += stats.packetsDropped[reasonCode];
+          droppedBytes += stats.bytesDropped[reasonCode];
+        }
+
+      std::pair<std::unordered_map<FlowId, ExportedStats>::iterator, bool> insert
+        = m_exportedStats.insert (std::make_pair (flowI->first, ExportedStats ()));
+      ExportedStats &last = insert.first->second;
+      if (insert.second)
+        {
+          last.delaySum = Seconds (0);
+          last.jitterSum = Seconds (0);
+          last.txBytes = 0;
+          last.rxBytes = 0;
+          last.txPackets = 0;
+          last.rxPackets = 0;
+          last.lostPackets = 0;
+          last.droppedPackets = 0;
+          last.droppedBytes = 0;
+        }
+      if (last.txPackets == stats.txPackets && last.rxPackets == stats.rxPackets
+          && last.lostPackets == stats.lostPackets && last.droppedPackets == droppedPackets)
+        {
+          continue;
+        }
+
+      os << now << " " << flowI->first
+         << " " << stats.txPackets - last.txPackets
+         << " " << stats.txBytes - last.txBytes
+         << " " << stats.rxPackets - last.rxPackets
+         << " " << stats.rxBytes - last.rxBytes
+         << " " << (stats.delaySum - last.delaySum).GetSeconds ()
+         << " " << (stats.jitterSum - last.jitterSum).GetSeconds ()
+         << " " << stats.lostPackets - last.lostPackets
+         << " " << droppedPackets - last.droppedPackets
+         << " " << droppedBytes - last.droppedBytes
+         << "\n";
+
+      last.delaySum = stats.delaySum;
+      last.jitterSum = stats.jitterSum;
+      last.txBytes = stats.txBytes;
+      last.rxBytes = stats.rxBytes;
+      last.txPackets = stats.txPackets;
+      last.rxPackets = stats.rxPackets;
+      last.lostPackets = stats.lostPackets;
+      last.droppedPackets = droppedPackets;
+      last.droppedBytes = droppedBytes;
+    }
+  os.flush ();
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted ()
 {
@@ -23,6 +23,8 @@
 
 #include <vector>
 #include <map>
+#include <deque>
+#include <unordered_map>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -31,6 +33,8 @@
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/random-variable-stream.h"
 
 namespace ns3 {
 
@@ -256,6 +260,70 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Periodically write to a stream the statistics accumulated by each
+  /// flow since the previous export.  Each export writes one line per
+  /// flow which changed, with the simulation time in seconds, the
+  /// FlowId, and the increments of txPackets, txBytes, rxPackets,
+  /// rxBytes, delaySum and jitterSum (in seconds), lostPackets, and of
+  /// the packets and bytes dropped for any reason.  Combined with the
+  /// EnableHistograms attribute, this allows long runs to be monitored
+  /// without keeping per-packet data in memory.
+  /// \param stream the output stream, e.g., created by
+  ///        AsciiTraceHelper::CreateFileStream
+  /// \param interval the time between two exports
+  void EnablePeriodicExport (Ptr<OutputStreamWrapper> stream, Time interval);
+  /// Stop the periodic export enabled by EnablePeriodicExport, after a
+  /// final export
+  void DisablePeriodicExport ();
+
+  // --- sampling ---
+
+  /// How the probes select the flows or packets they report
+  enum SamplingMode
+  {
+    SAMPLE_NONE,     //!< All packets are monitored
+    SAMPLE_FLOWS,    //!< All packets of one flow in SamplingRate are monitored
+    SAMPLE_PACKETS   //!< One packet in SamplingRate, at random, is monitored
+  };
+
+  /// Estimated totals over all the flows, sampled or not
+  struct AggregateStats
+  {
+    double txPackets;   //!< Estimated number of transmitted packets
+    double txBytes;     //!< Estimated number of transmitted bytes
+    double rxPackets;   //!< Estimated number of received packets
+    double rxBytes;     //!< Estimated number of received bytes
+    double lostPackets; //!< Estimated number of lost packets
+    Time meanDelay;     //!< Mean delay of the received packets
+    Time meanJitter;    //!< Mean jitter of the received packets
+  };
+
+  /// Decide whether a probe should report a packet leaving its source,
+  /// according to the SamplingMode and SamplingRate attributes.  Packets
+  /// which are not sampled are neither reported nor tagged, and cost
+  /// nothing to the probes of the following hops.
+  /// \param flowId the flow of the packet
+  /// \returns true if the packet is to be monitored
+  bool IsSampled (FlowId flowId);
+
+  /// \returns the number of flows (SAMPLE_FLOWS) or packets
+  /// (SAMPLE_PACKETS) represented by each monitored one, or 1
+  uint32_t GetSamplingRate () const;
+
+  /// Estimate the totals over all the flows from the sampled
+  /// statistics.  The counters of the monitored flows or packets are
+  /// scaled by the sampling rate, which is an unbiased estimator of the
+  /// totals since each flow or packet is sampled with probability
+  /// 1/SamplingRate.  The mean delay and jitter are ratio estimators.
+  /// \returns the estimated aggregate statistics
+  AggregateStats EstimateAggregateStats () const;
+
+  /// Assign a fixed random variable stream number to the random
+  /// variables used by this model.
+  /// \param stream first stream index to use
+  /// \returns the number of stream indices assigned by this model
+  int64_t AssignStreams (int64_t stream);
+
 
 protected:
 
@@ -270,14 +338,30 @@ private:
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+    int64_t slot; //!< time wheel slot holding the packet, or -1
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// Entry of the hashed index into m_flowStats
+  struct FlowStatsIndexEntry
+  {
+    FlowStats *stats; //!< the statistics of the flow, in m_flowStats
+    std::vector<double> pendingDelays; //!< delays not yet added to the delay histogram
+  };
+  /// FlowId --> FlowStats, hashed index into m_flowStats.  Mutable since
+  /// the pending delays are flushed to the histograms by GetFlowStats.
+  mutable std::unordered_map<FlowId, FlowStatsIndexEntry> m_flowStatsIndex;
 
-  /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  /// (FlowId,PacketId) --> TrackedPacket, the key being (FlowId << 32) | PacketId
+  typedef std::unordered_map<uint64_t, TrackedPacket> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+
+  /// Time wheel of tracked packet keys, one slot per period of the lost
+  /// packet check.  A packet is listed in the slot of its last seen
+  /// time; stale entries are skipped when the slot expires.
+  std::deque<std::vector<uint64_t> > m_trackedWheel;
+  int64_t m_trackedWheelFirstSlot; //!< slot number of m_trackedWheel.front ()
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -288,18 +372,73 @@ private:
   EventId m_stopEvent;      //!< Stop event
   bool m_enabled;           //!< FlowMon is enabled
   double m_delayBinWidth;   //!< Delay bin width (for histograms)
+  uint32_t m_delaySubBins;  //!< Delay histogram log-scaled sub-bins, or 0
   double m_jitterBinWidth;  //!< Jitter bin width (for histograms)
   double m_packetSizeBinWidth;  //!< packet size bin width (for histograms)
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
+  bool m_enableHistograms;  //!< Update the histograms of the flows
+
+  /// The counters of a flow at the time of the last periodic export
+  struct ExportedStats
+  {
+    Time delaySum;           //!< delaySum of the flow
+    Time jitterSum;          //!< jitterSum of the flow
+    uint64_t txBytes;        //!< txBytes of the flow
+    uint64_t rxBytes;        //!< rxBytes of the flow
+    uint32_t txPackets;      //!< txPackets of the flow
+    uint32_t rxPackets;      //!< rxPackets of the flow
+    uint32_t lostPackets;    //!< lostPackets of the flow
+    uint32_t droppedPackets; //!< total of packetsDropped of the flow
+    uint64_t droppedBytes;   //!< total of bytesDropped of the flow
+  };
+  /// FlowId --> counters at the last periodic export
+  std::unordered_map<FlowId, ExportedStats> m_exportedStats;
+  Ptr<OutputStreamWrapper> m_exportStream; //!< Periodic export stream
+  Time m_exportInterval;    //!< Periodic export interval
+  EventId m_exportEvent;    //!< Next periodic export event
+
+  SamplingMode m_samplingMode; //!< Sampling mode
+  uint32_t m_samplingRate;  //!< One flow or packet in m_samplingRate is sampled
+  Ptr<UniformRandomVariable> m_samplingRv; //!< Packet sampling decisions
+
+  /**
+   * Set the number of log-scaled sub-bins of the delay histograms
+   * \param subBins 0, or a power of two not smaller than 2
+   */
+  void SetDelaySubBins (uint32_t subBins);
+  /**
+   * Get the number of log-scaled sub-bins of the delay histograms
+   * \returns the number of sub-bins, or 0
+   */
+  uint32_t GetDelaySubBins (void) const;
+
+  /// Get the index entry of a given flow, creating its stats if needed
+  /// \param flowId the Flow identification
+  /// \returns the index entry of the flow
+  FlowStatsIndexEntry& GetIndexEntryForFlow (FlowId flowId);
 
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
   FlowStats& GetStatsForFlow (FlowId flowId);
 
+  /// Add the delays buffered by ReportLastRx to the delay histograms,
+  /// with one Histogram::AddValues call per flow
+  void FlushPendingDelays () const;
+
+  /// Insert a tracked packet in the time wheel slot of its last seen
+  /// time, unless it is already there
+  /// \param key the tracked packet key
+  /// \param tracked the tracked packet
+  void ScheduleTrackedPacket (uint64_t key, TrackedPacket &tracked);
+
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+  /// Write the statistics accumulated since the previous export
+  void ExportDeltas ();
+  /// Periodic function to export the statistics
+  void PeriodicExport ();
 };
 
 
@@ -23,6 +23,7 @@
 #include "histogram.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 
 #define DEFAULT_BIN_WIDTH       1
 // #define RESERVED_BINS_INC	10
@@ -45,21 +46,37 @@ Histogram::GetNBins () const
 }
 
 double 
-Histogram::GetBinStart (uint32_t index)
+Histogram::GetBinStart (uint32_t index) const
 {
+  if (index < m_subBins)
+    {
+      return index * m_binWidth;
+    }
+  if (m_subBins)
+    {
+      uint32_t half = m_subBins / 2;
+      uint32_t b = (index - m_subBins) / half + 1;
+      uint32_t r = (index - m_subBins) % half;
+      return std::ldexp ((half + r) * m_binWidth, b);
+    }
   return index*m_binWidth;
 }
 
 double 
-Histogram::GetBinEnd (uint32_t index)
+Histogram::GetBinEnd (uint32_t index) const
 {
-  return (index + 1) * m_binWidth;
+  return GetBinStart (index) + GetBinWidth (index);
 }
 
 double 
 Histogram::GetBinWidth (uint32_t index) const
 {
-  return m_binWidth;
+  if (index < m_subBins || !m_subBins)
+    {
+      return m_binWidth;
+    }
+  uint32_t b = (index - m_subBins) / (m_subBins / 2) + 1;
+  return std::ldexp (m_binWidth, b);
 }
 
 void 
@@ -67,6 +84,16 @@ Histogram::SetDefaultBinWidth (double binWidth)
 {
   NS_ASSERT (m_histogram.size () == 0); //we can only change the bin width if no values were added
   m_binWidth = binWidth;
+  m_subBins = 0;
+}
+
+void
+Histogram::SetLogScaledBins (double minBinWidth, uint32_t subBins)
+{
+  NS_ASSERT (m_histogram.size () == 0);
+  NS_ABORT_MSG_UNLESS (subBins >= 2 && (subBins & (subBins - 1)) == 0, "subBins must be a power of two not smaller than 2");
+  m_binWidth = minBinWidth;
+  m_subBins = subBins;
 }
 
 uint32_t 
@@ -76,10 +103,33 @@ Histogram::GetBinCount (uint32_t index)
   return m_histogram[index];
 }
 
+inline uint32_t
+Histogram::GetIndex (double value) const
+{
+  if (!m_subBins)
+    {
+      return (uint32_t)std::floor (value/m_binWidth);
+    }
+  double scaled = value / m_binWidth;
+  uint64_t q = scaled < 4611686018427387904.0 ? (uint64_t)scaled : (uint64_t)1 << 62;
+  if (q < m_subBins)
+    {
+      return (uint32_t)q;
+    }
+  // Smallest b such that q < subBins * 2^b: q falls in one of the
+  // subBins / 2 bins of width 2^b of [subBins * 2^(b-1), subBins * 2^b)
+  uint32_t b = 1;
+  while ((q >> b) >= m_subBins)
+    {
+      b++;
+    }
+  return m_subBins + (b - 1) * (m_subBins / 2) + (uint32_t)(q >> b) - m_subBins / 2;
+}
+
 void 
 Histogram::AddValue (double value)
 {
-  uint32_t index = (uint32_t)std::floor (value/m_binWidth);
+  uint32_t index = GetIndex (value);
 
   //check if we need to resize the vector
   NS_LOG_DEBUG ("AddValue: index=" << index << ", m_histogram.size()=" << m_histogram.size ());
@@ -91,14 +141,52 @@ Histogram::AddValue (double value)
   m_histogram[index]++;
 }
 
+void
+Histogram::AddValues (const double *values, uint32_t n)
+{
+  if (n == 0)
+    {
+      return;
+    }
+  // The bin index is monotonic in the value: resize once for the largest
+  double maxValue = values[0];
+  for (uint32_t i = 1; i < n; i++)
+    {
+      maxValue = values[i] > maxValue ? values[i] : maxValue;
+    }
+  uint32_t maxIndex = GetIndex (maxValue);
+  if (maxIndex >= m_histogram.size ())
+    {
+      m_histogram.resize (maxIndex + 1, 0);
+    }
+  uint32_t *bins = &m_histogram[0];
+  if (!m_subBins)
+    {
+      // Keep the index computation inline, so that it is vectorized
+      for (uint32_t i = 0; i < n; i++)
+        {
+          bins[(uint32_t)std::floor (values[i]/m_binWidth)]++;
+        }
+    }
+  else
+    {
+      for (uint32_t i = 0; i < n; i++)
+        {
+          bins[GetIndex (values[i])]++;
+        }
+    }
+}
+
 Histogram::Histogram (double binWidth)
 {
   m_binWidth = binWidth;
+  m_subBins = 0;
 }
 
 Histogram::Histogram ()
 {
   m_binWidth = DEFAULT_BIN_WIDTH;
+  m_subBins = 0;
 }
 
 void
@@ -117,8 +205,8 @@ Histogram::SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string
           os << std::string ( indent, ' ' );
           os << "<bin"
              << " index=\"" << (index) << "\""
-             << " start=\"" << (index*m_binWidth) << "\""
-             << " width=\"" << m_binWidth << "\""
+             << " start=\"" << GetBinStart (index) << "\""
+             << " width=\"" << GetBinWidth (index) << "\""
              << " count=\"" << m_histogram[index] << "\""
              << " />\n";
         }
@@ -34,6 +34,12 @@ namespace ns3 {
  * bin according to the following formula: floor(value/binWidth).
  * Hence, bin \a i groups the data from [i*binWidth, (i+1)binWidth).
  *
+ * Alternatively, SetLogScaledBins selects log-scaled bins, in the style of
+ * HDR histograms: the first bins have the minimum width, and the width
+ * then doubles every time the value doubles, so that the relative error
+ * stays bounded and the number of bins only grows with the logarithm of
+ * the largest value.
+ *
  * This class only handles \a positive bins, i.e., it does \a not handles negative data.
  *
  * \todo Add support for negative data.
@@ -65,17 +71,18 @@ public:
    * \param index the bin index
    * \return the bin start
    */
-  double GetBinStart (uint32_t index);
+  double GetBinStart (uint32_t index) const;
   /**
    * \brief Returns the bin end, i.e., (index+1)*binWidth
    * \param index the bin index
    * \return the bin start
    */
-  double GetBinEnd (uint32_t index);
+  double GetBinEnd (uint32_t index) const;
   /**
    * \brief Returns the bin width.
    *
-   * Note that all the bins have the same width.
+   * Note that all the bins have the same width, unless log-scaled bins
+   * are used.
    *
    * \param index the bin index
    * \return the bin width
@@ -89,6 +96,21 @@ public:
    * \param binWidth the bin width
    */
   void SetDefaultBinWidth (double binWidth);
+  /**
+   * \brief Use log-scaled bins.
+   *
+   * The first \p subBins bins have a width of \p minBinWidth.  Each
+   * following range [subBins * 2^(b-1), subBins * 2^b) * minBinWidth,
+   * for b >= 1, is split in subBins / 2 bins of width 2^b * minBinWidth.
+   * The width of a bin is thus at most 2 / subBins of the values it holds.
+   *
+   * Note that the bins can be changed only if the histogram is empty.
+   *
+   * \param minBinWidth the width of the smallest bins
+   * \param subBins the number of bins of the smallest width, a power of
+   *        two not smaller than 2
+   */
+  void SetLogScaledBins (double minBinWidth, uint32_t subBins);
   /**
    * \brief Get the number of data added to the bin.
    * \param index the bin index
@@ -102,6 +124,17 @@ public:
    * \param value the value to add
    */
   void AddValue (double value);
+  /**
+   * \brief Add values to the histogram
+   *
+   * Equivalent to calling AddValue for each value, but the bin indices
+   * are computed in tight loops which the compiler can vectorize, and
+   * the histogram is resized at most once.
+   *
+   * \param values the values to add
+   * \param n the number of values
+   */
+  void AddValues (const double *values, uint32_t n);
 
   /**
    * \brief Serializes the results to an std::ostream in XML format.
@@ -113,8 +146,16 @@ public:
 
 
 private:
+  /**
+   * \brief Get the bin of a value
+   * \param value the value
+   * \return the bin index
+   */
+  uint32_t GetIndex (double value) const;
+
   std::vector<uint32_t> m_histogram; //!< Histogram data
-  double m_binWidth; //!< Bin width
+  double m_binWidth; //!< Bin width, or smallest bin width if m_subBins is not 0
+  uint32_t m_subBins; //!< Number of smallest bins if log-scaled, 0 otherwise
 };
 
 
@@ -95,6 +95,18 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 }
 
 
+std::size_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &t) const
+{
+  std::size_t hash = Ipv4AddressHash () (t.sourceAddress);
+  hash = hash * 31 + Ipv4AddressHash () (t.destinationAddress);
+  hash = hash * 31 + t.protocol;
+  hash = hash * 31 + t.sourcePort;
+  hash = hash * 31 + t.destinationPort;
+  return hash;
+}
+
+
 
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
@@ -148,35 +160,29 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
+  std::pair<std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
+      NS_ASSERT (newFlowId == m_flowTuples.size () + 1);
       insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      m_flowTuples.push_back (tuple);
+      m_flowPktIds.push_back (0);
+      m_flowDscps.push_back (std::map<Ipv4Header::DscpType, uint32_t> ());
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      m_flowPktIds[insert.first->second - 1] ++;
     }
 
   // increment the counter of packets with the same DSCP value
-  Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
-    {
-      m_flowDscpMap[insert.first->second][dscp] ++;
-    }
+  m_flowDscps[insert.first->second - 1][ipHeader.GetDscp ()] ++;
 
   *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_packetId = m_flowPktIds[*out_flowId - 1];
 
   return true;
 }
@@ -185,17 +191,11 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flowTuples.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
-  return retval;
+  return m_flowTuples[flowId - 1];
 }
 
 bool
@@ -208,15 +208,13 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flowDscps.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  const std::map<Ipv4Header::DscpType, uint32_t> &dscps = m_flowDscps[flowId - 1];
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (dscps.begin (), dscps.end ());
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -227,29 +225,24 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::size_t index = 0; index < m_flowTuples.size (); index++)
     {
+      const FiveTuple &tuple = m_flowTuples[index];
       Indent (os, indent);
-      os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+      os << "<Flow flowId=\"" << index + 1 << "\""
+         << " sourceAddress=\"" << tuple.sourceAddress << "\""
+         << " destinationAddress=\"" << tuple.destinationAddress << "\""
+         << " protocol=\"" << int(tuple.protocol) << "\""
+         << " sourcePort=\"" << tuple.sourcePort << "\""
+         << " destinationPort=\"" << tuple.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      const std::map<Ipv4Header::DscpType, uint32_t> &dscps = m_flowDscps[index];
+      for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = dscps.begin (); i != dscps.end (); i++)
         {
-          for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
+#include <unordered_map>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
@@ -92,12 +94,22 @@ public:
 
 private:
 
+  /// Hash function of a FiveTuple
+  struct FiveTupleHash
+  {
+    /// \param t the tuple
+    /// \returns the hash of the tuple
+    std::size_t operator() (const FiveTuple &t) const;
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// The FiveTuple of each flow, indexed by FlowId - 1
+  std::vector<FiveTuple> m_flowTuples;
+  /// The last FlowPacketId of each flow, indexed by FlowId - 1
+  std::vector<FlowPacketId> m_flowPktIds;
+  /// The (DSCP value, packet count) pairs of each flow, indexed by FlowId - 1
+  std::vector<std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscps;
 
 };
 
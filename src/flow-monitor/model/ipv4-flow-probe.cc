@@ -306,7 +306,8 @@ Ipv4FlowProbe::SendOutgoingLogger (const Ipv4Header &ipHeader, Ptr<const Packet>
       return;
     }
 
-  if (m_classifier->Classify (ipHeader, ipPayload, &flowId, &packetId))
+  if (m_classifier->Classify (ipHeader, ipPayload, &flowId, &packetId)
+      && m_flowMonitor->IsSampled (flowId))
     {
       uint32_t size = (ipPayload->GetSize () + ipHeader.GetSerializedSize ());
       NS_LOG_DEBUG ("ReportFirstTx ("<<this<<", "<<flowId<<", "<<packetId<<", "<<size<<"); "
@@ -0,0 +1,480 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-probe.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief A FlowProbe driven by the test itself.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check that tracked packets are declared lost once, and only
+ * once they have not been seen for the maximum delay.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+public:
+  FlowMonitorLostPacketsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the first transmission of packets
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Transmit (uint32_t first, uint32_t last);
+  /**
+   * Report the reception of packets
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Receive (uint32_t first, uint32_t last);
+  /**
+   * Report the forwarding of a packet
+   * \param packetId the packet id
+   */
+  void Forward (uint32_t packetId);
+  /**
+   * Check for lost packets and record the number of lost packets
+   * \param maxDelay the maximum delay
+   */
+  void Check (Time maxDelay);
+
+  Ptr<FlowMonitor> m_monitor;       //!< The monitor
+  Ptr<FlowProbe> m_probe;           //!< The probe
+  std::vector<uint32_t> m_lost;     //!< Lost packets after each check
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase ()
+  : TestCase ("Check FlowMonitor lost packet detection")
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::Transmit (uint32_t first, uint32_t last)
+{
+  for (uint32_t i = first; i <= last; ++i)
+    {
+      m_monitor->ReportFirstTx (m_probe, 1, i, 100);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Receive (uint32_t first, uint32_t last)
+{
+  for (uint32_t i = first; i <= last; ++i)
+    {
+      m_monitor->ReportLastRx (m_probe, 1, i, 100);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Forward (uint32_t packetId)
+{
+  m_monitor->ReportForwarding (m_probe, 1, packetId, 100);
+}
+
+void
+FlowMonitorLostPacketsTestCase::Check (Time maxDelay)
+{
+  m_monitor->CheckForLostPackets (maxDelay);
+  m_lost.push_back (m_monitor->GetFlowStats ().find (1)->second.lostPackets);
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun (void)
+{
+  // Keep the periodic check out of the way
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1000)));
+  m_probe = CreateObject<FlowMonitorTestProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  Simulator::Schedule (Seconds (0.5), &FlowMonitorLostPacketsTestCase::Transmit, this, 0, 9);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitorLostPacketsTestCase::Receive, this, 0, 4);
+  Simulator::Schedule (Seconds (3.2), &FlowMonitorLostPacketsTestCase::Forward, this, 5);
+  Simulator::Schedule (Seconds (3.5), &FlowMonitorLostPacketsTestCase::Transmit, this, 10, 11);
+  // Nothing is old enough yet
+  Simulator::Schedule (Seconds (10.4), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (10));
+  // Packets 6 to 9, last seen at 0.5 s
+  Simulator::Schedule (Seconds (10.5), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (10));
+  Simulator::Schedule (Seconds (12), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (10));
+  // Packet 5, last seen at 3.2 s
+  Simulator::Schedule (Seconds (13.3), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (10));
+  // Packets 10 and 11, sent at 3.5 s, and nothing else
+  Simulator::Schedule (Seconds (14), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (0));
+  Simulator::Stop (Seconds (15));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_lost.size (), 5, "Missing checks");
+  NS_TEST_EXPECT_MSG_EQ (m_lost[0], 0, "Packets declared lost too early");
+  NS_TEST_EXPECT_MSG_EQ (m_lost[1], 4, "Unexpected number of lost packets");
+  NS_TEST_EXPECT_MSG_EQ (m_lost[2], 4, "Forwarded packet declared lost too early");
+  NS_TEST_EXPECT_MSG_EQ (m_lost[3], 5, "Forwarded packet not declared lost");
+  NS_TEST_EXPECT_MSG_EQ (m_lost[4], 7, "Unexpected number of lost packets");
+
+  const FlowMonitor::FlowStats &stats = m_monitor->GetFlowStats ().find (1)->second;
+  NS_TEST_EXPECT_MSG_EQ (stats.txPackets, 12, "Unexpected number of transmitted packets");
+  NS_TEST_EXPECT_MSG_EQ (stats.rxPackets, 5, "Unexpected number of received packets");
+
+  m_probe = 0;
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check that the delays, which are added to the histograms by
+ * batches, are all in the delay histogram returned by GetFlowStats.
+ */
+class FlowMonitorDelayHistogramTestCase : public TestCase
+{
+public:
+  FlowMonitorDelayHistogramTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the first transmission of packets
+   * \param n the number of packets
+   */
+  void Transmit (uint32_t n);
+  /**
+   * Report the reception of a packet
+   * \param packetId the packet id
+   */
+  void Receive (uint32_t packetId);
+
+  Ptr<FlowMonitor> m_monitor;       //!< The monitor
+  Ptr<FlowProbe> m_probe;           //!< The probe
+};
+
+FlowMonitorDelayHistogramTestCase::FlowMonitorDelayHistogramTestCase ()
+  : TestCase ("Check FlowMonitor delay histogram")
+{
+}
+
+void
+FlowMonitorDelayHistogramTestCase::Transmit (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      m_monitor->ReportFirstTx (m_probe, 1, i, 100);
+    }
+}
+
+void
+FlowMonitorDelayHistogramTestCase::Receive (uint32_t packetId)
+{
+  m_monitor->ReportLastRx (m_probe, 1, packetId, 100);
+}
+
+void
+FlowMonitorDelayHistogramTestCase::DoRun (void)
+{
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1000)),
+                                                       "DelayBinWidth", DoubleValue (0.001));
+  m_probe = CreateObject<FlowMonitorTestProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  // 150 packets, which is not a multiple of the batch size, received
+  // with a delay of 0.5 to 9.5 ms, 15 packets in each 1 ms bin
+  uint32_t n = 150;
+  Simulator::Schedule (Seconds (1), &FlowMonitorDelayHistogramTestCase::Transmit, this, n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Simulator::Schedule (Seconds (1) + MicroSeconds (500 + 1000 * (i % 10)),
+                           &FlowMonitorDelayHistogramTestCase::Receive, this, i);
+    }
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+
+  const FlowMonitor::FlowStats &stats = m_monitor->GetFlowStats ().find (1)->second;
+  NS_TEST_EXPECT_MSG_EQ (stats.rxPackets, n, "Unexpected number of received packets");
+  Histogram delays = stats.delayHistogram;
+  NS_TEST_ASSERT_MSG_EQ (delays.GetNBins (), 10, "Unexpected number of delay bins");
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (delays.GetBinCount (i), 15, "Unexpected count of delay bin " << i);
+    }
+
+  m_probe = 0;
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check the periodic export of the flow statistics.
+ */
+class FlowMonitorPeriodicExportTestCase : public TestCase
+{
+public:
+  FlowMonitorPeriodicExportTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the first transmission of packets
+   * \param flowId the flow id
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Transmit (uint32_t flowId, uint32_t first, uint32_t last);
+  /**
+   * Report the reception of packets
+   * \param flowId the flow id
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Receive (uint32_t flowId, uint32_t first, uint32_t last);
+
+  Ptr<FlowMonitor> m_monitor;       //!< The monitor
+  Ptr<FlowProbe> m_probe;           //!< The probe
+};
+
+FlowMonitorPeriodicExportTestCase::FlowMonitorPeriodicExportTestCase ()
+  : TestCase ("Check FlowMonitor periodic export")
+{
+}
+
+void
+FlowMonitorPeriodicExportTestCase::Transmit (uint32_t flowId, uint32_t first, uint32_t last)
+{
+  for (uint32_t i = first; i <= last; ++i)
+    {
+      m_monitor->ReportFirstTx (m_probe, flowId, i, 100);
+    }
+}
+
+void
+FlowMonitorPeriodicExportTestCase::Receive (uint32_t flowId, uint32_t first, uint32_t last)
+{
+  for (uint32_t i = first; i <= last; ++i)
+    {
+      m_monitor->ReportLastRx (m_probe, flowId, i, 100);
+    }
+}
+
+void
+FlowMonitorPeriodicExportTestCase::DoRun (void)
+{
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1000)),
+                                                       "EnableHistograms", BooleanValue (false));
+  m_probe = CreateObject<FlowMonitorTestProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  std::ostringstream oss;
+  m_monitor->EnablePeriodicExport (Create<OutputStreamWrapper> (&oss), Seconds (1));
+
+  Simulator::Schedule (Seconds (0.5), &FlowMonitorPeriodicExportTestCase::Transmit, this, 1, 0, 9);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitorPeriodicExportTestCase::Receive, this, 1, 0, 4);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitorPeriodicExportTestCase::Transmit, this, 2, 0, 0);
+  Simulator::Schedule (Seconds (3.5), &FlowMonitorPeriodicExportTestCase::Receive, this, 2, 0, 0);
+  Simulator::Schedule (Seconds (3.7), &FlowMonitor::DisablePeriodicExport, m_monitor);
+  Simulator::Stop (Seconds (6));
+  Simulator::Run ();
+
+  std::istringstream iss (oss.str ());
+  std::string line;
+  std::getline (iss, line);
+  NS_TEST_EXPECT_MSG_EQ (line.substr (0, 7), "# time ", "Missing header");
+
+  // time flowId txPackets txBytes rxPackets rxBytes delaySum jitterSum lost droppedPackets droppedBytes
+  const double expected[][11] = {
+    { 1, 1, 10, 1000, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 1, 0, 0, 5, 500, 5, 0, 0, 0, 0 },
+    { 2, 2, 1, 100, 0, 0, 0, 0, 0, 0, 0 },
+    { 3.7, 2, 0, 0, 1, 100, 2, 0, 0, 0, 0 },
+  };
+  uint32_t lines = 0;
+  while (std::getline (iss, line))
+    {
+      NS_TEST_ASSERT_MSG_LT (lines, 4, "Unexpected line " << line);
+      std::istringstream fields (line);
+      for (uint32_t i = 0; i < 11; ++i)
+        {
+          double value = -1;
+          fields >> value;
+          NS_TEST_EXPECT_MSG_EQ_TOL (value, expected[lines][i], 1e-9, "Unexpected field " << i << " in line " << line);
+        }
+      lines++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (lines, 4, "Unexpected number of lines");
+
+  const FlowMonitor::FlowStats &stats = m_monitor->GetFlowStats ().find (1)->second;
+  NS_TEST_EXPECT_MSG_EQ (stats.delayHistogram.GetNBins (), 0, "Histograms should be disabled");
+
+  m_probe = 0;
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check the flow and packet sampling modes and the estimation
+ * of the aggregate statistics.
+ */
+class FlowMonitorSamplingTestCase : public TestCase
+{
+public:
+  FlowMonitorSamplingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorSamplingTestCase::FlowMonitorSamplingTestCase ()
+  : TestCase ("Check FlowMonitor sampling")
+{
+}
+
+void
+FlowMonitorSamplingTestCase::DoRun (void)
+{
+  const uint32_t n = 10000;
+
+  Ptr<FlowMonitor> monitor = CreateObjectWithAttributes<FlowMonitor> ("SamplingMode", EnumValue (FlowMonitor::SAMPLE_FLOWS),
+                                                                      "SamplingRate", UintegerValue (4));
+  NS_TEST_EXPECT_MSG_EQ (monitor->GetSamplingRate (), 4, "Unexpected sampling rate");
+  uint32_t sampled = 0;
+  for (FlowId flowId = 1; flowId <= n; ++flowId)
+    {
+      bool first = monitor->IsSampled (flowId);
+      NS_TEST_EXPECT_MSG_EQ (monitor->IsSampled (flowId), first, "Flow " << flowId << " partially sampled");
+      sampled += first;
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sampled, n / 4, n / 40, "Unexpected number of sampled flows");
+  monitor->Dispose ();
+
+  monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1000)),
+                                                     "SamplingMode", EnumValue (FlowMonitor::SAMPLE_PACKETS),
+                                                     "SamplingRate", UintegerValue (10));
+  monitor->AssignStreams (1);
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  sampled = 0;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      if (monitor->IsSampled (1))
+        {
+          monitor->ReportFirstTx (probe, 1, i, 100);
+          monitor->ReportLastRx (probe, 1, i, 100);
+          sampled++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sampled, n / 10, n / 100, "Unexpected number of sampled packets");
+
+  FlowMonitor::AggregateStats aggregate = monitor->EstimateAggregateStats ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (aggregate.txPackets, 10.0 * sampled, 1e-9, "Unexpected estimated txPackets");
+  NS_TEST_EXPECT_MSG_EQ_TOL (aggregate.rxBytes, 1000.0 * sampled, 1e-9, "Unexpected estimated rxBytes");
+  NS_TEST_EXPECT_MSG_EQ_TOL (aggregate.txPackets, n, n / 10, "Estimated txPackets too far from the total");
+  NS_TEST_EXPECT_MSG_EQ (aggregate.meanDelay, Seconds (0), "Unexpected mean delay");
+
+  probe = 0;
+  monitor->Dispose ();
+
+  // The same stream, assigned through the helper, gives the same decisions
+  std::vector<bool> decisions;
+  for (uint32_t run = 0; run < 2; ++run)
+    {
+      FlowMonitorHelper helper;
+      helper.SetMonitorAttribute ("SamplingMode", EnumValue (FlowMonitor::SAMPLE_PACKETS));
+      helper.SetMonitorAttribute ("SamplingRate", UintegerValue (10));
+      NS_TEST_EXPECT_MSG_EQ (helper.AssignStreams (5), 1, "Unexpected number of streams");
+      monitor = helper.GetMonitor ();
+      for (uint32_t i = 0; i < 1000; ++i)
+        {
+          if (run == 0)
+            {
+              decisions.push_back (monitor->IsSampled (1));
+            }
+          else
+            {
+              NS_TEST_EXPECT_MSG_EQ (monitor->IsSampled (1), decisions[i], "Packet " << i << " sampled differently");
+            }
+        }
+      monitor->Dispose ();
+    }
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowMonitorLostPacketsTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorDelayHistogramTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorPeriodicExportTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorSamplingTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
@@ -80,6 +80,78 @@ HistogramTestCase::DoRun (void)
   }
 }
 
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor Histogram batched and log-scaled bins Test
+ */
+class HistogramBatchTestCase : public ns3::TestCase {
+public:
+  HistogramBatchTestCase ();
+  virtual void DoRun (void);
+};
+
+HistogramBatchTestCase::HistogramBatchTestCase ()
+  : ns3::TestCase ("Histogram batched and log-scaled bins")
+{
+}
+
+void
+HistogramBatchTestCase::DoRun (void)
+{
+  // Log-scaled bins: 8 bins of 1 ms, then 4 bins per power of two
+  Histogram h0;
+  h0.SetLogScaledBins (0.001, 8);
+  h0.AddValue (0.0055);
+  h0.AddValue (0.0105);
+  h0.AddValue (1.0);
+  NS_TEST_EXPECT_MSG_EQ (h0.GetNBins (), 36, "");
+  NS_TEST_EXPECT_MSG_EQ (h0.GetBinCount (5), 1, "");
+  NS_TEST_EXPECT_MSG_EQ (h0.GetBinCount (9), 1, "");
+  NS_TEST_EXPECT_MSG_EQ (h0.GetBinCount (35), 1, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinStart (5), 0.005, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinWidth (5), 0.001, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinStart (8), 0.008, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinStart (9), 0.010, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinWidth (9), 0.002, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinStart (35), 0.896, 1e-12, "");
+  NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinEnd (35), 1.024, 1e-12, "");
+  // The bins are contiguous
+  for (uint32_t i = 1; i < h0.GetNBins (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (h0.GetBinStart (i), h0.GetBinEnd (i - 1), 1e-12, "Bin " << i);
+    }
+
+  // Batches give the same bins as single values
+  std::vector<double> values;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      values.push_back ((i * 7919 % 1000) * 0.0137);
+    }
+  for (uint32_t logScaled = 0; logScaled < 2; logScaled++)
+    {
+      Histogram single (0.01);
+      Histogram batch (0.01);
+      if (logScaled)
+        {
+          single.SetLogScaledBins (0.01, 16);
+          batch.SetLogScaledBins (0.01, 16);
+        }
+      for (uint32_t i = 0; i < values.size (); i++)
+        {
+          single.AddValue (values[i]);
+        }
+      batch.AddValues (&values[0], 500);
+      batch.AddValues (&values[500], 500);
+      NS_TEST_ASSERT_MSG_EQ (batch.GetNBins (), single.GetNBins (), "");
+      for (uint32_t i = 0; i < single.GetNBins (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (batch.GetBinCount (i), single.GetBinCount (i), "Bin " << i);
+        }
+    }
+}
+
 /**
  * \ingroup flow-monitor-test
  * \ingroup tests
@@ -96,6 +168,7 @@ HistogramTestSuite::HistogramTestSuite ()
   : TestSuite ("histogram", UNIT)
 {
   AddTestCase (new HistogramTestCase, TestCase::QUICK);
+  AddTestCase (new HistogramBatchTestCase, TestCase::QUICK);
 }
 
 static HistogramTestSuite g_HistogramTestSuite; //!< Static variable for test initialization
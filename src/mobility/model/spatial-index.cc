@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "spatial-index.h"
+#include "mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatialIndex");
+
+NS_OBJECT_ENSURE_REGISTERED (SpatialIndex);
+
+TypeId
+SpatialIndex::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SpatialIndex")
+    .SetParent<Object> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<SpatialIndex> ()
+    .AddAttribute ("CellSize",
+                   "The side of the square cells of the grid, in meters.",
+                   DoubleValue (250.0),
+                   MakeDoubleAccessor (&SpatialIndex::SetCellSize,
+                                       &SpatialIndex::GetCellSize),
+                   MakeDoubleChecker<double> (1e-3))
+  ;
+  return tid;
+}
+
+SpatialIndex::SpatialIndex ()
+  : m_cellSize (250.0),
+    m_maxSpeed (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SpatialIndex::~SpatialIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+SpatialIndex::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+  Object::DoDispose ();
+}
+
+void
+SpatialIndex::Clear (void)
+{
+  for (std::map<const MobilityModel *, std::vector<uint32_t> >::const_iterator i = m_byMobility.begin ();
+       i != m_byMobility.end (); ++i)
+    {
+      m_items[i->second.front ()].mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                                          MakeCallback (&SpatialIndex::CourseChanged, this));
+    }
+  m_byMobility.clear ();
+  m_cells.clear ();
+  m_items.clear ();
+}
+
+void
+SpatialIndex::SetCellSize (double cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  m_cellSize = cellSize;
+  Refresh ();
+}
+
+double
+SpatialIndex::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+uint32_t
+SpatialIndex::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  NS_ASSERT (mobility != 0);
+  uint32_t index = m_items.size ();
+  Item item;
+  item.mobility = mobility;
+  m_items.push_back (item);
+  File (index);
+  std::vector<uint32_t> &indexes = m_byMobility[PeekPointer (mobility)];
+  if (indexes.empty ())
+    {
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&SpatialIndex::CourseChanged, this));
+    }
+  indexes.push_back (index);
+  return index;
+}
+
+uint32_t
+SpatialIndex::GetN (void) const
+{
+  return m_items.size ();
+}
+
+void
+SpatialIndex::GetCandidates (const Vector &position, double range, std::vector<uint32_t> &candidates)
+{
+  NS_LOG_FUNCTION (this << position << range);
+  double margin = m_maxSpeed * (Simulator::Now () - m_lastRefresh).GetSeconds ();
+  if (margin > m_cellSize / 2)
+    {
+      Refresh ();
+      margin = 0;
+    }
+  range += margin;
+
+  candidates.clear ();
+  double width = 2 * range / m_cellSize + 2;
+  if (width * width >= m_cells.size ())
+    {
+      // Fewer non-empty cells than cells in range
+      for (std::map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.begin (); i != m_cells.end (); ++i)
+        {
+          for (std::vector<uint32_t>::const_iterator j = i->second.begin (); j != i->second.end (); ++j)
+            {
+              if (CalculateDistance (m_items[*j].position, position) <= range)
+                {
+                  candidates.push_back (*j);
+                }
+            }
+        }
+    }
+  else
+    {
+      int64_t xMin = static_cast<int64_t> (std::floor ((position.x - range) / m_cellSize));
+      int64_t xMax = static_cast<int64_t> (std::floor ((position.x + range) / m_cellSize));
+      int64_t yMin = static_cast<int64_t> (std::floor ((position.y - range) / m_cellSize));
+      int64_t yMax = static_cast<int64_t> (std::floor ((position.y + range) / m_cellSize));
+      for (int64_t x = xMin; x <= xMax; ++x)
+        {
+          for (int64_t y = yMin; y <= yMax; ++y)
+            {
+              std::map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.find (GetCell (x, y));
+              if (i == m_cells.end ())
+                {
+                  continue;
+                }
+              for (std::vector<uint32_t>::const_iterator j = i->second.begin (); j != i->second.end (); ++j)
+                {
+                  if (CalculateDistance (m_items[*j].position, position) <= range)
+                    {
+                      candidates.push_back (*j);
+                    }
+                }
+            }
+        }
+    }
+  std::sort (candidates.begin (), candidates.end ());
+  NS_LOG_DEBUG (candidates.size () << " candidates out of " << m_items.size ());
+}
+
+uint64_t
+SpatialIndex::GetCell (const Vector &position) const
+{
+  return GetCell (static_cast<int64_t> (std::floor (position.x / m_cellSize)),
+                  static_cast<int64_t> (std::floor (position.y / m_cellSize)));
+}
+
+uint64_t
+SpatialIndex::GetCell (int64_t x, int64_t y)
+{
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+void
+SpatialIndex::File (uint32_t index)
+{
+  Item &item = m_items[index];
+  item.position = item.mobility->GetPosition ();
+  item.cell = GetCell (item.position);
+  m_cells[item.cell].push_back (index);
+  Vector velocity = item.mobility->GetVelocity ();
+  double speed = std::sqrt (velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+  m_maxSpeed = std::max (m_maxSpeed, speed);
+}
+
+void
+SpatialIndex::Unfile (uint32_t index)
+{
+  std::map<uint64_t, std::vector<uint32_t> >::iterator i = m_cells.find (m_items[index].cell);
+  NS_ASSERT (i != m_cells.end ());
+  std::vector<uint32_t>::iterator j = std::find (i->second.begin (), i->second.end (), index);
+  NS_ASSERT (j != i->second.end ());
+  *j = i->second.back ();
+  i->second.pop_back ();
+  if (i->second.empty ())
+    {
+      m_cells.erase (i);
+    }
+}
+
+void
+SpatialIndex::Refresh (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cells.clear ();
+  m_maxSpeed = 0;
+  for (uint32_t i = 0; i < m_items.size (); ++i)
+    {
+      File (i);
+    }
+  m_lastRefresh = Simulator::Now ();
+}
+
+void
+SpatialIndex::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::map<const MobilityModel *, std::vector<uint32_t> >::const_iterator i = m_byMobility.find (PeekPointer (mobility));
+  NS_ASSERT (i != m_byMobility.end ());
+  for (std::vector<uint32_t>::const_iterator j = i->second.begin (); j != i->second.end (); ++j)
+    {
+      Unfile (*j);
+      File (*j);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/spatial-index.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check the candidates of the SpatialIndex against the
+ * distances between the mobility models.
+ */
+class SpatialIndexTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param moving true to move the mobility models
+   */
+  SpatialIndexTestCase (bool moving);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Query the index around some positions, and check the candidates.
+   */
+  void Check (void);
+  /**
+   * Turn the mobility models around.
+   */
+  void Turn (void);
+
+  bool m_moving;                                    ///< true to move the mobility models
+  Ptr<SpatialIndex> m_index;                        ///< the index under test
+  std::vector<Ptr<MobilityModel> > m_mobilities;    ///< the mobility models, by index
+};
+
+SpatialIndexTestCase::SpatialIndexTestCase (bool moving)
+  : TestCase (moving ? "Check the SpatialIndex candidates of moving models"
+              : "Check the SpatialIndex candidates of static models"),
+    m_moving (moving)
+{
+}
+
+void
+SpatialIndexTestCase::Check (void)
+{
+  double ranges[] = { 10, 100, 450, 5000 };
+  for (uint32_t q = 0; q < m_mobilities.size (); q += 7)
+    {
+      Vector position = m_mobilities[q]->GetPosition ();
+      for (uint32_t r = 0; r < sizeof (ranges) / sizeof (ranges[0]); ++r)
+        {
+          std::vector<uint32_t> candidates;
+          m_index->GetCandidates (position, ranges[r], candidates);
+          NS_TEST_ASSERT_MSG_EQ (std::is_sorted (candidates.begin (), candidates.end ()), true, "Candidates not sorted");
+          uint32_t inRange = 0;
+          for (uint32_t i = 0; i < m_mobilities.size (); ++i)
+            {
+              if (CalculateDistance (m_mobilities[i]->GetPosition (), position) <= ranges[r])
+                {
+                  ++inRange;
+                  NS_TEST_ASSERT_MSG_EQ (std::binary_search (candidates.begin (), candidates.end (), i), true,
+                                         "Item " << i << " within " << ranges[r] << "m is not a candidate at " << Simulator::Now ().GetSeconds ());
+                }
+            }
+          if (!m_moving)
+            {
+              NS_TEST_ASSERT_MSG_EQ (candidates.size (), inRange, "Too many candidates of static models");
+            }
+        }
+    }
+}
+
+void
+SpatialIndexTestCase::Turn (void)
+{
+  for (uint32_t i = 0; i < m_mobilities.size (); ++i)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = DynamicCast<ConstantVelocityMobilityModel> (m_mobilities[i]);
+      Vector velocity = mobility->GetVelocity ();
+      mobility->SetVelocity (Vector (-velocity.y, velocity.x, 0));
+    }
+}
+
+void
+SpatialIndexTestCase::DoRun (void)
+{
+  m_index = CreateObject<SpatialIndex> ();
+  m_index->SetAttribute ("CellSize", DoubleValue (100));
+  for (uint32_t i = 0; i < 200; ++i)
+    {
+      Vector position ((i * 37) % 1000, (i * 91) % 1300, i % 3);
+      Ptr<MobilityModel> mobility;
+      if (m_moving)
+        {
+          Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+          moving->SetVelocity (Vector ((i % 11) - 5.0, (i % 7) * 2 - 6.0, 0));
+          mobility = moving;
+        }
+      else
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+        }
+      mobility->SetPosition (position);
+      m_mobilities.push_back (mobility);
+      NS_TEST_ASSERT_MSG_EQ (m_index->Add (mobility), i, "Unexpected index");
+    }
+  // Two items may share a mobility model
+  m_mobilities.push_back (m_mobilities[0]);
+  m_index->Add (m_mobilities[0]);
+
+  for (uint32_t t = 0; t < 60; t += 3)
+    {
+      Simulator::Schedule (Seconds (t), &SpatialIndexTestCase::Check, this);
+    }
+  if (m_moving)
+    {
+      Simulator::Schedule (Seconds (31.5), &SpatialIndexTestCase::Turn, this);
+    }
+  // A jump is a course change
+  Simulator::Schedule (Seconds (40.5), &MobilityModel::SetPosition, m_mobilities[3], Vector (5000, 5000, 0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_index->Dispose ();
+  m_index = 0;
+  m_mobilities.clear ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief SpatialIndex Test Suite
+ */
+class SpatialIndexTestSuite : public TestSuite
+{
+public:
+  SpatialIndexTestSuite ();
+};
+
+SpatialIndexTestSuite::SpatialIndexTestSuite ()
+  : TestSuite ("spatial-index", UNIT)
+{
+  AddTestCase (new SpatialIndexTestCase (false), TestCase::QUICK);
+  AddTestCase (new SpatialIndexTestCase (true), TestCase::QUICK);
+}
+
+static SpatialIndexTestSuite g_spatialIndexTestSuite; ///< the test suite
@@ -647,6 +647,12 @@ DistributedSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint32_t
+DistributedSimulatorImpl::GetPendingEventCount (void) const
+{
+  return static_cast<uint32_t> (m_unscheduledEvents);
+}
+
 uint64_t
 DistributedSimulatorImpl::GetEventCount (void) const
 {
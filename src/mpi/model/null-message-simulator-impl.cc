@@ -577,6 +577,12 @@ NullMessageSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint32_t
+NullMessageSimulatorImpl::GetPendingEventCount (void) const
+{
+  return static_cast<uint32_t> (m_unscheduledEvents);
+}
+
 uint64_t
 NullMessageSimulatorImpl::GetEventCount (void) const
 {
@@ -33,6 +33,8 @@
 #include <string>
 #include <iomanip>
 #include <map>
+#include <cmath>
+#include <cstring>
 
 // ns3 includes
 #include "ns3/animation-interface.h"
@@ -58,6 +60,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/energy-source-container.h"
+#include "ns3/async-block-writer.h"
 #include "animation-interface.h"
 
 namespace ns3 {
@@ -67,12 +70,47 @@ NS_LOG_COMPONENT_DEFINE ("AnimationInterface");
 // Globals
 
 static bool initialized = false; //!< Initialization flag
+/// Start of the trace files written in BINARY_FORMAT
+static const char g_binaryMagic[8] = { 'N', 'S', '3', 'A', 'N', 'I', 'M', 'B' };
+
+/// Writes the blocks of the trace file from the I/O thread
+class AnimationInterface::FileWriter : public AsyncBlockWriter
+{
+public:
+  /**
+   * Constructor
+   * \param f the trace file
+   * \param blockSize the size of the blocks
+   */
+  FileWriter (FILE *f, uint32_t blockSize)
+    : AsyncBlockWriter (blockSize),
+      m_f (f)
+  {
+  }
+  virtual ~FileWriter ()
+  {
+    Stop ();
+  }
+
+protected:
+  virtual bool WriteBlock (const uint8_t *data, uint32_t size)
+  {
+    return std::fwrite (data, 1, size, m_f) == size;
+  }
+
+private:
+  FILE *m_f; ///< the trace file
+};
 
 
 // Public methods
 
-AnimationInterface::AnimationInterface (const std::string fn)
+AnimationInterface::AnimationInterface (const std::string fn, OutputFormat format)
   : m_f (0),
+    m_format (format),
+    m_writer (0),
+    m_asyncBlockSize (0),
+    m_recordTime (0),
     m_routingF (0),
     m_mobilityPollInterval (Seconds (0.25)), 
     m_outputFileName (fn),
@@ -84,6 +122,7 @@ AnimationInterface::AnimationInterface (const std::string fn)
     m_stopTime (Seconds (3600 * 1000)),
     m_maxPktsPerFile (MAX_PKTS_PER_TRACE_FILE), 
     m_originalFileName (fn),
+    m_fileSequence (0),
     m_routingStopTime (Seconds (0)), 
     m_routingFileName (""),
     m_routingPollInterval (Seconds (5)), 
@@ -506,6 +545,13 @@ AnimationInterface::WriteN (const std::string& st, FILE * f)
     {
       m_writeCallback (st.c_str ());
     }
+  if (f == m_f && m_format == BINARY_FORMAT)
+    {
+      m_record.push_back ('X');
+      PutString (st);
+      WriteRecord ();
+      return st.length ();
+    }
   return WriteN (st.c_str (), st.length (), f);
 }
 
@@ -516,6 +562,11 @@ AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
     {
       return 0;
     }
+  if (f == m_f && m_writer)
+    {
+      m_writer->Write (data, count);
+      return count;
+    }
   // Write count bytes to h from data
   uint32_t    nLeft   = count;
   const char* p       = data;
@@ -1431,6 +1482,18 @@ AnimationInterface::GetTracePktCount ()
   return m_currentPktCount;
 }
 
+void
+AnimationInterface::EnableAsyncWrite (uint32_t blockSize)
+{
+  // Also used for the next trace files, see CheckMaxPktsPerTraceFile
+  m_asyncBlockSize = blockSize;
+  if (m_f && !m_writer)
+    {
+      std::fflush (m_f);
+      m_writer = new FileWriter (m_f, blockSize);
+    }
+}
+
 void 
 AnimationInterface::StopAnimation (bool onlyAnimation)
 {
@@ -1441,6 +1504,9 @@ AnimationInterface::StopAnimation (bool onlyAnimation)
     {
       // Terminate the anim element
       WriteXmlClose ("anim");
+      // Waits for the pending blocks
+      delete m_writer;
+      m_writer = 0;
       std::fclose (m_f);
       m_f = 0;
     }
@@ -1462,6 +1528,18 @@ AnimationInterface::StartAnimation (bool restart)
   m_currentPktCount = 0;
   m_started = true;
   SetOutputFile (m_outputFileName);
+  if (m_asyncBlockSize)
+    {
+      EnableAsyncWrite (m_asyncBlockSize);
+    }
+  if (m_format == BINARY_FORMAT)
+    {
+      // Each binary file is decoded on its own
+      m_record.clear ();
+      m_recordTime = 0;
+      m_recordPositions.clear ();
+      WriteN (g_binaryMagic, sizeof (g_binaryMagic), m_f);
+    }
   WriteXmlAnim ();
   WriteNodes ();
   WriteNodeColors ();
@@ -2104,6 +2182,12 @@ AnimationInterface::CheckMaxPktsPerTraceFile ()
     }
   NS_LOG_UNCOND ("Max Packets per trace file exceeded");
   StopAnimation (true);
+  std::ostringstream oss;
+  oss << m_originalFileName << "-" << ++m_fileSequence;
+  m_outputFileName = oss.str ();
+  StartAnimation (true);
+  // The packet being traced goes to the new file
+  m_currentPktCount = 1;
 }
 
 std::string 
@@ -2536,44 +2620,67 @@ AnimationInterface::WriteXmlRp (uint32_t nodeId, std::string destination, Ipv4Ro
 void 
 AnimationInterface::WriteXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
 {
-  AnimXmlElement element ("pr");
-  element.AddAttribute ("uId", animUid);
-  element.AddAttribute ("fId", fId);
-  element.AddAttribute ("fbTx", fbTx);
-  if (!metaInfo.empty ())
+  if (m_format == BINARY_FORMAT && m_f)
     {
-      element.AddAttribute ("meta-info", metaInfo.c_str (), true);
+      if (m_writeCallback)
+        {
+          m_writeCallback (GetXmlPRef (animUid, fId, fbTx, metaInfo).c_str ());
+        }
+      StartRecord ('R');
+      PutVarint (animUid);
+      PutVarint (fId);
+      PutTime (fbTx);
+      PutString (metaInfo);
+      WriteRecord ();
+      return;
     }
-  WriteN (element.ToString (),  m_f);
+  WriteN (GetXmlPRef (animUid, fId, fbTx, metaInfo), m_f);
 }
 
 void 
 AnimationInterface::WriteXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx)
 {
-  AnimXmlElement element (pktType);
-  element.AddAttribute ("uId", animUid);
-  element.AddAttribute ("tId", tId);
-  element.AddAttribute ("fbRx", fbRx);
-  element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  if (m_format == BINARY_FORMAT && m_f)
+    {
+      if (m_writeCallback)
+        {
+          m_writeCallback (GetXmlP (animUid, pktType, tId, fbRx, lbRx).c_str ());
+        }
+      StartRecord ('W');
+      PutString (pktType);
+      PutVarint (animUid);
+      PutVarint (tId);
+      PutTime (fbRx);
+      PutTime (lbRx);
+      WriteRecord ();
+      return;
+    }
+  WriteN (GetXmlP (animUid, pktType, tId, fbRx, lbRx), m_f);
 }
 
 void 
 AnimationInterface::WriteXmlP (std::string pktType, uint32_t fId, double fbTx, double lbTx, 
                                                    uint32_t tId, double fbRx, double lbRx, std::string metaInfo)
 {
-  AnimXmlElement element (pktType);
-  element.AddAttribute ("fId", fId);
-  element.AddAttribute ("fbTx", fbTx);
-  element.AddAttribute ("lbTx", lbTx);
-  if (!metaInfo.empty ())
+  if (m_format == BINARY_FORMAT && m_f)
     {
-      element.AddAttribute ("meta-info", metaInfo.c_str (), true);
+      if (m_writeCallback)
+        {
+          m_writeCallback (GetXmlP (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo).c_str ());
+        }
+      StartRecord ('P');
+      PutString (pktType);
+      PutVarint (fId);
+      PutTime (fbTx);
+      PutTime (lbTx);
+      PutVarint (tId);
+      PutTime (fbRx);
+      PutTime (lbRx);
+      PutString (metaInfo);
+      WriteRecord ();
+      return;
     }
-  element.AddAttribute ("tId", tId);
-  element.AddAttribute ("fbRx", fbRx);
-  element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  WriteN (GetXmlP (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo), m_f);
 }
 
 void 
@@ -2621,13 +2728,25 @@ AnimationInterface::WriteXmlUpdateNodeSize (uint32_t nodeId, double width, doubl
 void 
 AnimationInterface::WriteXmlUpdateNodePosition (uint32_t nodeId, double x, double y)
 {
-  AnimXmlElement element ("nu");
-  element.AddAttribute ("p", "p");
-  element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
-  element.AddAttribute ("id", nodeId);
-  element.AddAttribute ("x", x);
-  element.AddAttribute ("y", y);
-  WriteN (element.ToString (), m_f);
+  if (m_format == BINARY_FORMAT && m_f)
+    {
+      if (m_writeCallback)
+        {
+          m_writeCallback (GetXmlUpdateNodePosition (Simulator::Now ().GetSeconds (), nodeId, x, y).c_str ());
+        }
+      // Millimeters, relative to the previous position of the node
+      int64_t mmX = std::llround (x * 1000);
+      int64_t mmY = std::llround (y * 1000);
+      std::pair<int64_t, int64_t> &last = m_recordPositions[nodeId];
+      StartRecord ('N');
+      PutVarint (nodeId);
+      PutSignedVarint (mmX - last.first);
+      PutSignedVarint (mmY - last.second);
+      WriteRecord ();
+      last = std::make_pair (mmX, mmY);
+      return;
+    }
+  WriteN (GetXmlUpdateNodePosition (Simulator::Now ().GetSeconds (), nodeId, x, y), m_f);
 }
 
 void 
@@ -2661,12 +2780,22 @@ AnimationInterface::WriteXmlUpdateNodeDescription (uint32_t nodeId)
 void 
 AnimationInterface::WriteXmlUpdateNodeCounter (uint32_t nodeCounterId, uint32_t nodeId, double counterValue)
 {
-  AnimXmlElement element ("nc");
-  element.AddAttribute ("c", nodeCounterId);
-  element.AddAttribute ("i", nodeId);
-  element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
-  element.AddAttribute ("v", counterValue);
-  WriteN (element.ToString (), m_f);
+  if (m_format == BINARY_FORMAT && m_f)
+    {
+      if (m_writeCallback)
+        {
+          m_writeCallback (GetXmlUpdateNodeCounter (Simulator::Now ().GetSeconds (), nodeCounterId, nodeId, counterValue).c_str ());
+        }
+      StartRecord ('C');
+      PutVarint (nodeCounterId);
+      PutVarint (nodeId);
+      uint8_t value[sizeof (counterValue)];
+      std::memcpy (value, &counterValue, sizeof (counterValue));
+      m_record.insert (m_record.end (), value, value + sizeof (value));
+      WriteRecord ();
+      return;
+    }
+  WriteN (GetXmlUpdateNodeCounter (Simulator::Now ().GetSeconds (), nodeCounterId, nodeId, counterValue), m_f);
 }
 
 void 
@@ -2694,6 +2823,282 @@ AnimationInterface::WriteXmlNonP2pLinkProperties (uint32_t id, std::string ipAdd
 
 
 
+/***** Binary format *****/
+
+void
+AnimationInterface::PutVarint (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_record.push_back (static_cast<uint8_t> (value | 0x80));
+      value >>= 7;
+    }
+  m_record.push_back (static_cast<uint8_t> (value));
+}
+
+void
+AnimationInterface::PutSignedVarint (int64_t value)
+{
+  PutVarint ((static_cast<uint64_t> (value) << 1) ^ static_cast<uint64_t> (value >> 63));
+}
+
+void
+AnimationInterface::PutString (const std::string &s)
+{
+  PutVarint (s.size ());
+  m_record.insert (m_record.end (), s.begin (), s.end ());
+}
+
+void
+AnimationInterface::PutTime (double t)
+{
+  PutSignedVarint (std::llround (t * 1e9) - m_recordTime);
+}
+
+void
+AnimationInterface::StartRecord (char type)
+{
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  if (now != m_recordTime)
+    {
+      m_record.push_back ('T');
+      PutVarint (now - m_recordTime);
+      m_recordTime = now;
+    }
+  m_record.push_back (type);
+}
+
+void
+AnimationInterface::WriteRecord ()
+{
+  WriteN ((const char *)&m_record[0], m_record.size (), m_f);
+  m_record.clear ();
+}
+
+/**
+ * Read a varint from a binary trace file
+ * \param is the trace file
+ * \returns the value
+ */
+static uint64_t
+ReadVarint (std::istream &is)
+{
+  uint64_t value = 0;
+  uint32_t shift = 0;
+  int c;
+  while ((c = is.get ()) != EOF && shift < 64)
+    {
+      value |= static_cast<uint64_t> (c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        {
+          return value;
+        }
+      shift += 7;
+    }
+  is.setstate (std::ios::failbit);
+  return 0;
+}
+
+/**
+ * Read a zigzag encoded varint from a binary trace file
+ * \param is the trace file
+ * \returns the value
+ */
+static int64_t
+ReadSignedVarint (std::istream &is)
+{
+  uint64_t value = ReadVarint (is);
+  return static_cast<int64_t> ((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * Read a string from a binary trace file
+ * \param is the trace file
+ * \returns the string
+ */
+static std::string
+ReadString (std::istream &is)
+{
+  uint64_t length = ReadVarint (is);
+  std::string s;
+  if (is.good () && length > 0)
+    {
+      s.resize (length);
+      is.read (&s[0], length);
+    }
+  return s;
+}
+
+/**
+ * Read a time from a binary trace file
+ * \param is the trace file
+ * \param now the current time of the trace file, in nanoseconds
+ * \returns the time, in seconds
+ */
+static double
+ReadTime (std::istream &is, int64_t now)
+{
+  return (now + ReadSignedVarint (is)) / 1e9;
+}
+
+bool
+AnimationInterface::ConvertBinaryTrace (std::string binaryFile, std::string xmlFile)
+{
+  NS_LOG_FUNCTION (binaryFile << xmlFile);
+  std::ifstream in (binaryFile.c_str (), std::ios::in | std::ios::binary);
+  char magic[sizeof (g_binaryMagic)];
+  in.read (magic, sizeof (magic));
+  if (!in.good () || std::memcmp (magic, g_binaryMagic, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+  std::ofstream out (xmlFile.c_str ());
+  if (!out.is_open ())
+    {
+      return false;
+    }
+
+  int64_t now = 0;
+  std::map<uint32_t, std::pair<int64_t, int64_t> > positions;
+  int type;
+  while ((type = in.get ()) != EOF)
+    {
+      switch (type)
+        {
+        case 'X':
+          out << ReadString (in);
+          break;
+        case 'T':
+          now += ReadVarint (in);
+          break;
+        case 'N':
+          {
+            uint32_t nodeId = ReadVarint (in);
+            std::pair<int64_t, int64_t> &position = positions[nodeId];
+            position.first += ReadSignedVarint (in);
+            position.second += ReadSignedVarint (in);
+            out << GetXmlUpdateNodePosition (now / 1e9, nodeId, position.first / 1000.0, position.second / 1000.0);
+          }
+          break;
+        case 'C':
+          {
+            uint32_t counterId = ReadVarint (in);
+            uint32_t nodeId = ReadVarint (in);
+            double value = 0;
+            in.read ((char *)&value, sizeof (value));
+            out << GetXmlUpdateNodeCounter (now / 1e9, counterId, nodeId, value);
+          }
+          break;
+        case 'R':
+          {
+            uint64_t animUid = ReadVarint (in);
+            uint32_t fId = ReadVarint (in);
+            double fbTx = ReadTime (in, now);
+            std::string metaInfo = ReadString (in);
+            out << GetXmlPRef (animUid, fId, fbTx, metaInfo);
+          }
+          break;
+        case 'W':
+          {
+            std::string pktType = ReadString (in);
+            uint64_t animUid = ReadVarint (in);
+            uint32_t tId = ReadVarint (in);
+            double fbRx = ReadTime (in, now);
+            double lbRx = ReadTime (in, now);
+            out << GetXmlP (animUid, pktType, tId, fbRx, lbRx);
+          }
+          break;
+        case 'P':
+          {
+            std::string pktType = ReadString (in);
+            uint32_t fId = ReadVarint (in);
+            double fbTx = ReadTime (in, now);
+            double lbTx = ReadTime (in, now);
+            uint32_t tId = ReadVarint (in);
+            double fbRx = ReadTime (in, now);
+            double lbRx = ReadTime (in, now);
+            std::string metaInfo = ReadString (in);
+            out << GetXmlP (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo);
+          }
+          break;
+        default:
+          return false;
+        }
+      if (!in.good ())
+        {
+          return false;
+        }
+    }
+  return out.good ();
+}
+
+std::string
+AnimationInterface::GetXmlUpdateNodePosition (double t, uint32_t nodeId, double x, double y)
+{
+  AnimXmlElement element ("nu");
+  element.AddAttribute ("p", "p");
+  element.AddAttribute ("t", t);
+  element.AddAttribute ("id", nodeId);
+  element.AddAttribute ("x", x);
+  element.AddAttribute ("y", y);
+  return element.ToString ();
+}
+
+std::string
+AnimationInterface::GetXmlUpdateNodeCounter (double t, uint32_t counterId, uint32_t nodeId, double value)
+{
+  AnimXmlElement element ("nc");
+  element.AddAttribute ("c", counterId);
+  element.AddAttribute ("i", nodeId);
+  element.AddAttribute ("t", t);
+  element.AddAttribute ("v", value);
+  return element.ToString ();
+}
+
+std::string
+AnimationInterface::GetXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
+{
+  AnimXmlElement element ("pr");
+  element.AddAttribute ("uId", animUid);
+  element.AddAttribute ("fId", fId);
+  element.AddAttribute ("fbTx", fbTx);
+  if (!metaInfo.empty ())
+    {
+      element.AddAttribute ("meta-info", metaInfo.c_str (), true);
+    }
+  return element.ToString ();
+}
+
+std::string
+AnimationInterface::GetXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx)
+{
+  AnimXmlElement element (pktType);
+  element.AddAttribute ("uId", animUid);
+  element.AddAttribute ("tId", tId);
+  element.AddAttribute ("fbRx", fbRx);
+  element.AddAttribute ("lbRx", lbRx);
+  return element.ToString ();
+}
+
+std::string
+AnimationInterface::GetXmlP (std::string pktType, uint32_t fId, double fbTx, double lbTx,
+                             uint32_t tId, double fbRx, double lbRx, std::string metaInfo)
+{
+  AnimXmlElement element (pktType);
+  element.AddAttribute ("fId", fId);
+  element.AddAttribute ("fbTx", fbTx);
+  element.AddAttribute ("lbTx", lbTx);
+  if (!metaInfo.empty ())
+    {
+      element.AddAttribute ("meta-info", metaInfo.c_str (), true);
+    }
+  element.AddAttribute ("tId", tId);
+  element.AddAttribute ("fbRx", fbRx);
+  element.AddAttribute ("lbRx", lbRx);
+  return element.ToString ();
+}
+
+
 /***** AnimXmlElement  *****/
 
 AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emptyElement) :
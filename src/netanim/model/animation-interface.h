@@ -73,12 +73,22 @@ class AnimationInterface
 {
 public:
 
+  /**
+   * Trace file formats
+   */
+  typedef enum
+    {
+      XML_FORMAT,   ///< XML, read by NetAnim
+      BINARY_FORMAT ///< Compact binary records, see ConvertBinaryTrace
+    } OutputFormat;
+
   /**
    * \brief Constructor
    * \param filename The Filename for the trace file used by the Animator
+   * \param format The format of the trace file
    *
    */
-  AnimationInterface (const std::string filename);
+  AnimationInterface (const std::string filename, OutputFormat format = XML_FORMAT);
 
   /**
    * Counter Types 
@@ -394,6 +404,47 @@ public:
    */
   uint64_t GetTracePktCount ();
 
+  /**
+   *
+   * \brief Write the animation trace file from a background thread
+   * \param blockSize The number of bytes accumulated in memory before
+   *        they are handed to the I/O thread
+   *
+   * The trace is serialized by the simulation thread into blocks, which
+   * are written by an I/O thread, so that the simulation does not wait
+   * for the disk.  The routing trace file is not affected.
+   *
+   * \returns none
+   */
+  void EnableAsyncWrite (uint32_t blockSize = 1 << 20);
+
+  /**
+   *
+   * \brief Convert a trace file written in BINARY_FORMAT to XML
+   * \param binaryFile The trace file written in BINARY_FORMAT
+   * \param xmlFile The XML trace file to write, which can be read by NetAnim
+   *
+   * The binary format is a sequence of records, each made of a one byte
+   * type followed by its fields, integers being LEB128 varints (zigzag
+   * encoded when signed):
+   * - 'X': an XML fragment, written as is (all the elements but the
+   *   ones below);
+   * - 'T': the increment of the current time, in nanoseconds;
+   * - 'N': a node position update: node id, and increments of the x and
+   *   y coordinates since the previous update of the node, in
+   *   millimeters;
+   * - 'C': a node counter update: counter id, node id, and the value as
+   *   a raw double;
+   * - 'R', 'W' and 'P': the packet elements, with the packet times as
+   *   nanosecond offsets from the current time.
+   *
+   * Positions are thus rounded to the millimeter; everything else is
+   * identical to the XML written by an AnimationInterface in XML_FORMAT.
+   *
+   * \returns true if the conversion succeeded
+   */
+  static bool ConvertBinaryTrace (std::string binaryFile, std::string xmlFile);
+
   /**
    *
    * \brief Setup a node counter
@@ -607,7 +658,16 @@ private:
 
   // ##### State #####
 
+  class FileWriter;
+
   FILE * m_f; ///< File handle for output (0 if none)
+  OutputFormat m_format; ///< format of m_f
+  FileWriter * m_writer; ///< asynchronous writer of m_f (0 if none)
+  uint32_t m_asyncBlockSize; ///< block size of the asynchronous writer (0 if disabled)
+  std::vector<uint8_t> m_record; ///< binary record being encoded
+  int64_t m_recordTime; ///< current time of the binary trace, in nanoseconds
+  /// last position written for each node in the binary trace, in millimeters
+  std::map<uint32_t, std::pair<int64_t, int64_t> > m_recordPositions;
   FILE * m_routingF; ///< File handle for routing table output (0 if None);
   Time m_mobilityPollInterval; ///< mobility poll interval
   std::string m_outputFileName; ///< output file name
@@ -619,6 +679,7 @@ private:
   Time m_stopTime; ///< stop time
   uint64_t m_maxPktsPerFile; ///< maximum pakets per file
   std::string m_originalFileName; ///< original file name
+  uint32_t m_fileSequence; ///< number of the current trace file, when several are created
   Time m_routingStopTime; ///< routing stop time
   std::string m_routingFileName; ///< routing file name
   Time m_routingPollInterval; ///< routing poll interval
@@ -768,6 +829,87 @@ private:
    * \returns the number of bytes written
    */
   int WriteN (const std::string& st, FILE * f);
+
+  /**
+   * Append a varint to the binary record
+   * \param value the value
+   */
+  void PutVarint (uint64_t value);
+  /**
+   * Append a zigzag encoded varint to the binary record
+   * \param value the value
+   */
+  void PutSignedVarint (int64_t value);
+  /**
+   * Append a string to the binary record
+   * \param s the string
+   */
+  void PutString (const std::string &s);
+  /**
+   * Append a time to the binary record, as an offset from the current time
+   * \param t the time, in seconds
+   */
+  void PutTime (double t);
+  /**
+   * Start a binary record, preceded by a time record if the simulation
+   * time changed since the previous one
+   * \param type the record type
+   */
+  void StartRecord (char type);
+  /// Write the binary record to the trace file
+  void WriteRecord ();
+
+  /**
+   * Get the XML of a node position update
+   * \param t the time, in seconds
+   * \param nodeId the node ID
+   * \param x the X position
+   * \param y the Y position
+   * \returns the XML element
+   */
+  static std::string GetXmlUpdateNodePosition (double t, uint32_t nodeId, double x, double y);
+  /**
+   * Get the XML of a node counter update
+   * \param t the time, in seconds
+   * \param counterId the counter ID
+   * \param nodeId the node ID
+   * \param value the node counter value
+   * \returns the XML element
+   */
+  static std::string GetXmlUpdateNodeCounter (double t, uint32_t counterId, uint32_t nodeId, double value);
+  /**
+   * Get the XML of a packet reference
+   * \param animUid the UID
+   * \param fId the FID
+   * \param fbTx the FB transmit
+   * \param metaInfo the meta info
+   * \returns the XML element
+   */
+  static std::string GetXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo);
+  /**
+   * Get the XML of a packet reception
+   * \param animUid the UID
+   * \param pktType the packet type
+   * \param tId the TID
+   * \param fbRx the FB receive
+   * \param lbRx the LB receive
+   * \returns the XML element
+   */
+  static std::string GetXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx);
+  /**
+   * Get the XML of a packet
+   * \param pktType the packet type
+   * \param fId the FID
+   * \param fbTx the FB transmit
+   * \param lbTx the LB transmit
+   * \param tId the TID
+   * \param fbRx the FB receive
+   * \param lbRx the LB receive
+   * \param metaInfo the meta info
+   * \returns the XML element
+   */
+  static std::string GetXmlP (std::string pktType, uint32_t fId, double fbTx, double lbTx,
+                              uint32_t tId, double fbRx, double lbRx, std::string metaInfo);
   /**
    * Get MAC address function
    * \param nd the device
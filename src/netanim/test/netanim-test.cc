@@ -18,6 +18,8 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include "unistd.h"
 
 #include "ns3/core-module.h"
@@ -29,6 +31,8 @@
 #include "ns3/point-to-point-layout-module.h"
 #include "ns3/basic-energy-source.h"
 #include "ns3/simple-device-energy-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/ipv4-address-generator.h"
 
 using namespace ns3;
 
@@ -253,6 +257,146 @@ AnimationRemainingEnergyTestCase::CheckLogic (void)
                             "Wrong remaining energy value was traced");
 }
 
+/**
+ * \ingroup netanim-test
+ * \ingroup tests
+ *
+ * \brief Animation Binary Trace Test Case: the same scenario traced in
+ * XML, with the asynchronous writer, and in the binary format must give
+ * the same XML once the binary trace is converted, including when the
+ * trace is split into several files.
+ */
+class AnimationBinaryTraceTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationBinaryTraceTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Run a scenario with a moving node and a point-to-point link.
+   * \param fileName the trace file name
+   * \param format the trace file format
+   * \param maxPktsPerFile the maximum number of packets per trace file,
+   *        0 to keep the default
+   */
+  void
+  RunScenario (std::string fileName, AnimationInterface::OutputFormat format, uint64_t maxPktsPerFile = 0);
+
+  /**
+   * \brief Read a file.
+   * \param fileName the file name
+   * \returns the content of the file
+   */
+  std::string
+  ReadFile (std::string fileName);
+};
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase () :
+  TestCase ("Verify the binary trace format")
+{
+}
+
+void
+AnimationBinaryTraceTestCase::RunScenario (std::string fileName, AnimationInterface::OutputFormat format,
+                                           uint64_t maxPktsPerFile)
+{
+  Ipv4AddressGenerator::Reset ();
+  NodeContainer nodes;
+  nodes.Create (2);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+  mobility->SetPosition (Vector (1, 10, 0));
+  mobility->SetVelocity (Vector (4, -2, 0));
+  nodes.Get (1)->AggregateObject (mobility);
+
+  PointToPointHelper pointToPoint;
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+  // The link properties include the MAC addresses
+  devices.Get (0)->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  devices.Get (1)->SetAddress (Mac48Address ("00:00:00:00:00:02"));
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  echoServer.Install (nodes.Get (1));
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (20));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (0.1)));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (1.0));
+
+  AnimationInterface anim (fileName, format);
+  anim.EnableAsyncWrite (64);
+  if (maxPktsPerFile)
+    {
+      anim.SetMaxPktsPerTraceFile (maxPktsPerFile);
+    }
+  uint32_t counterId = anim.AddNodeCounter ("counter", AnimationInterface::DOUBLE_COUNTER);
+  Simulator::Schedule (Seconds (1.5), &AnimationInterface::UpdateNodeCounter, &anim, counterId, 1, 0.1);
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+std::string
+AnimationBinaryTraceTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str (), std::ios::in | std::ios::binary);
+  std::ostringstream oss;
+  oss << file.rdbuf ();
+  return oss.str ();
+}
+
+void
+AnimationBinaryTraceTestCase::DoRun (void)
+{
+  std::string xmlFile = CreateTempDirFilename ("netanim-test.xml");
+  std::string binaryFile = CreateTempDirFilename ("netanim-test.bin");
+  std::string convertedFile = CreateTempDirFilename ("netanim-test-converted.xml");
+
+  RunScenario (xmlFile, AnimationInterface::XML_FORMAT);
+  RunScenario (binaryFile, AnimationInterface::BINARY_FORMAT);
+  NS_TEST_ASSERT_MSG_EQ (AnimationInterface::ConvertBinaryTrace (binaryFile, convertedFile), true,
+                         "Unable to convert the binary trace");
+
+  std::string xml = ReadFile (xmlFile);
+  NS_TEST_EXPECT_MSG_NE (xml.find ("<nu p=\"p\""), std::string::npos, "No position update in the trace");
+  NS_TEST_EXPECT_MSG_NE (xml.find ("<p fId="), std::string::npos, "No packet in the trace");
+  NS_TEST_EXPECT_MSG_NE (xml.find ("<nc "), std::string::npos, "No counter update in the trace");
+  NS_TEST_EXPECT_MSG_EQ (ReadFile (convertedFile), xml, "Converted binary trace differs from the XML trace");
+  NS_TEST_EXPECT_MSG_LT (ReadFile (binaryFile).size (), xml.size () / 2, "Binary trace not compact");
+  NS_TEST_EXPECT_MSG_EQ (AnimationInterface::ConvertBinaryTrace (xmlFile, convertedFile), false,
+                         "XML trace converted");
+
+  // Each file of a split trace is written asynchronously and decoded on its own
+  xmlFile = CreateTempDirFilename ("netanim-test-split.xml");
+  binaryFile = CreateTempDirFilename ("netanim-test-split.bin");
+  RunScenario (xmlFile, AnimationInterface::XML_FORMAT, 10);
+  RunScenario (binaryFile, AnimationInterface::BINARY_FORMAT, 10);
+  uint32_t files = 0;
+  for (std::string suffix = ""; std::ifstream ((xmlFile + suffix).c_str ()).good (); )
+    {
+      NS_TEST_ASSERT_MSG_EQ (AnimationInterface::ConvertBinaryTrace (binaryFile + suffix, convertedFile), true,
+                             "Unable to convert the binary trace file " << files);
+      xml = ReadFile (xmlFile + suffix);
+      NS_TEST_EXPECT_MSG_NE (xml.find ("</anim>"), std::string::npos, "Trace file " << files << " not terminated");
+      NS_TEST_EXPECT_MSG_EQ (ReadFile (convertedFile), xml, "Converted binary trace file " << files << " differs from the XML trace");
+      std::ostringstream oss;
+      oss << "-" << ++files;
+      suffix = oss.str ();
+    }
+  NS_TEST_EXPECT_MSG_GT (files, 2, "The trace has not been split");
+}
+
 /**
  * \ingroup netanim-test
  * \ingroup tests
@@ -267,5 +411,6 @@ public:
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
     AddTestCase (new AnimationRemainingEnergyTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationBinaryTraceTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite; ///< the test suite
@@ -208,6 +208,14 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   return StreamWrapper;
 }
 
+Ptr<OutputStreamWrapper>
+AsciiTraceHelper::CreateColumnarFileStream (std::string filename, uint32_t chunkRows)
+{
+  NS_LOG_FUNCTION (filename << chunkRows);
+  Ptr<ColumnarTraceFile> file = Create<ColumnarTraceFile> (filename, chunkRows);
+  return Create<OutputStreamWrapper> (file);
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -310,6 +318,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('+', "", p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -317,6 +331,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('+', context, p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -336,6 +356,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('d', "", p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -343,6 +369,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('d', context, p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -363,6 +395,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('-', "", p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -370,6 +408,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('-', context, p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -387,6 +431,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('r', "", p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -394,6 +444,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('r', context, p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
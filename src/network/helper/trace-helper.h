@@ -222,6 +222,24 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Create an output stream object which writes the traced events
+   * to a binary ColumnarTraceFile instead of text.
+   *
+   * The returned stream can be passed to the EnableAscii methods of the
+   * device helpers like any stream created by CreateFileStream.  The
+   * default trace sinks store the time, uid and size of each packet in
+   * typed columns, which is much cheaper than formatting the packet as
+   * text.  Use the print-columnar-trace program to read the file back.
+   *
+   * @param filename file name
+   * @param chunkRows number of rows buffered per trace source before they
+   *        are written to the file
+   * @returns a smart pointer to the output stream
+   */
+  Ptr<OutputStreamWrapper> CreateColumnarFileStream (std::string filename,
+                                                     uint32_t chunkRows = 4096);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
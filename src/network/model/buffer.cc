@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
@@ -173,6 +174,12 @@ Buffer::Allocate (uint32_t reqSize)
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
   data->m_size = reqSize;
   data->m_count = 1;
+  // Buffers held by the free list are accounted as well
+  if (MemoryAccounting::IsEnabled ())
+    {
+      static MemoryAccounting::Counter *counter = MemoryAccounting::GetCounter ("ns3::Buffer::Data");
+      MemoryAccounting::Allocate (counter, size);
+    }
   return data;
 }
 
@@ -181,6 +188,11 @@ Buffer::Deallocate (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  if (MemoryAccounting::IsEnabled ())
+    {
+      static MemoryAccounting::Counter *counter = MemoryAccounting::GetCounter ("ns3::Buffer::Data");
+      MemoryAccounting::Free (counter, data->m_size - 1 + sizeof (struct Buffer::Data));
+    }
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
   delete [] buf;
 }
@@ -19,6 +19,7 @@
  */
 #include "byte-tag-list.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 #include <vector>
 #include <cstring>
 #include <limits>
@@ -72,6 +73,30 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList ()
 }
 #endif /* USE_FREE_LIST */
 
+/**
+ * \ingroup packet
+ * Account for a ByteTagListData in use, if MemoryAccounting is enabled.
+ * \param data the data
+ * \param allocate true when the data is taken into use, false when released
+ */
+static void
+AccountByteTagListData (const struct ByteTagListData *data, bool allocate)
+{
+  if (MemoryAccounting::IsEnabled ())
+    {
+      static MemoryAccounting::Counter *counter = MemoryAccounting::GetCounter ("ns3::ByteTagListData");
+      std::size_t bytes = data->size + sizeof (struct ByteTagListData) - 4;
+      if (allocate)
+        {
+          MemoryAccounting::Allocate (counter, bytes);
+        }
+      else
+        {
+          MemoryAccounting::Free (counter, bytes);
+        }
+    }
+}
+
 ByteTagList::Iterator::Item::Item (TagBuffer buf_)
   : buf (buf_)
 {
@@ -354,6 +379,7 @@ ByteTagList::Allocate (uint32_t size)
         {
           data->count = 1;
           data->dirty = 0;
+          AccountByteTagListData (data, true);
           return data;
         }
       uint8_t *buffer = (uint8_t *)data;
@@ -364,6 +390,7 @@ ByteTagList::Allocate (uint32_t size)
   data->count = 1;
   data->size = size;
   data->dirty = 0;
+  AccountByteTagListData (data, true);
   return data;
 }
 
@@ -379,6 +406,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
+      AccountByteTagListData (data, false);
       if (g_freeList.size () > FREE_LIST_SIZE ||
           data->size < g_maxSize)
         {
@@ -403,6 +431,7 @@ ByteTagList::Allocate (uint32_t size)
   data->count = 1;
   data->size = size;
   data->dirty = 0;
+  AccountByteTagListData (data, true);
   return data;
 }
 
@@ -417,6 +446,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
+      AccountByteTagListData (data, false);
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
@@ -31,6 +31,7 @@
 #include "ns3/assert.h"
 #include "ns3/global-value.h"
 #include "ns3/boolean.h"
+#include "ns3/config.h"
 
 namespace ns3 {
 
@@ -136,6 +137,7 @@ Node::AddDevice (Ptr<NetDevice> device)
   Simulator::ScheduleWithContext (GetId (), Seconds (0.0), 
                                   &NetDevice::Initialize, device);
   NotifyDeviceAdded (device);
+  Config::InvalidateCompiledPaths ();
   return index;
 }
 Ptr<NetDevice>
@@ -162,6 +164,7 @@ Node::AddApplication (Ptr<Application> application)
   application->SetNode (this);
   Simulator::ScheduleWithContext (GetId (), Seconds (0.0), 
                                   &Application::Initialize, application);
+  Config::InvalidateCompiledPaths ();
   return index;
 }
 Ptr<Application> 
@@ -28,6 +28,7 @@
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 #include <cstring>
 
 namespace ns3 {
@@ -44,13 +45,30 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
   void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  // The matching frees are in FreeTagData
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
+  if (MemoryAccounting::IsEnabled ())
+    {
+      static MemoryAccounting::Counter *counter = MemoryAccounting::GetCounter ("ns3::PacketTagList::TagData");
+      MemoryAccounting::Allocate (counter, sizeof (TagData) + dataSize - 1);
+    }
   return tag;
 }
 
+void
+PacketTagList::FreeTagData (TagData *data)
+{
+  if (MemoryAccounting::IsEnabled ())
+    {
+      static MemoryAccounting::Counter *counter = MemoryAccounting::GetCounter ("ns3::PacketTagList::TagData");
+      MemoryAccounting::Free (counter, sizeof (TagData) + data->size - 1);
+    }
+  data->~TagData ();
+  std::free (data);
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -194,8 +212,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
@@ -228,6 +228,14 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+
+  /**
+   * Destruct and free a TagData struct allocated by CreateTagData.
+   *
+   * \param [in] data The TagData to free.
+   */
+  static
+  void FreeTagData (TagData *data);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -341,15 +349,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-          prev->~TagData ();
-          std::free (prev);
+          FreeTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      prev->~TagData ();
-      std::free (prev);
+      FreeTagData (prev);
     }
   m_next = 0;
 }
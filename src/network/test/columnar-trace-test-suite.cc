@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/columnar-trace-file.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Write a columnar trace file through the AsciiTraceHelper
+ * default sinks and read it back.
+ */
+class ColumnarTraceTestCase : public TestCase
+{
+public:
+  ColumnarTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ColumnarTraceTestCase::ColumnarTraceTestCase ()
+  : TestCase ("Check that columnar trace files can be written and read back")
+{
+}
+
+void
+ColumnarTraceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("columnar.tr");
+  const uint32_t nPackets = 100;
+
+  AsciiTraceHelper ascii;
+  Ptr<OutputStreamWrapper> stream = ascii.CreateColumnarFileStream (filename, 16);
+  NS_TEST_ASSERT_MSG_NE (stream->GetColumnarTraceFile (), 0, "No columnar file attached to the stream");
+
+  std::vector<uint64_t> uids;
+  for (uint32_t i = 0; i < nPackets; ++i)
+    {
+      Ptr<Packet> p = Create<Packet> (100 + i);
+      uids.push_back (p->GetUid ());
+      AsciiTraceHelper::DefaultEnqueueSinkWithContext (stream, "/NodeList/0", p);
+      if (i % 10 == 0)
+        {
+          AsciiTraceHelper::DefaultDropSinkWithContext (stream, "/NodeList/0", p);
+        }
+      AsciiTraceHelper::DefaultReceiveSinkWithoutContext (stream, p);
+    }
+  // Closes the file
+  stream = 0;
+
+  ColumnarTraceReader reader (filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.Fail (), false, "Unable to open " << filename);
+
+  uint32_t enqueued = 0;
+  uint32_t dropped = 0;
+  uint32_t received = 0;
+  ColumnarTraceReader::Chunk chunk;
+  while (reader.ReadChunk (chunk))
+    {
+      NS_TEST_ASSERT_MSG_EQ (chunk.time.size (), chunk.rows, "Missing time column");
+      NS_TEST_ASSERT_MSG_EQ (chunk.uid.size (), chunk.rows, "Missing uid column");
+      NS_TEST_ASSERT_MSG_EQ (chunk.size.size (), chunk.rows, "Missing size column");
+      if (chunk.event == '+')
+        {
+          NS_TEST_EXPECT_MSG_EQ (chunk.context, "/NodeList/0", "Unexpected context");
+          for (uint32_t i = 0; i < chunk.rows; ++i, ++enqueued)
+            {
+              NS_TEST_EXPECT_MSG_EQ (chunk.uid[i], uids[enqueued], "Unexpected uid");
+              NS_TEST_EXPECT_MSG_EQ (chunk.size[i], 100 + enqueued, "Unexpected size");
+              NS_TEST_EXPECT_MSG_EQ (chunk.time[i], 0, "Unexpected time");
+            }
+        }
+      else if (chunk.event == 'd')
+        {
+          dropped += chunk.rows;
+        }
+      else if (chunk.event == 'r')
+        {
+          NS_TEST_EXPECT_MSG_EQ (chunk.context, "", "Unexpected context");
+          received += chunk.rows;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (reader.Fail (), false, "Malformed file");
+  NS_TEST_EXPECT_MSG_EQ (enqueued, nPackets, "Unexpected number of enqueue events");
+  NS_TEST_EXPECT_MSG_EQ (dropped, nPackets / 10, "Unexpected number of drop events");
+  NS_TEST_EXPECT_MSG_EQ (received, nPackets, "Unexpected number of receive events");
+
+  // Read the size column only
+  ColumnarTraceReader sizes (filename);
+  uint32_t rows = 0;
+  while (sizes.ReadChunk (chunk, 1 << ColumnarTraceFile::SIZE))
+    {
+      NS_TEST_EXPECT_MSG_EQ (chunk.time.size (), 0, "Time column decoded");
+      NS_TEST_EXPECT_MSG_EQ (chunk.uid.size (), 0, "Uid column decoded");
+      NS_TEST_EXPECT_MSG_EQ (chunk.size.size (), chunk.rows, "Missing size column");
+      rows += chunk.rows;
+    }
+  NS_TEST_EXPECT_MSG_EQ (rows, 2 * nPackets + nPackets / 10, "Unexpected number of rows");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Columnar trace file TestSuite
+ */
+class ColumnarTraceTestSuite : public TestSuite
+{
+public:
+  ColumnarTraceTestSuite ();
+};
+
+ColumnarTraceTestSuite::ColumnarTraceTestSuite ()
+  : TestSuite ("columnar-trace", UNIT)
+{
+  AddTestCase (new ColumnarTraceTestCase, TestCase::QUICK);
+}
+
+static ColumnarTraceTestSuite g_columnarTraceTestSuite; //!< Static variable for test initialization
@@ -25,6 +25,10 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1144,6 +1148,84 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that records written asynchronously by
+ * PcapFileWrapper are all on disk, in order and truncated to the snaplen,
+ * after Simulator::Destroy.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+public:
+  AsyncWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase ()
+  : TestCase ("Check that PcapFileWrapper writes asynchronously")
+{
+}
+
+void
+AsyncWriteTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("async.pcap");
+  const uint32_t nRecords = 1000;
+  const uint32_t snapLen = 100;
+  const uint32_t packetSize = 200;
+
+  Ptr<PcapFileWrapper> wrapper = CreateObject<PcapFileWrapper> ();
+  wrapper->SetAttribute ("Asynchronous", BooleanValue (true));
+  // Small blocks, so that the ring between the threads fills up
+  wrapper->SetAttribute ("BlockSize", UintegerValue (1024));
+  wrapper->Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (wrapper->Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  wrapper->Init (1, snapLen);
+
+  uint8_t buffer[packetSize];
+  std::memset (buffer, 0xab, packetSize);
+  for (uint32_t i = 0; i < nRecords; ++i)
+    {
+      if (i % 2)
+        {
+          wrapper->Write (MicroSeconds (i), Create<Packet> (buffer, packetSize));
+        }
+      else
+        {
+          wrapper->Write (MicroSeconds (i), buffer, packetSize);
+        }
+    }
+  wrapper = 0;
+
+  // Pending records must be written by Simulator::Destroy
+  Simulator::Destroy ();
+
+  PcapFile f;
+  f.Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::in\") returns error");
+  NS_TEST_ASSERT_MSG_EQ (f.GetSnapLen (), snapLen, "Unexpected snaplen");
+
+  uint8_t data[packetSize];
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  for (uint32_t i = 0; i < nRecords; ++i)
+    {
+      f.Read (data, packetSize, tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Read of record " << i << " failed");
+      NS_TEST_EXPECT_MSG_EQ (tsSec, 0, "Unexpected seconds in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (tsUsec, i, "Unexpected microseconds in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (inclLen, snapLen, "Record " << i << " not truncated");
+      NS_TEST_EXPECT_MSG_EQ (origLen, packetSize, "Unexpected original length in record " << i);
+      NS_TEST_EXPECT_MSG_EQ (data[snapLen - 1], 0xab, "Unexpected data in record " << i);
+    }
+  f.Read (data, packetSize, tsSec, tsUsec, inclLen, origLen, readLen);
+  NS_TEST_EXPECT_MSG_EQ (f.Eof (), true, "Unexpected records at the end of the file");
+  f.Close ();
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1249,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new AsyncWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
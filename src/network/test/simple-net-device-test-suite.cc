@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test class for the burst mode of the SimpleNetDevice
+ *
+ * It sends a few packets back to back from one SimpleNetDevice to two
+ * others, with and without burst mode, and checks that they are received
+ * at the same times while burst mode uses fewer simulator events.
+ */
+class SimpleNetDeviceBurstTest : public TestCase
+{
+public:
+  SimpleNetDeviceBurstTest ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Send some packets back to back from the device specified
+   *
+   * \param device NetDevice to send from
+   */
+  void SendPackets (Ptr<SimpleNetDevice> device);
+
+  /**
+   * \brief Receive callback
+   *
+   * \param device the receiving NetDevice
+   * \param packet the received packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  /**
+   * \brief Run one simulation
+   *
+   * \param maxBurstPackets value of the MaxBurstPackets attribute
+   * \returns the number of simulator events executed
+   */
+  uint64_t RunOne (uint32_t maxBurstPackets);
+
+  uint32_t m_nPackets;  //!< Number of packets sent
+  std::vector<Time> m_rxTimes;  //!< Time each packet is received
+  std::vector<uint32_t> m_rxSizes;  //!< Size of each packet received
+};
+
+SimpleNetDeviceBurstTest::SimpleNetDeviceBurstTest ()
+  : TestCase ("SimpleNetDevice burst mode"),
+    m_nPackets (10)
+{
+}
+
+void
+SimpleNetDeviceBurstTest::SendPackets (Ptr<SimpleNetDevice> device)
+{
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100 + i);
+      device->Send (p, device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+SimpleNetDeviceBurstTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  NS_TEST_EXPECT_MSG_EQ (protocol, 0x800, "Unexpected protocol");
+  m_rxTimes.push_back (Simulator::Now ());
+  m_rxSizes.push_back (packet->GetSize ());
+  return true;
+}
+
+uint64_t
+SimpleNetDeviceBurstTest::RunOne (uint32_t maxBurstPackets)
+{
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MicroSeconds (10)));
+  std::vector<Ptr<SimpleNetDevice> > devices;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      device->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+      device->SetAttribute ("DataRate", DataRateValue (DataRate ("1Mbps")));
+      device->SetAttribute ("MaxBurstPackets", UintegerValue (maxBurstPackets));
+      device->SetChannel (channel);
+      node->AddDevice (device);
+      device->SetReceiveCallback (MakeCallback (&SimpleNetDeviceBurstTest::Receive, this));
+      devices.push_back (device);
+    }
+
+  m_rxTimes.clear ();
+  m_rxSizes.clear ();
+  Simulator::Schedule (Seconds (1.0), &SimpleNetDeviceBurstTest::SendPackets, this, devices[0]);
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes.size (), 2 * m_nPackets, "Not all the packets have been received");
+  return events;
+}
+
+void
+SimpleNetDeviceBurstTest::DoRun (void)
+{
+  uint64_t eventsNoBurst = RunOne (1);
+  std::vector<Time> rxTimes = m_rxTimes;
+  std::vector<uint32_t> rxSizes = m_rxSizes;
+  uint64_t eventsBurst = RunOne (m_nPackets);
+  NS_TEST_EXPECT_MSG_LT (eventsBurst, eventsNoBurst, "Burst mode should schedule fewer events");
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxTimes.size (), rxTimes.size (), "Unexpected number of packets received");
+  for (uint32_t i = 0; i < rxTimes.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_rxTimes[i], rxTimes[i], "Packet " << i << " received at a different time in burst mode");
+      NS_TEST_EXPECT_MSG_EQ (m_rxSizes[i], rxSizes[i], "Packet " << i << " received out of order in burst mode");
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SimpleNetDevice TestSuite
+ */
+class SimpleNetDeviceTestSuite : public TestSuite
+{
+public:
+  SimpleNetDeviceTestSuite ();
+};
+
+SimpleNetDeviceTestSuite::SimpleNetDeviceTestSuite ()
+  : TestSuite ("simple-net-device", UNIT)
+{
+  AddTestCase (new SimpleNetDeviceBurstTest, TestCase::QUICK);
+}
+
+static SimpleNetDeviceTestSuite g_simpleNetDeviceTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <cstring>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "async-block-writer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AsyncBlockWriter");
+
+AsyncBlockWriter::AsyncBlockWriter (uint32_t blockSize)
+  : m_blockSize (blockSize),
+    m_head (0),
+    m_tail (0),
+    m_stop (false),
+    m_failed (false),
+    m_stopped (false)
+{
+  NS_LOG_FUNCTION (this << blockSize);
+  m_block.reserve (m_blockSize);
+#ifdef HAVE_PTHREAD_H
+  m_thread = Create<SystemThread> (MakeCallback (&AsyncBlockWriter::Run, this));
+  m_thread->Start ();
+#endif /* HAVE_PTHREAD_H */
+}
+
+AsyncBlockWriter::~AsyncBlockWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_stopped, "AsyncBlockWriter destroyed before Stop");
+}
+
+uint8_t *
+AsyncBlockWriter::Reserve (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (!m_stopped);
+  if (!m_block.empty () && m_block.size () + size > m_blockSize)
+    {
+      Submit ();
+    }
+  std::size_t offset = m_block.size ();
+  m_block.resize (offset + size);
+  return &m_block[offset];
+}
+
+void
+AsyncBlockWriter::Write (const void *data, uint32_t size)
+{
+  if (size > 0)
+    {
+      std::memcpy (Reserve (size), data, size);
+    }
+}
+
+void
+AsyncBlockWriter::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_stopped)
+    {
+      return;
+    }
+  m_stopped = true;
+  Submit ();
+#ifdef HAVE_PTHREAD_H
+  m_stop.store (true, std::memory_order_release);
+  m_dataReady.SetCondition (true);
+  m_dataReady.Signal ();
+  m_thread->Join ();
+  m_thread = 0;
+#endif /* HAVE_PTHREAD_H */
+}
+
+bool
+AsyncBlockWriter::Fail (void) const
+{
+  return m_failed.load (std::memory_order_acquire);
+}
+
+void
+AsyncBlockWriter::DoWriteBlock (const std::vector<uint8_t> &block)
+{
+  // May run on the I/O thread: no logging here, the log sinks are not
+  // thread safe.
+  if (!WriteBlock (&block[0], static_cast<uint32_t> (block.size ())))
+    {
+      m_failed.store (true, std::memory_order_release);
+    }
+}
+
+void
+AsyncBlockWriter::Submit (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_block.empty ())
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  uint32_t head = m_head.load (std::memory_order_relaxed);
+  while (head - m_tail.load (std::memory_order_acquire) == RING_SIZE)
+    {
+      // Ring full: wait for the I/O thread to catch up.  The timeout
+      // covers a signal sent between the check and the wait.
+      m_spaceReady.SetCondition (false);
+      if (head - m_tail.load (std::memory_order_acquire) == RING_SIZE)
+        {
+          m_spaceReady.TimedWait (WAIT_NS);
+        }
+    }
+  // The slot holds an already written (and cleared) block, so the
+  // swap hands its storage back to the simulation thread for reuse.
+  m_ring[head % RING_SIZE].swap (m_block);
+  m_head.store (head + 1, std::memory_order_release);
+  m_dataReady.SetCondition (true);
+  m_dataReady.Signal ();
+#else /* HAVE_PTHREAD_H */
+  DoWriteBlock (m_block);
+#endif /* HAVE_PTHREAD_H */
+  m_block.clear ();
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+AsyncBlockWriter::Run (void)
+{
+  while (true)
+    {
+      // Read the stop flag before the head index: once m_stop is seen,
+      // the head index includes every block submitted before Stop.
+      bool stop = m_stop.load (std::memory_order_acquire);
+      uint32_t tail = m_tail.load (std::memory_order_relaxed);
+      if (tail != m_head.load (std::memory_order_acquire))
+        {
+          std::vector<uint8_t> &block = m_ring[tail % RING_SIZE];
+          DoWriteBlock (block);
+          block.clear ();
+          m_tail.store (tail + 1, std::memory_order_release);
+          m_spaceReady.SetCondition (true);
+          m_spaceReady.Signal ();
+          continue;
+        }
+      if (stop)
+        {
+          break;
+        }
+      m_dataReady.SetCondition (false);
+      if (m_tail.load (std::memory_order_relaxed) == m_head.load (std::memory_order_acquire)
+          && !m_stop.load (std::memory_order_acquire))
+        {
+          m_dataReady.TimedWait (WAIT_NS);
+        }
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+} // namespace ns3
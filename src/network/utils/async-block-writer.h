@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ASYNC_BLOCK_WRITER_H
+#define ASYNC_BLOCK_WRITER_H
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "ns3/core-config.h"
+#include "ns3/ptr.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-condition.h"
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Write blocks of octets to a file from a background thread.
+ *
+ * Records are serialized by the caller into a block of memory obtained
+ * with Reserve.  Full blocks are handed over through a single-producer,
+ * single-consumer ring to an I/O thread, which writes each block with
+ * one call to WriteBlock.  Producer and consumer only synchronize
+ * through the ring indices; the conditions are used to sleep when the
+ * ring is empty (I/O thread) or full (simulation thread).
+ *
+ * If ns-3 is built without threading support, blocks are written
+ * synchronously as they fill up.
+ *
+ * Subclasses implement WriteBlock, and must call Stop in their
+ * destructor, before the state used by WriteBlock is destroyed.
+ * WriteBlock runs on the I/O thread and must not log, since the
+ * logging functions are not thread safe.
+ */
+class AsyncBlockWriter
+{
+public:
+  /**
+   * Start the I/O thread.
+   *
+   * \param blockSize The number of octets to accumulate before a block
+   *        is handed to the I/O thread.
+   */
+  AsyncBlockWriter (uint32_t blockSize);
+  /** Destructor; the I/O thread must have been stopped. */
+  virtual ~AsyncBlockWriter ();
+
+  /**
+   * Get room for a record in the current block.
+   *
+   * \param size The number of octets to reserve.
+   * \returns A pointer to \p size octets, valid until the next call.
+   */
+  uint8_t * Reserve (uint32_t size);
+
+  /**
+   * Copy a record to the current block.
+   *
+   * \param data The record.
+   * \param size The number of octets of the record.
+   */
+  void Write (const void *data, uint32_t size);
+
+  /**
+   * Write all pending records and stop the I/O thread.
+   *
+   * The caller is blocked until every record reserved so far is
+   * written.  Calling this method more than once is harmless.
+   */
+  void Stop (void);
+
+  /**
+   * \returns \c true if writing a block failed.
+   */
+  bool Fail (void) const;
+
+protected:
+  /**
+   * Write a block to the file.  Called from the I/O thread.
+   *
+   * \param data The block to write.
+   * \param size The number of octets of the block.
+   * \returns \c false if the block could not be written.
+   */
+  virtual bool WriteBlock (const uint8_t *data, uint32_t size) = 0;
+
+private:
+  /** Hand the current block to the I/O thread. */
+  void Submit (void);
+  /**
+   * Write a block and record failures.
+   * \param block The block to write.
+   */
+  void DoWriteBlock (const std::vector<uint8_t> &block);
+#ifdef HAVE_PTHREAD_H
+  /** Main loop of the I/O thread. */
+  void Run (void);
+#endif /* HAVE_PTHREAD_H */
+
+  /** Number of blocks in the ring. */
+  enum { RING_SIZE = 8 };
+  /** Maximum time to sleep on a condition, in nanoseconds. */
+  static const uint64_t WAIT_NS = 1000000;
+
+  uint32_t m_blockSize;                 //!< Target size of a block
+  std::vector<uint8_t> m_block;         //!< Block being filled by the simulation thread
+  std::vector<uint8_t> m_ring[RING_SIZE]; //!< Blocks waiting to be written
+  std::atomic<uint32_t> m_head;         //!< Number of blocks submitted
+  std::atomic<uint32_t> m_tail;         //!< Number of blocks written
+  std::atomic<bool> m_stop;             //!< Set to stop the I/O thread
+  std::atomic<bool> m_failed;           //!< Set if a write failed
+  bool m_stopped;                       //!< Stop has been called
+#ifdef HAVE_PTHREAD_H
+  Ptr<SystemThread> m_thread;           //!< The I/O thread
+  SystemCondition m_dataReady;          //!< Signaled when a block is submitted
+  SystemCondition m_spaceReady;         //!< Signaled when a block is written
+#endif /* HAVE_PTHREAD_H */
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_BLOCK_WRITER_H */
@@ -0,0 +1,354 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "columnar-trace-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ColumnarTraceFile");
+
+const char ColumnarTraceFile::MAGIC[8] = { 'N', 'S', '3', 'C', 'O', 'L', 'T', 'R' };
+
+ColumnarTraceFile::ColumnarTraceFile (std::string filename, uint32_t chunkRows)
+  : m_chunkRows (chunkRows)
+{
+  NS_LOG_FUNCTION (this << filename << chunkRows);
+  NS_ASSERT (chunkRows > 0);
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary);
+  NS_ABORT_MSG_UNLESS (m_file.is_open (), "ColumnarTraceFile::ColumnarTraceFile():  " <<
+                       "Unable to Open " << filename);
+  m_file.write (MAGIC, sizeof (MAGIC));
+}
+
+ColumnarTraceFile::~ColumnarTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  for (std::vector<Source *>::iterator i = m_sources.begin (); i != m_sources.end (); ++i)
+    {
+      delete *i;
+    }
+  m_sources.clear ();
+  m_contexts.clear ();
+  m_file.close ();
+}
+
+uint32_t
+ColumnarTraceFile::GetEventIndex (char event)
+{
+  switch (event)
+    {
+    case '+':
+      return 0;
+    case '-':
+      return 1;
+    case 'd':
+      return 2;
+    case 'r':
+      return 3;
+    case 't':
+      return 4;
+    default:
+      NS_FATAL_ERROR ("Unknown trace event type '" << event << "'");
+    }
+  return 0;
+}
+
+ColumnarTraceFile::Source &
+ColumnarTraceFile::GetSource (char event, const std::string &context)
+{
+  uint32_t index = GetEventIndex (event);
+  std::map<std::string, SourceSet>::iterator it = m_contexts.find (context);
+  if (it == m_contexts.end ())
+    {
+      it = m_contexts.insert (std::make_pair (context, SourceSet (N_EVENTS, 0))).first;
+    }
+  Source *source = it->second[index];
+  if (source == 0)
+    {
+      source = new Source;
+      source->id = static_cast<uint32_t> (m_sources.size ());
+      source->time.reserve (m_chunkRows);
+      source->uid.reserve (m_chunkRows);
+      source->size.reserve (m_chunkRows);
+      m_sources.push_back (source);
+      it->second[index] = source;
+
+      uint8_t event8 = static_cast<uint8_t> (event);
+      uint32_t length = static_cast<uint32_t> (context.size ());
+      m_file.put ('S');
+      m_file.write ((const char *)&source->id, sizeof (source->id));
+      m_file.write ((const char *)&event8, sizeof (event8));
+      m_file.write ((const char *)&length, sizeof (length));
+      m_file.write (context.data (), length);
+    }
+  return *source;
+}
+
+void
+ColumnarTraceFile::Write (char event, const std::string &context, Ptr<const Packet> p)
+{
+  Write (event, context, Simulator::Now (), p->GetUid (), p->GetSize ());
+}
+
+void
+ColumnarTraceFile::Write (char event, const std::string &context, Time t, uint64_t uid, uint32_t size)
+{
+  NS_LOG_FUNCTION (this << event << context << t << uid << size);
+  Source &source = GetSource (event, context);
+  source.time.push_back (t.GetNanoSeconds ());
+  source.uid.push_back (uid);
+  source.size.push_back (size);
+  if (source.time.size () >= m_chunkRows)
+    {
+      WriteChunk (source);
+    }
+}
+
+void
+ColumnarTraceFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Source *>::iterator i = m_sources.begin (); i != m_sources.end (); ++i)
+    {
+      WriteChunk (**i);
+    }
+  m_file.flush ();
+}
+
+bool
+ColumnarTraceFile::Fail (void) const
+{
+  return m_file.fail ();
+}
+
+void
+ColumnarTraceFile::PutVarint (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_encoded.push_back (static_cast<uint8_t> (value | 0x80));
+      value >>= 7;
+    }
+  m_encoded.push_back (static_cast<uint8_t> (value));
+}
+
+void
+ColumnarTraceFile::WriteColumn (uint8_t kind)
+{
+  uint32_t length = static_cast<uint32_t> (m_encoded.size ());
+  m_file.write ((const char *)&kind, sizeof (kind));
+  m_file.write ((const char *)&length, sizeof (length));
+  if (length > 0)
+    {
+      m_file.write ((const char *)&m_encoded[0], length);
+    }
+  m_encoded.clear ();
+}
+
+void
+ColumnarTraceFile::WriteChunk (Source &source)
+{
+  NS_LOG_FUNCTION (this << source.id << source.time.size ());
+  uint32_t rows = static_cast<uint32_t> (source.time.size ());
+  if (rows == 0)
+    {
+      return;
+    }
+  m_file.put ('C');
+  m_file.write ((const char *)&source.id, sizeof (source.id));
+  m_file.write ((const char *)&rows, sizeof (rows));
+
+  // Simulation time never goes backwards, so the deltas are positive
+  int64_t previousTime = 0;
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      NS_ASSERT (source.time[i] >= previousTime);
+      PutVarint (static_cast<uint64_t> (source.time[i] - previousTime));
+      previousTime = source.time[i];
+    }
+  WriteColumn (TIME);
+
+  // Uids are mostly increasing, but not strictly: zigzag code the deltas
+  int64_t previousUid = 0;
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      int64_t delta = static_cast<int64_t> (source.uid[i]) - previousUid;
+      PutVarint ((static_cast<uint64_t> (delta) << 1) ^ static_cast<uint64_t> (delta >> 63));
+      previousUid = static_cast<int64_t> (source.uid[i]);
+    }
+  WriteColumn (UID);
+
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      PutVarint (source.size[i]);
+    }
+  WriteColumn (SIZE);
+
+  source.time.clear ();
+  source.uid.clear ();
+  source.size.clear ();
+}
+
+
+ColumnarTraceReader::ColumnarTraceReader (std::string filename)
+  : m_fail (false)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_file.open (filename.c_str (), std::ios::in | std::ios::binary);
+  char magic[sizeof (ColumnarTraceFile::MAGIC)];
+  m_file.read (magic, sizeof (magic));
+  if (!m_file.good ()
+      || std::memcmp (magic, ColumnarTraceFile::MAGIC, sizeof (magic)) != 0)
+    {
+      m_fail = true;
+    }
+}
+
+bool
+ColumnarTraceReader::Fail (void) const
+{
+  return m_fail;
+}
+
+uint64_t
+ColumnarTraceReader::GetVarint (const uint8_t *&data)
+{
+  uint64_t value = 0;
+  uint32_t shift = 0;
+  while (*data & 0x80)
+    {
+      value |= static_cast<uint64_t> (*data & 0x7f) << shift;
+      shift += 7;
+      ++data;
+    }
+  value |= static_cast<uint64_t> (*data) << shift;
+  ++data;
+  return value;
+}
+
+bool
+ColumnarTraceReader::ReadChunk (Chunk &chunk, uint32_t columns)
+{
+  NS_LOG_FUNCTION (this << columns);
+  while (!m_fail)
+    {
+      int tag = m_file.get ();
+      if (!m_file.good ())
+        {
+          return false;
+        }
+      if (tag == 'S')
+        {
+          uint32_t id;
+          uint8_t event;
+          uint32_t length;
+          m_file.read ((char *)&id, sizeof (id));
+          m_file.read ((char *)&event, sizeof (event));
+          m_file.read ((char *)&length, sizeof (length));
+          Source source;
+          source.event = static_cast<char> (event);
+          source.context.resize (length);
+          if (length > 0)
+            {
+              m_file.read (&source.context[0], length);
+            }
+          if (!m_file.good () || id != m_sources.size ())
+            {
+              m_fail = true;
+              return false;
+            }
+          m_sources.push_back (source);
+          continue;
+        }
+      if (tag != 'C')
+        {
+          m_fail = true;
+          return false;
+        }
+
+      uint32_t id;
+      m_file.read ((char *)&id, sizeof (id));
+      m_file.read ((char *)&chunk.rows, sizeof (chunk.rows));
+      if (!m_file.good () || id >= m_sources.size ())
+        {
+          m_fail = true;
+          return false;
+        }
+      chunk.event = m_sources[id].event;
+      chunk.context = m_sources[id].context;
+      chunk.time.clear ();
+      chunk.uid.clear ();
+      chunk.size.clear ();
+      for (uint32_t c = 0; c < 3; ++c)
+        {
+          uint8_t kind;
+          uint32_t length;
+          m_file.read ((char *)&kind, sizeof (kind));
+          m_file.read ((char *)&length, sizeof (length));
+          if (!m_file.good ())
+            {
+              m_fail = true;
+              return false;
+            }
+          if (kind > ColumnarTraceFile::SIZE || (columns & (1 << kind)) == 0)
+            {
+              m_file.seekg (length, std::ios::cur);
+              continue;
+            }
+          m_encoded.resize (length + 1);
+          if (length > 0)
+            {
+              m_file.read ((char *)&m_encoded[0], length);
+            }
+          const uint8_t *data = &m_encoded[0];
+          int64_t previous = 0;
+          for (uint32_t i = 0; i < chunk.rows; ++i)
+            {
+              uint64_t value = GetVarint (data);
+              switch (kind)
+                {
+                case ColumnarTraceFile::TIME:
+                  previous += static_cast<int64_t> (value);
+                  chunk.time.push_back (previous);
+                  break;
+                case ColumnarTraceFile::UID:
+                  previous += static_cast<int64_t> ((value >> 1) ^ (~(value & 1) + 1));
+                  chunk.uid.push_back (static_cast<uint64_t> (previous));
+                  break;
+                default:
+                  chunk.size.push_back (static_cast<uint32_t> (value));
+                  break;
+                }
+            }
+        }
+      if (!m_file.good ())
+        {
+          m_fail = true;
+          return false;
+        }
+      return true;
+    }
+  return false;
+}
+
+} // namespace ns3
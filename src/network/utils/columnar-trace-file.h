@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COLUMNAR_TRACE_FILE_H
+#define COLUMNAR_TRACE_FILE_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief A binary, column oriented packet trace file.
+ *
+ * This is a compact alternative to the text files produced by
+ * AsciiTraceHelper.  Each trace source, identified by its event type
+ * ('+', '-', 'd', 'r', 't') and its context string, is stored as its
+ * own table with three typed columns: the time in nanoseconds, the
+ * packet uid and the packet size.  Rows are buffered per source and
+ * written in chunks, each column of a chunk being delta and varint
+ * coded.  No text formatting takes place while the simulation runs.
+ *
+ * The file layout is:
+ * \verbatim
+   file   := magic record*
+   magic  := "NS3COLTR"
+   record := 'S' source | 'C' chunk
+   source := id:u32 event:u8 length:u32 context:u8[length]
+   chunk  := id:u32 rows:u32 column column column
+   column := kind:u8 length:u32 data:u8[length]
+   \endverbatim
+ * Integers are stored in host byte order.  Times are coded as varint
+ * deltas to the previous row of the chunk, uids as zigzag varint
+ * deltas and sizes as varints.  Since each column is prefixed by its
+ * length, a reader can skip the columns it does not need, see
+ * ColumnarTraceReader.
+ *
+ * Use AsciiTraceHelper::CreateColumnarFileStream to pass such a file to
+ * the EnableAscii methods of the device helpers.
+ *
+ * The set of columns is fixed: the packet headers printed in the text
+ * traces, as well as any other argument of the trace source (e.g., the
+ * WifiMode and the SNR of the WifiPhy ascii sinks), are not recorded.
+ * Use the text format when those fields are needed.
+ */
+class ColumnarTraceFile : public SimpleRefCount<ColumnarTraceFile>
+{
+public:
+  /** Column identifiers. */
+  enum Column
+  {
+    TIME = 0,  //!< Time of the event, in nanoseconds
+    UID = 1,   //!< Packet uid
+    SIZE = 2   //!< Packet size, in bytes
+  };
+
+  /**
+   * Create a file.
+   *
+   * \param filename The name of the file.
+   * \param chunkRows The number of rows of a source buffered in memory
+   *        before they are written to the file.
+   */
+  ColumnarTraceFile (std::string filename, uint32_t chunkRows = 4096);
+  /** Destructor; writes all buffered rows. */
+  ~ColumnarTraceFile ();
+
+  /**
+   * Append a row.
+   *
+   * \param event The event type, as the first character of the
+   *        corresponding AsciiTraceHelper line.
+   * \param context The trace context, or an empty string.
+   * \param p The packet.
+   */
+  void Write (char event, const std::string &context, Ptr<const Packet> p);
+
+  /**
+   * Append a row.
+   *
+   * \param event The event type.
+   * \param context The trace context, or an empty string.
+   * \param t The time of the event.
+   * \param uid The packet uid.
+   * \param size The packet size.
+   */
+  void Write (char event, const std::string &context, Time t, uint64_t uid, uint32_t size);
+
+  /** Write all buffered rows to the file. */
+  void Flush (void);
+
+  /**
+   * \returns \c true if the file could not be opened or written.
+   */
+  bool Fail (void) const;
+
+  /** The magic string at the start of the file. */
+  static const char MAGIC[8];
+
+private:
+  /** Rows of a source not yet written to the file. */
+  struct Source
+  {
+    uint32_t id;                  //!< Source id in the file
+    std::vector<int64_t> time;    //!< Time column
+    std::vector<uint64_t> uid;    //!< Uid column
+    std::vector<uint32_t> size;   //!< Size column
+  };
+
+  /**
+   * Find or define the source of an event.
+   * \param event The event type.
+   * \param context The trace context.
+   * \returns The source.
+   */
+  Source & GetSource (char event, const std::string &context);
+  /**
+   * Write the buffered rows of a source.
+   * \param source The source.
+   */
+  void WriteChunk (Source &source);
+  /**
+   * Write an encoded column.
+   * \param kind The column identifier.
+   */
+  void WriteColumn (uint8_t kind);
+  /**
+   * Append a varint to the encoding buffer.
+   * \param value The value to encode.
+   */
+  void PutVarint (uint64_t value);
+
+  /** Number of supported event types. */
+  enum { N_EVENTS = 5 };
+  /**
+   * \param event An event type.
+   * \returns Its index in a SourceSet.
+   */
+  static uint32_t GetEventIndex (char event);
+
+  /** The sources of the events of one context, by event index. */
+  typedef std::vector<Source *> SourceSet;
+
+  std::ofstream m_file;                          //!< The file
+  uint32_t m_chunkRows;                          //!< Rows per chunk
+  std::map<std::string, SourceSet> m_contexts;   //!< Sources, by context
+  std::vector<Source *> m_sources;               //!< Sources, by id
+  std::vector<uint8_t> m_encoded;                //!< Encoding buffer
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief Read a file written by ColumnarTraceFile.
+ *
+ * Chunks are returned one at a time.  Only the requested columns are
+ * decoded, the others are skipped without being read.
+ */
+class ColumnarTraceReader
+{
+public:
+  /** A chunk of rows of one source. */
+  struct Chunk
+  {
+    char event;                   //!< Event type
+    std::string context;          //!< Trace context
+    uint32_t rows;                //!< Number of rows
+    std::vector<int64_t> time;    //!< Times in nanoseconds, if requested
+    std::vector<uint64_t> uid;    //!< Packet uids, if requested
+    std::vector<uint32_t> size;   //!< Packet sizes, if requested
+  };
+
+  /**
+   * Open a file.
+   * \param filename The name of the file.
+   */
+  ColumnarTraceReader (std::string filename);
+
+  /**
+   * \returns \c true if the file could not be opened or is not a
+   *          columnar trace file.
+   */
+  bool Fail (void) const;
+
+  /**
+   * Read the next chunk.
+   *
+   * \param chunk [out] The chunk.
+   * \param columns A bit mask of the columns to decode, each column
+   *        being selected by (1 << ColumnarTraceFile::Column).
+   * \returns \c false at the end of the file.
+   */
+  bool ReadChunk (Chunk &chunk, uint32_t columns = 0x7);
+
+private:
+  /**
+   * Read a varint.
+   * \param data [in,out] The position in the encoded column.
+   * \returns The decoded value.
+   */
+  static uint64_t GetVarint (const uint8_t *&data);
+
+  /** Definition of a source. */
+  struct Source
+  {
+    char event;                   //!< Event type
+    std::string context;          //!< Trace context
+  };
+
+  std::ifstream m_file;           //!< The file
+  bool m_fail;                    //!< Open or format error
+  std::vector<Source> m_sources;  //!< Sources, by id
+  std::vector<uint8_t> m_encoded; //!< Decoding buffer
+};
+
+} // namespace ns3
+
+#endif /* COLUMNAR_TRACE_FILE_H */
@@ -46,19 +46,42 @@ OutputStreamWrapper::OutputStreamWrapper (std::ostream* os)
   NS_ABORT_MSG_UNLESS (m_ostream->good (), "Output stream is not valid for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper (Ptr<ColumnarTraceFile> file)
+  : m_ostream (0),
+    m_destroyable (false),
+    m_columnar (file)
+{
+  NS_LOG_FUNCTION (this << file);
+  NS_ABORT_MSG_UNLESS (!file->Fail (), "Columnar trace file is not valid for writing.");
+}
+
 OutputStreamWrapper::~OutputStreamWrapper ()
 {
   NS_LOG_FUNCTION (this);
-  FatalImpl::UnregisterStream (m_ostream);
-  if (m_destroyable) delete m_ostream;
-  m_ostream = 0;
+  if (m_ostream != 0)
+    {
+      FatalImpl::UnregisterStream (m_ostream);
+      if (m_destroyable) delete m_ostream;
+      m_ostream = 0;
+    }
 }
 
 std::ostream *
 OutputStreamWrapper::GetStream (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_columnar)
+    {
+      NS_FATAL_ERROR ("OutputStreamWrapper::GetStream(): this wrapper holds a columnar trace file, "
+                      "which only the trace sinks handling ColumnarTraceFile can write to");
+    }
   return m_ostream;
 }
 
+Ptr<ColumnarTraceFile>
+OutputStreamWrapper::GetColumnarTraceFile (void) const
+{
+  return m_columnar;
+}
+
 } // namespace ns3
@@ -23,6 +23,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "columnar-trace-file.h"
 
 namespace ns3 {
 
@@ -81,6 +82,17 @@ public:
    * \param os output stream
    */
   OutputStreamWrapper (std::ostream* os);
+  /**
+   * Constructor
+   *
+   * The wrapper carries a binary columnar trace file instead of a text
+   * stream.  Trace sinks which know about ColumnarTraceFile write to it;
+   * calling GetStream () on such a wrapper is a fatal error, so that the
+   * sinks which only write text do not silently drop their output.
+   *
+   * \param file columnar trace file
+   */
+  OutputStreamWrapper (Ptr<ColumnarTraceFile> file);
   ~OutputStreamWrapper ();
 
   /**
@@ -88,13 +100,23 @@ public:
    *
    * \see SetStream
    *
+   * It is a fatal error to call this method on a wrapper holding a
+   * ColumnarTraceFile.
+   *
    * \returns a pointer to the encapsulated std::ostream
    */
   std::ostream *GetStream (void);
 
+  /**
+   * \returns the columnar trace file carried by the wrapper, or zero if
+   *          the wrapper holds a text stream.
+   */
+  Ptr<ColumnarTraceFile> GetColumnarTraceFile (void) const;
+
 private:
   std::ostream *m_ostream; //!< The output stream
   bool m_destroyable; //!< Can be destroyed
+  Ptr<ColumnarTraceFile> m_columnar; //!< The columnar trace file, if any
 };
 
 } // namespace ns3
@@ -0,0 +1,45 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "pcap-file.h"
+#include "pcap-file-async-writer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapFileAsyncWriter");
+
+PcapFileAsyncWriter::PcapFileAsyncWriter (PcapFile *file, uint32_t blockSize)
+  : AsyncBlockWriter (blockSize),
+    m_file (file)
+{
+  NS_LOG_FUNCTION (this << file << blockSize);
+}
+
+PcapFileAsyncWriter::~PcapFileAsyncWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Stop ();
+}
+
+bool
+PcapFileAsyncWriter::WriteBlock (const uint8_t *data, uint32_t size)
+{
+  m_file->WriteRecords (data, size);
+  return !m_file->Fail ();
+}
+
+} // namespace ns3
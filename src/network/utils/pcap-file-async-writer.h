@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_FILE_ASYNC_WRITER_H
+#define PCAP_FILE_ASYNC_WRITER_H
+
+#include <stdint.h>
+#include "async-block-writer.h"
+
+namespace ns3 {
+
+class PcapFile;
+
+/**
+ * \ingroup network
+ *
+ * \brief Write pcap records to a PcapFile from a background thread.
+ *
+ * Records are serialized by the caller into the blocks of an
+ * AsyncBlockWriter, each block being written to the file with one
+ * call to PcapFile::WriteRecords.
+ *
+ * This class is used internally by PcapFileWrapper when the
+ * ns3::PcapFileWrapper::Asynchronous attribute is set.
+ */
+class PcapFileAsyncWriter : public AsyncBlockWriter
+{
+public:
+  /**
+   * Start the I/O thread.
+   *
+   * \param file The file to write to, already opened and initialized.
+   * \param blockSize The number of octets to accumulate before a block
+   *        is handed to the I/O thread.
+   */
+  PcapFileAsyncWriter (PcapFile *file, uint32_t blockSize);
+  /** Destructor; calls Stop. */
+  virtual ~PcapFileAsyncWriter ();
+
+protected:
+  virtual bool WriteBlock (const uint8_t *data, uint32_t size);
+
+private:
+  PcapFile *m_file;                     //!< The file written by the I/O thread
+};
+
+} // namespace ns3
+
+#endif /* PCAP_FILE_ASYNC_WRITER_H */
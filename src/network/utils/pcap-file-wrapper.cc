@@ -16,12 +16,16 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <algorithm>
+
 #include "ns3/log.h"
 #include "ns3/boolean.h"
 #include "ns3/uinteger.h"
 #include "ns3/buffer.h"
 #include "ns3/header.h"
+#include "ns3/simulator.h"
 #include "pcap-file-wrapper.h"
+#include "pcap-file-async-writer.h"
 
 namespace ns3 {
 
@@ -46,12 +50,26 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("Asynchronous",
+                   "Whether records are written to disk by a background thread. "
+                   "Pending records are written when the file is closed, at the "
+                   "latest during Simulator::Destroy.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_async),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BlockSize",
+                   "Number of bytes of records accumulated before they are handed "
+                   "to the background thread, when Asynchronous is set.",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_writer (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,6 +84,10 @@ bool
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->Fail ();
+    }
   return m_file.Fail ();
 }
 
@@ -86,6 +108,12 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      m_writer->Stop ();
+      delete m_writer;
+      m_writer = 0;
+    }
   m_file.Close ();
 }
 
@@ -93,6 +121,10 @@ void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
+  if (m_writer != 0)
+    {
+      Close ();
+    }
   m_file.Open (filename, mode);
 }
 
@@ -113,12 +145,57 @@ PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrec
     {
       m_file.Init (dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
     } 
+
+  if (m_async && m_writer == 0 && !m_file.Fail ())
+    {
+      m_writer = new PcapFileAsyncWriter (&m_file, m_blockSize);
+      // Make sure all records are on disk once the simulation is over,
+      // even if the wrapper outlives Simulator::Destroy.
+      Simulator::ScheduleDestroy (&PcapFileWrapper::Close, Ptr<PcapFileWrapper> (this));
+    }
+}
+
+void
+PcapFileWrapper::GetTimestamp (Time t, uint32_t &tsSec, uint32_t &tsSubsec)
+{
+  if (m_file.IsNanoSecMode ())
+    {
+      uint64_t current = t.GetNanoSeconds ();
+      tsSec = static_cast<uint32_t> (current / 1000000000);
+      tsSubsec = static_cast<uint32_t> (current % 1000000000);
+    }
+  else
+    {
+      uint64_t current = t.GetMicroSeconds ();
+      tsSec = static_cast<uint32_t> (current / 1000000);
+      tsSubsec = static_cast<uint32_t> (current % 1000000);
+    }
+}
+
+uint8_t *
+PcapFileWrapper::ReserveRecord (Time t, uint32_t totalLen, uint32_t &inclLen)
+{
+  uint32_t tsSec;
+  uint32_t tsSubsec;
+  GetTimestamp (t, tsSec, tsSubsec);
+  uint8_t header[PcapFile::RECORD_HEADER_SIZE];
+  inclLen = m_file.SerializePacketHeader (tsSec, tsSubsec, totalLen, header);
+  uint8_t *record = m_writer->Reserve (PcapFile::RECORD_HEADER_SIZE + inclLen);
+  std::memcpy (record, header, PcapFile::RECORD_HEADER_SIZE);
+  return record + PcapFile::RECORD_HEADER_SIZE;
 }
 
 void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
+  if (m_writer != 0)
+    {
+      uint32_t inclLen;
+      uint8_t *data = ReserveRecord (t, p->GetSize (), inclLen);
+      p->CopyData (data, inclLen);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -139,6 +216,18 @@ void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
+  if (m_writer != 0)
+    {
+      uint32_t headerSize = header.GetSerializedSize ();
+      uint32_t inclLen;
+      uint8_t *data = ReserveRecord (t, headerSize + p->GetSize (), inclLen);
+      Buffer headerBuffer;
+      headerBuffer.AddAtStart (headerSize);
+      header.Serialize (headerBuffer.Begin ());
+      uint32_t copied = headerBuffer.CopyData (data, std::min (headerSize, inclLen));
+      p->CopyData (data + copied, inclLen - copied);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -159,6 +248,13 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
+  if (m_writer != 0)
+    {
+      uint32_t inclLen;
+      uint8_t *data = ReserveRecord (t, length, inclLen);
+      std::memcpy (data, buffer, inclLen);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
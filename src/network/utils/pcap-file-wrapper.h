@@ -30,11 +30,19 @@
 
 namespace ns3 {
 
+class PcapFileAsyncWriter;
+
 /**
  * A class that wraps a PcapFile as an ns3::Object and provides a higher-layer
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * When the Asynchronous attribute is set, records written after Init are
+ * serialized (and truncated to the snaplen) into memory blocks which are
+ * written to disk by a background thread.  The file is completed when it
+ * is closed, at the latest during Simulator::Destroy.  In this mode the
+ * file can only be written, and Fail reports errors asynchronously.
  */
 class PcapFileWrapper : public Object
 {
@@ -221,9 +229,31 @@ public:
   uint32_t GetDataLinkType (void);
 
 private:
+  /**
+   * \brief Split a time into the timestamp fields of a record.
+   *
+   * \param t The time to convert.
+   * \param tsSec [out] Seconds.
+   * \param tsSubsec [out] Microseconds, or nanoseconds in nanosecond mode.
+   */
+  void GetTimestamp (Time t, uint32_t &tsSec, uint32_t &tsSubsec);
+
+  /**
+   * \brief Queue the header of a record for asynchronous writing.
+   *
+   * \param t Packet timestamp as ns3::Time.
+   * \param totalLen Total packet length.
+   * \param inclLen [out] Number of packet octets to copy after truncation.
+   * \returns Where to copy \p inclLen octets of packet data.
+   */
+  uint8_t * ReserveRecord (Time t, uint32_t totalLen, uint32_t &inclLen);
+
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+  bool     m_async; //!< Write records from a background thread
+  uint32_t m_blockSize; //!< Size of the blocks written asynchronously
+  PcapFileAsyncWriter *m_writer; //!< Asynchronous writer, if enabled
 };
 
 } // namespace ns3
@@ -430,6 +430,34 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   return inclLen;
 }
 
+uint32_t
+PcapFile::SerializePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint8_t *buffer)
+{
+  NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen << &buffer);
+
+  uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
+
+  uint32_t fields[4] = { tsSec, tsUsec, inclLen, totalLen };
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      uint32_t field = fields[i];
+      if (m_swapMode)
+        {
+          field = Swap (field);
+        }
+      std::memcpy (buffer + i * sizeof (field), &field, sizeof (field));
+    }
+  return inclLen;
+}
+
+void
+PcapFile::WriteRecords (uint8_t const *data, uint32_t length)
+{
+  NS_LOG_FUNCTION (this << &data << length);
+  NS_ASSERT (m_file.good ());
+  m_file.write ((const char *)data, length);
+}
+
 void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen)
 {
@@ -44,6 +44,7 @@ class PcapFile
 public:
   static const int32_t  ZONE_DEFAULT    = 0;           /**< Time zone offset for current location */
   static const uint32_t SNAPLEN_DEFAULT = 65535;       /**< Default value for maximum octets to save per packet */
+  static const uint32_t RECORD_HEADER_SIZE = 16;       /**< Size in octets of a serialized packet record header */
 
 public:
   PcapFile ();
@@ -153,6 +154,32 @@ public:
    */
   void Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<const Packet> p);
 
+  /**
+   * \brief Serialize a packet record header into a memory buffer
+   *
+   * The record header is laid out exactly as it would be written by the
+   * Write methods, byte-swapped if required.  The caller is expected to
+   * append the first (returned) number of octets of packet data and
+   * hand the result to WriteRecords.
+   *
+   * \param tsSec       Packet timestamp, seconds
+   * \param tsUsec      Packet timestamp, microseconds
+   * \param totalLen    Total packet length
+   * \param buffer      [out] Buffer of at least RECORD_HEADER_SIZE octets
+   *
+   * \returns The number of octets of packet data to store, after snaplen
+   * truncation
+   */
+  uint32_t SerializePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint8_t *buffer);
+
+  /**
+   * \brief Write a block of serialized packet records to file
+   *
+   * \param data        Records built with SerializePacketHeader
+   * \param length      Number of octets to write
+   */
+  void WriteRecords (uint8_t const *data, uint32_t length);
+
 
   /**
    * \brief Read next packet from file
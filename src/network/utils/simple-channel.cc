@@ -22,6 +22,7 @@
 #include "simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
+#include "packet-burst.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
 
@@ -77,6 +78,39 @@ SimpleChannel::Send (Ptr<Packet> p, uint16_t protocol,
     }
 }
 
+void
+SimpleChannel::SendBurst (Ptr<const PacketBurst> burst, Ptr<SimpleNetDevice> sender,
+                          const std::vector<Time> &txTimes)
+{
+  NS_LOG_FUNCTION (this << burst << sender);
+  NS_ASSERT (burst->GetNPackets () == txTimes.size ());
+  for (std::vector<Ptr<SimpleNetDevice> >::const_iterator i = m_devices.begin (); i != m_devices.end (); ++i)
+    {
+      Ptr<SimpleNetDevice> tmp = *i;
+      if (tmp == sender)
+        {
+          continue;
+        }
+      if (m_blackListedDevices.find (tmp) != m_blackListedDevices.end ())
+        {
+          if (find (m_blackListedDevices[tmp].begin (), m_blackListedDevices[tmp].end (), sender) !=
+              m_blackListedDevices[tmp].end () )
+            {
+              continue;
+            }
+        }
+      // Each packet is sent when the previous one has been transmitted
+      Time txStart = Seconds (0);
+      std::vector<Time>::const_iterator txTime = txTimes.begin ();
+      for (std::list<Ptr<Packet> >::const_iterator j = burst->Begin (); j != burst->End (); ++j, ++txTime)
+        {
+          Simulator::ScheduleWithContext (tmp->GetNode ()->GetId (), txStart + m_delay,
+                                          &SimpleNetDevice::ReceiveBurstPacket, tmp, (*j)->Copy ());
+          txStart += *txTime;
+        }
+    }
+}
+
 void
 SimpleChannel::Add (Ptr<SimpleNetDevice> device)
 {
@@ -30,6 +30,7 @@ namespace ns3 {
 
 class SimpleNetDevice;
 class Packet;
+class PacketBurst;
 
 /**
  * \ingroup channel
@@ -68,6 +69,20 @@ public:
   virtual void Send (Ptr<Packet> p, uint16_t protocol, Mac48Address to, Mac48Address from,
                      Ptr<SimpleNetDevice> sender);
 
+  /**
+   * A burst of packets is sent by a net device.  The packets are sent
+   * back to back, starting now, and a receive event is scheduled for
+   * each of them and for all net devices connected to the channel other
+   * than the sender, as if they had been sent one by one.
+   *
+   * \param burst packets to be sent, each one tagged by the sender
+   * with its own addressing information
+   * \param sender netdevice who sent the burst
+   * \param txTimes transmit time of each packet of the burst
+   */
+  virtual void SendBurst (Ptr<const PacketBurst> burst, Ptr<SimpleNetDevice> sender,
+                          const std::vector<Time> &txTimes);
+
   /**
    * Attached a net device to the channel.
    *
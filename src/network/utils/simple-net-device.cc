@@ -30,6 +30,8 @@
 #include "ns3/tag.h"
 #include "ns3/simulator.h"
 #include "ns3/queue.h"
+#include "ns3/uinteger.h"
+#include "packet-burst.h"
 
 namespace ns3 {
 
@@ -210,6 +212,14 @@ SimpleNetDevice::GetTypeId (void)
                    DataRateValue (DataRate ("0b/s")),
                    MakeDataRateAccessor (&SimpleNetDevice::m_bps),
                    MakeDataRateChecker ())
+    .AddAttribute ("MaxBurstPackets",
+                   "The maximum number of queued packets sent to the channel "
+                   "as a single burst, with a single transmit complete event. "
+                   "Each packet is still received at its own arrival time. "
+                   "A value of 1 disables burst mode.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&SimpleNetDevice::m_maxBurstPackets),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("PhyRxDrop",
                      "Trace source indicating a packet has been dropped "
                      "by the device during reception",
@@ -224,7 +234,8 @@ SimpleNetDevice::SimpleNetDevice ()
     m_node (0),
     m_mtu (0xffff),
     m_ifIndex (0),
-    m_linkUp (false)
+    m_linkUp (false),
+    m_maxBurstPackets (1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -270,6 +281,15 @@ SimpleNetDevice::Receive (Ptr<Packet> packet, uint16_t protocol,
     }
 }
 
+void
+SimpleNetDevice::ReceiveBurstPacket (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  SimpleTag tag;
+  packet->RemovePacketTag (tag);
+  Receive (packet, tag.GetProto (), tag.GetDst (), tag.GetSrc ());
+}
+
 void 
 SimpleNetDevice::SetChannel (Ptr<SimpleChannel> channel)
 {
@@ -477,6 +497,36 @@ SimpleNetDevice::TransmitComplete ()
       return;
     }
 
+  if (m_maxBurstPackets > 1 && m_queue->GetNPackets () > 1)
+    {
+      //
+      // Drain the queue into a single burst.  The packets keep their
+      // SimpleTag, which is removed by the receivers.
+      //
+      Ptr<PacketBurst> burst = CreateObject<PacketBurst> ();
+      std::vector<Time> txTimes;
+      Time txTime = Time (0);
+      while (burst->GetNPackets () < m_maxBurstPackets && !m_queue->IsEmpty ())
+        {
+          Ptr<Packet> packet = m_queue->Dequeue ();
+          txTimes.push_back (Time (0));
+          if (m_bps > DataRate (0))
+            {
+              txTimes.back () = m_bps.CalculateBytesTxTime (packet->GetSize ());
+              txTime += txTimes.back ();
+            }
+          burst->AddPacket (packet);
+        }
+
+      m_channel->SendBurst (burst, this, txTimes);
+
+      if (m_queue->GetNPackets ())
+        {
+          TransmitCompleteEvent = Simulator::Schedule (txTime, &SimpleNetDevice::TransmitComplete, this);
+        }
+      return;
+    }
+
   Ptr<Packet> packet = m_queue->Dequeue ();
 
   SimpleTag tag;
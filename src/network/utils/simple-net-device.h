@@ -36,6 +36,7 @@ template <typename Item> class Queue;
 class SimpleChannel;
 class Node;
 class ErrorModel;
+class PacketBurst;
 
 /**
  * \ingroup netdevice
@@ -72,6 +73,15 @@ public:
    * \param from address packet was sent from
    */
   void Receive (Ptr<Packet> packet, uint16_t protocol, Mac48Address to, Mac48Address from);
+
+  /**
+   * Receive a packet of a burst from a connected SimpleChannel.
+   * The packet carries its own addressing information, and is
+   * handed to Receive ().
+   *
+   * \param packet Packet received on the channel
+   */
+  void ReceiveBurstPacket (Ptr<Packet> packet);
   
   /**
    * Attach a channel to this net device.  This will be the 
@@ -175,6 +185,7 @@ private:
   Ptr<Queue<Packet> > m_queue; //!< The Queue for outgoing packets.
   DataRate m_bps; //!< The device nominal Data rate. Zero means infinite
   EventId TransmitCompleteEvent; //!< the Tx Complete event
+  uint32_t m_maxBurstPackets; //!< Max number of queued packets sent as one burst
 
   /**
    * List of callbacks to fire if the link changes state (up or down).
@@ -20,6 +20,7 @@
 #include "point-to-point-net-device.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 
@@ -106,6 +107,54 @@ PointToPointChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointChannel::TransmitBurstStart (
+  Ptr<const PacketBurst> burst,
+  Ptr<PointToPointNetDevice> src,
+  const std::vector<Time> &txTimes,
+  Time interframeGap)
+{
+  NS_LOG_FUNCTION (this << burst << src);
+  NS_ASSERT (burst->GetNPackets () == txTimes.size ());
+  NS_ASSERT (!txTimes.empty ());
+
+  NS_ASSERT (m_link[0].m_state != INITIALIZING);
+  NS_ASSERT (m_link[1].m_state != INITIALIZING);
+
+  uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  Ptr<PointToPointNetDevice> dst = m_link[wire].m_dst;
+
+  // Time at which the transmission of each packet starts, relative to now
+  Time txStart = Seconds (0);
+  std::vector<Time>::const_iterator txTime = txTimes.begin ();
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i, ++txTime)
+    {
+      Simulator::ScheduleWithContext (dst->GetNode ()->GetId (),
+                                      txStart + *txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      dst, (*i)->Copy ());
+
+      // Call the tx anim callback when the packet starts being transmitted,
+      // as its arguments are relative to the current time
+      if (txStart.IsZero ())
+        {
+          m_txrxPointToPoint (*i, src, dst, *txTime, *txTime + m_delay);
+        }
+      else if (!m_txrxPointToPoint.IsEmpty ())
+        {
+          Simulator::Schedule (txStart, &PointToPointChannel::NotifyBurstTxRx, this, *i, src, dst, *txTime);
+        }
+      txStart += *txTime + interframeGap;
+    }
+  return true;
+}
+
+void
+PointToPointChannel::NotifyBurstTxRx (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
+                                      Ptr<PointToPointNetDevice> dst, Time txTime)
+{
+  m_txrxPointToPoint (p, src, dst, txTime, txTime + m_delay);
+}
+
 std::size_t
 PointToPointChannel::GetNDevices (void) const
 {
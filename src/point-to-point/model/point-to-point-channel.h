@@ -20,6 +20,7 @@
 #define POINT_TO_POINT_CHANNEL_H
 
 #include <list>
+#include <vector>
 #include "ns3/channel.h"
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
@@ -30,6 +31,7 @@ namespace ns3 {
 
 class PointToPointNetDevice;
 class Packet;
+class PacketBurst;
 
 /**
  * \ingroup point-to-point
@@ -80,6 +82,24 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+  /**
+   * \brief Transmit a burst of packets over this channel
+   *
+   * The packets are assumed to be serialized back to back by the source,
+   * each one followed by the interframe gap, starting now.  Each packet
+   * is delivered to the destination at the time its last bit arrives,
+   * as if it had been sent by TransmitStart.  The TxRxPointToPoint trace
+   * source is fired when the transmission of each packet starts.
+   *
+   * \param burst Packets to transmit
+   * \param src Source PointToPointNetDevice
+   * \param txTimes Transmit time of each packet of the burst
+   * \param interframeGap Gap between the end of a packet and the start of the next one
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitBurstStart (Ptr<const PacketBurst> burst, Ptr<PointToPointNetDevice> src,
+                                   const std::vector<Time> &txTimes, Time interframeGap);
+
   /**
    * \brief Get number of devices on this channel
    * \returns number of devices on this channel
@@ -146,6 +166,17 @@ protected:
      Time duration, Time lastBitTime);
                     
 private:
+  /**
+   * \brief Fire the TxRxPointToPoint trace source for a packet of a burst
+   *        whose transmission starts now
+   * \param p Packet transmitted
+   * \param src Source PointToPointNetDevice
+   * \param dst Destination PointToPointNetDevice
+   * \param txTime Transmit time of the packet
+   */
+  void NotifyBurstTxRx (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
+                        Ptr<PointToPointNetDevice> dst, Time txTime);
+
   /** Each point to point link has exactly two net devices. */
   static const std::size_t N_DEVICES = 2;
 
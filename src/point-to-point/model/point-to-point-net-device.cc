@@ -25,6 +25,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/packet-burst.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
@@ -67,6 +68,15 @@ PointToPointNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxBurstPackets",
+                   "The maximum number of queued packets that are drained and "
+                   "sent over the channel as a single burst, with a single "
+                   "transmit complete event.  Each packet of a burst is still "
+                   "delivered to the peer device at its own arrival time.  "
+                   "A value of 1 disables burst mode.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&PointToPointNetDevice::m_maxBurstPackets),
+                   MakeUintegerChecker<uint32_t> (1))
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -177,7 +187,9 @@ PointToPointNetDevice::PointToPointNetDevice ()
     m_txMachineState (READY),
     m_channel (0),
     m_linkUp (false),
-    m_currentPkt (0)
+    m_currentPkt (0),
+    m_currentBurst (0),
+    m_maxBurstPackets (1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -214,6 +226,7 @@ PointToPointNetDevice::DoDispose ()
   m_channel = 0;
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
+  m_currentBurst = 0;
   m_queue = 0;
   NetDevice::DoDispose ();
 }
@@ -262,6 +275,77 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   return result;
 }
 
+bool
+PointToPointNetDevice::TransmitBurstStart (Ptr<PacketBurst> burst)
+{
+  NS_LOG_FUNCTION (this << burst);
+  NS_LOG_LOGIC ("Burst of " << burst->GetNPackets () << " packets");
+
+  //
+  // Same as TransmitStart, except that the wire is kept busy for the time
+  // needed to serialize all the packets of the burst (each one followed by
+  // an interframe gap) and a single transmit complete event is scheduled.
+  // The sniffer and PhyTx traces still fire for each packet at the time
+  // its transmission would start and complete if it were sent alone.
+  //
+  NS_ASSERT_MSG (m_txMachineState == READY, "Must be READY to transmit");
+  m_txMachineState = BUSY;
+  m_currentBurst = burst;
+
+  bool traceTxBegin = !m_snifferTrace.IsEmpty () || !m_promiscSnifferTrace.IsEmpty ()
+    || !m_phyTxBeginTrace.IsEmpty ();
+  std::vector<Time> txTimes;
+  Time txCompleteTime = Seconds (0);
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+    {
+      // txCompleteTime is also the start of the transmission of this packet
+      if (i == burst->Begin ())
+        {
+          NotifyBurstTxBegin (*i);
+        }
+      else if (traceTxBegin)
+        {
+          Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::NotifyBurstTxBegin, this, *i);
+        }
+      Time txTime = m_bps.CalculateBytesTxTime ((*i)->GetSize ());
+      txTimes.push_back (txTime);
+      txCompleteTime += txTime + m_tInterframeGap;
+      if (!m_phyTxEndTrace.IsEmpty ())
+        {
+          Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::NotifyBurstTxEnd, this, *i);
+        }
+    }
+
+  NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
+  Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+
+  bool result = m_channel->TransmitBurstStart (burst, this, txTimes, m_tInterframeGap);
+  if (result == false)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i)
+        {
+          m_phyTxDropTrace (*i);
+        }
+    }
+  return result;
+}
+
+void
+PointToPointNetDevice::NotifyBurstTxBegin (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_snifferTrace (p);
+  m_promiscSnifferTrace (p);
+  m_phyTxBeginTrace (p);
+}
+
+void
+PointToPointNetDevice::NotifyBurstTxEnd (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_phyTxEndTrace (p);
+}
+
 void
 PointToPointNetDevice::TransmitComplete (void)
 {
@@ -276,10 +360,48 @@ PointToPointNetDevice::TransmitComplete (void)
   NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be BUSY if transmitting");
   m_txMachineState = READY;
 
-  NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
+  NS_ASSERT_MSG (m_currentPkt != 0 || m_currentBurst != 0,
+                 "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-  m_phyTxEndTrace (m_currentPkt);
-  m_currentPkt = 0;
+  if (m_currentBurst != 0)
+    {
+      // PhyTxEnd has been fired for each packet by NotifyBurstTxEnd
+      m_currentBurst = 0;
+    }
+  else
+    {
+      m_phyTxEndTrace (m_currentPkt);
+      m_currentPkt = 0;
+    }
+
+  TransmitNext ();
+}
+
+void
+PointToPointNetDevice::TransmitNext (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  //
+  // In burst mode, drain the queue (up to the burst limit) and push all the
+  // pending packets to the channel at once.  A single pending packet is
+  // always sent the usual way.
+  //
+  if (m_maxBurstPackets > 1 && m_queue->GetNPackets () > 1)
+    {
+      Ptr<PacketBurst> burst = CreateObject<PacketBurst> ();
+      while (burst->GetNPackets () < m_maxBurstPackets)
+        {
+          Ptr<Packet> p = m_queue->Dequeue ();
+          if (p == 0)
+            {
+              break;
+            }
+          burst->AddPacket (p);
+        }
+      TransmitBurstStart (burst);
+      return;
+    }
 
   Ptr<Packet> p = m_queue->Dequeue ();
   if (p == 0)
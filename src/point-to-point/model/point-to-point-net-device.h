@@ -36,6 +36,7 @@ namespace ns3 {
 template <typename Item> class Queue;
 class PointToPointChannel;
 class ErrorModel;
+class PacketBurst;
 
 /**
  * \defgroup point-to-point Point-To-Point Network Device
@@ -267,6 +268,42 @@ private:
    */
   bool TransmitStart (Ptr<Packet> p);
 
+  /**
+   * Start Sending a Burst of Packets Down the Wire.
+   *
+   * The packets are serialized back to back (separated by the interframe
+   * gap) and handed to the channel in a single call, so that a single
+   * transmit complete event is scheduled for the whole burst.
+   *
+   * \see PointToPointChannel::TransmitBurstStart ()
+   * \see TransmitComplete()
+   * \param burst the packets to send
+   * \returns true if success, false on failure
+   */
+  bool TransmitBurstStart (Ptr<PacketBurst> burst);
+
+  /**
+   * Fire the sniffer and PhyTxBegin trace sources for a packet of a burst
+   * whose transmission starts now.
+   *
+   * \param p the packet
+   */
+  void NotifyBurstTxBegin (Ptr<const Packet> p);
+
+  /**
+   * Fire the PhyTxEnd trace source for a packet of a burst whose
+   * transmission (including the interframe gap) completes now.
+   *
+   * \param p the packet
+   */
+  void NotifyBurstTxEnd (Ptr<const Packet> p);
+
+  /**
+   * Dequeue the next packet, or the next burst of packets if burst mode
+   * is enabled and more than one packet is queued, and start transmitting.
+   */
+  void TransmitNext (void);
+
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
    *
@@ -456,6 +493,13 @@ private:
   uint32_t m_mtu;
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
+  Ptr<PacketBurst> m_currentBurst; //!< Current burst processed
+
+  /**
+   * Maximum number of queued packets sent as a single burst; a value of
+   * one disables burst mode.
+   */
+  uint32_t m_maxBurstPackets;
 
   /**
    * \brief PPP to Ethernet protocol number mapping
@@ -23,6 +23,7 @@
 #include "point-to-point-remote-channel.h"
 #include "point-to-point-net-device.h"
 #include "ns3/packet.h"
+#include "ns3/packet-burst.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/mpi-interface.h"
@@ -77,4 +78,35 @@ PointToPointRemoteChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitBurstStart (
+  Ptr<const PacketBurst> burst,
+  Ptr<PointToPointNetDevice> src,
+  const std::vector<Time> &txTimes,
+  Time interframeGap)
+{
+  NS_LOG_FUNCTION (this << burst << src);
+  NS_ASSERT (burst->GetNPackets () == txTimes.size ());
+
+  IsInitialized ();
+
+  uint32_t wire = src == GetSource (0) ? 0 : 1;
+  Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+
+#ifdef NS3_MPI
+  // Remote ranks receive each packet at its own (absolute) rxTime
+  Time txStart = Simulator::Now ();
+  std::vector<Time>::const_iterator txTime = txTimes.begin ();
+  for (std::list<Ptr<Packet> >::const_iterator i = burst->Begin (); i != burst->End (); ++i, ++txTime)
+    {
+      Time rxTime = txStart + *txTime + GetDelay ();
+      MpiInterface::SendPacket ((*i)->Copy (), rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
+      txStart += *txTime + interframeGap;
+    }
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+  return true;
+}
+
 } // namespace ns3
@@ -68,6 +68,21 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+  /**
+   * \brief Transmit a burst of packets
+   *
+   * Each packet of the burst is sent to the remote rank with its own
+   * absolute receive time.
+   *
+   * \param burst Packets to transmit
+   * \param src Source PointToPointNetDevice
+   * \param txTimes Transmit time of each packet of the burst
+   * \param interframeGap Gap between the end of a packet and the start of the next one
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitBurstStart (Ptr<const PacketBurst> burst, Ptr<PointToPointNetDevice> src,
+                                   const std::vector<Time> &txTimes, Time interframeGap);
 };
 
 } // namespace ns3
@@ -24,6 +24,7 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -94,6 +95,234 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test class for the burst mode of the PointToPoint model
+ *
+ * It sends a few packets back to back from one NetDevice to another,
+ * with and without burst mode, and checks that they are received, and
+ * reported by the TxRxPointToPoint, PromiscSniffer, PhyTxBegin and
+ * PhyTxEnd trace sources, at the same times while burst mode uses fewer
+ * simulator events.
+ */
+class PointToPointBurstTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointBurstTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send some packets back to back to the device specified
+   *
+   * \param device NetDevice to send to
+   */
+  void SendPackets (Ptr<PointToPointNetDevice> device);
+
+  /**
+   * \brief Receive callback
+   *
+   * \param device the receiving NetDevice
+   * \param packet the received packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \returns true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  /**
+   * \brief TxRxPointToPoint trace sink
+   *
+   * \param packet the transmitted packet
+   * \param txDevice the transmitting NetDevice
+   * \param rxDevice the receiving NetDevice
+   * \param duration the transmission time of the packet
+   * \param lastBitTime the time the last bit is received, relative to now
+   */
+  void TxRx (Ptr<const Packet> packet, Ptr<NetDevice> txDevice, Ptr<NetDevice> rxDevice,
+             Time duration, Time lastBitTime);
+
+  /**
+   * \brief PromiscSniffer trace sink
+   *
+   * \param packet the transmitted packet
+   */
+  void Sniffer (Ptr<const Packet> packet);
+
+  /**
+   * \brief PhyTxBegin trace sink
+   *
+   * \param packet the transmitted packet
+   */
+  void PhyTxBegin (Ptr<const Packet> packet);
+
+  /**
+   * \brief PhyTxEnd trace sink
+   *
+   * \param packet the transmitted packet
+   */
+  void PhyTxEnd (Ptr<const Packet> packet);
+
+  /**
+   * \brief Run one simulation
+   *
+   * \param maxBurstPackets value of the MaxBurstPackets attribute
+   * \param traceTx whether to connect the transmit trace sources,
+   *        which cost events per packet of a burst
+   * \returns the number of simulator events executed
+   */
+  uint64_t RunOne (uint32_t maxBurstPackets, bool traceTx);
+
+  /**
+   * \brief Check that a list of trace times matches the one of the default mode
+   *
+   * \param times the times in burst mode
+   * \param expected the times in default mode
+   * \param name the name of the trace source
+   */
+  void CheckTimes (const std::vector<Time> &times, const std::vector<Time> &expected, std::string name);
+
+  uint32_t m_nPackets;  //!< Number of packets sent
+  std::vector<Time> m_rxTimes;  //!< Time each packet is received
+  std::vector<Time> m_txRxTimes;  //!< Transmission start and last bit receive times
+  std::vector<Time> m_snifferTimes;  //!< Times of the PromiscSniffer traces
+  std::vector<Time> m_phyTxBeginTimes;  //!< Times of the PhyTxBegin traces
+  std::vector<Time> m_phyTxEndTimes;  //!< Times of the PhyTxEnd traces
+};
+
+PointToPointBurstTest::PointToPointBurstTest ()
+  : TestCase ("PointToPoint burst mode"),
+    m_nPackets (10)
+{
+}
+
+void
+PointToPointBurstTest::SendPackets (Ptr<PointToPointNetDevice> device)
+{
+  for (uint32_t i = 0; i < m_nPackets; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100);
+      device->Send (p, device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+PointToPointBurstTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 100, "Unexpected packet size");
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointBurstTest::TxRx (Ptr<const Packet> packet, Ptr<NetDevice> txDevice, Ptr<NetDevice> rxDevice,
+                             Time duration, Time lastBitTime)
+{
+  m_txRxTimes.push_back (Simulator::Now ());
+  m_txRxTimes.push_back (Simulator::Now () + lastBitTime);
+}
+
+void
+PointToPointBurstTest::Sniffer (Ptr<const Packet> packet)
+{
+  m_snifferTimes.push_back (Simulator::Now ());
+}
+
+void
+PointToPointBurstTest::PhyTxBegin (Ptr<const Packet> packet)
+{
+  m_phyTxBeginTimes.push_back (Simulator::Now ());
+}
+
+void
+PointToPointBurstTest::PhyTxEnd (Ptr<const Packet> packet)
+{
+  m_phyTxEndTimes.push_back (Simulator::Now ());
+}
+
+uint64_t
+PointToPointBurstTest::RunOne (uint32_t maxBurstPackets, bool traceTx)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MilliSeconds (2)));
+  if (traceTx)
+    {
+      channel->TraceConnectWithoutContext ("TxRxPointToPoint", MakeCallback (&PointToPointBurstTest::TxRx, this));
+      devA->TraceConnectWithoutContext ("PromiscSniffer", MakeCallback (&PointToPointBurstTest::Sniffer, this));
+      devA->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&PointToPointBurstTest::PhyTxBegin, this));
+      devA->TraceConnectWithoutContext ("PhyTxEnd", MakeCallback (&PointToPointBurstTest::PhyTxEnd, this));
+    }
+
+  devA->SetAttribute ("MaxBurstPackets", UintegerValue (maxBurstPackets));
+  devA->SetAttribute ("InterframeGap", TimeValue (MicroSeconds (10)));
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+  devB->SetReceiveCallback (MakeCallback (&PointToPointBurstTest::Receive, this));
+
+  m_rxTimes.clear ();
+  m_txRxTimes.clear ();
+  m_snifferTimes.clear ();
+  m_phyTxBeginTimes.clear ();
+  m_phyTxEndTimes.clear ();
+  Simulator::Schedule (Seconds (1.0), &PointToPointBurstTest::SendPackets, this, devA);
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes.size (), m_nPackets, "Not all the packets have been received");
+  return events;
+}
+
+void
+PointToPointBurstTest::CheckTimes (const std::vector<Time> &times, const std::vector<Time> &expected, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (times.size (), expected.size (), "Unexpected number of " << name << " traces");
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (times[i], expected[i], "Different " << name << " time " << i << " in burst mode");
+    }
+}
+
+void
+PointToPointBurstTest::DoRun (void)
+{
+  uint64_t eventsNoBurst = RunOne (1, false);
+  uint64_t eventsBurst = RunOne (m_nPackets, false);
+  NS_TEST_EXPECT_MSG_LT (eventsBurst, eventsNoBurst, "Burst mode should schedule fewer events");
+
+  RunOne (1, true);
+  std::vector<Time> rxTimes = m_rxTimes;
+  std::vector<Time> txRxTimes = m_txRxTimes;
+  std::vector<Time> snifferTimes = m_snifferTimes;
+  std::vector<Time> phyTxBeginTimes = m_phyTxBeginTimes;
+  std::vector<Time> phyTxEndTimes = m_phyTxEndTimes;
+  RunOne (m_nPackets, true);
+
+  CheckTimes (m_rxTimes, rxTimes, "receive");
+  CheckTimes (m_txRxTimes, txRxTimes, "TxRxPointToPoint");
+  CheckTimes (m_snifferTimes, snifferTimes, "PromiscSniffer");
+  CheckTimes (m_phyTxBeginTimes, phyTxBeginTimes, "PhyTxBegin");
+  CheckTimes (m_phyTxEndTimes, phyTxEndTimes, "PhyTxEnd");
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -110,6 +339,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointBurstTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -93,10 +93,13 @@ void
 JakesProcess::ConstructOscillators ()
 {
   NS_ASSERT (m_jakes);
+  // Draw phi, theta, and the phase of each oscillator in one block
+  std::vector<double> uniforms (2 + m_nOscillators);
+  m_jakes->GetUniformRandomVariable ()->GetValues (&uniforms[0], uniforms.size ());
   // Initial phase is common for all oscillators:
-  double phi = m_jakes->GetUniformRandomVariable ()->GetValue ();
+  double phi = uniforms[0];
   // Theta is common for all oscillators:
-  double theta = m_jakes->GetUniformRandomVariable ()->GetValue ();
+  double theta = uniforms[1];
   for (unsigned int i = 0; i < m_nOscillators; i++)
     {
       unsigned int n = i + 1;
@@ -106,7 +109,7 @@ JakesProcess::ConstructOscillators ()
       /// 1b. Initiate rotation speed:
       double omega = m_omegaDopplerMax * std::cos (alpha);
       /// 2. Initiate complex amplitude:
-      double psi = m_jakes->GetUniformRandomVariable ()->GetValue ();
+      double psi = uniforms[2 + i];
       std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (m_nOscillators);
       /// 3. Construct oscillator:
       m_oscillators.push_back (Oscillator (amplitude, phi, omega)); 
@@ -35,6 +35,7 @@
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include "multi-model-spectrum-channel.h"
 
@@ -176,6 +177,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       NS_ASSERT (ret2.second);
     }
 
+  AddRxToIndex (phy);
 }
 
 
@@ -245,6 +247,34 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  std::vector<Ptr<SpectrumPhy> > candidates;
+  if (GetRxCandidates (txMobility, candidates))
+    {
+      // only convert the transmitted PSD to the models of the candidates
+      std::map<SpectrumModelUid_t, Ptr<SpectrumValue> > convertedTxPowerSpectra;
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = candidates.begin ();
+           rxPhyIterator != candidates.end ();
+           ++rxPhyIterator)
+        {
+          if ((*rxPhyIterator) == txParams->txPhy)
+            {
+              continue;
+            }
+          SpectrumModelUid_t rxSpectrumModelUid = (*rxPhyIterator)->GetRxSpectrumModel ()->GetUid ();
+          std::map<SpectrumModelUid_t, Ptr<SpectrumValue> >::iterator convertedIterator = convertedTxPowerSpectra.find (rxSpectrumModelUid);
+          if (convertedIterator == convertedTxPowerSpectra.end ())
+            {
+              convertedIterator = convertedTxPowerSpectra.insert (std::make_pair (rxSpectrumModelUid,
+                                                                                  ConvertTxPowerSpectrum (txInfoIteratorerator, txParams->psd, rxSpectrumModelUid))).first;
+            }
+          if (convertedIterator->second)
+            {
+              StartTxTo (txParams, txMobility, convertedIterator->second, *rxPhyIterator);
+            }
+        }
+      return;
+    }
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -252,25 +282,13 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
       NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
 
-      Ptr <SpectrumValue> convertedTxPowerSpectrum;
-      if (txSpectrumModelUid == rxSpectrumModelUid)
-        {
-          NS_LOG_LOGIC ("no spectrum conversion needed");
-          convertedTxPowerSpectrum = txParams->psd;
-        }
-      else
+      Ptr <SpectrumValue> convertedTxPowerSpectrum = ConvertTxPowerSpectrum (txInfoIteratorerator, txParams->psd, rxSpectrumModelUid);
+      if (convertedTxPowerSpectrum == 0)
         {
-          NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
-            {
-              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-              continue;
-            }
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+          // TX SpectrumModel is orthogonal to RX SpectrumModel
+          continue;
         }
 
-
       for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
            rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
            ++rxPhyIterator)
@@ -280,78 +298,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
-
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
-
-              if (txMobility && receiverMobility)
-                {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
-                  // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
-                  // Pathloss trace
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if ( pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
-                }
-
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
-                {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
-                }
-              else
-                {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
-                }
+              StartTxTo (txParams, txMobility, convertedTxPowerSpectrum, *rxPhyIterator);
             }
         }
 
@@ -359,6 +306,118 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
 }
 
+Ptr<SpectrumValue>
+MultiModelSpectrumChannel::ConvertTxPowerSpectrum (TxSpectrumModelInfoMap_t::const_iterator txInfoIterator,
+                                                   Ptr<SpectrumValue> txPowerSpectrum,
+                                                   SpectrumModelUid_t rxSpectrumModelUid) const
+{
+  SpectrumModelUid_t txSpectrumModelUid = txPowerSpectrum->GetSpectrumModelUid ();
+  if (txSpectrumModelUid == rxSpectrumModelUid)
+    {
+      NS_LOG_LOGIC ("no spectrum conversion needed");
+      return txPowerSpectrum;
+    }
+  NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
+  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+  if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end ())
+    {
+      // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+      return 0;
+    }
+  return rxConverterIterator->second.Convert (txPowerSpectrum);
+}
+
+void
+MultiModelSpectrumChannel::StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                                      Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> receiver)
+{
+  NS_LOG_FUNCTION (this << txParams << receiver);
+  Time delay = MicroSeconds (0);
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+  double pathGainLinear = 1;
+
+  if (txMobility && receiverMobility)
+    {
+      if (m_maxRange < std::numeric_limits<double>::max ()
+          && CalculateDistance (txMobility->GetPosition (), receiverMobility->GetPosition ()) > m_maxRange)
+        {
+          // beyond range
+          return;
+        }
+      double txAntennaGain = 0;
+      double rxAntennaGain = 0;
+      double propagationGainDb = 0;
+      double pathLossDb = 0;
+      if (txParams->txAntenna != 0)
+        {
+          Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+          txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = receiver->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+          rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      // Gain trace
+      m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+      // Pathloss trace
+      m_pathLossTrace (txParams->txPhy, receiver, pathLossDb);
+      if ( pathLossDb > m_maxLossDb)
+        {
+          // beyond range, no need to copy the signal
+          return;
+        }
+      pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+    }
+
+  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+  Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+
+  if (txMobility && receiverMobility)
+    {
+      *(rxParams->psd) *= pathGainLinear;
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+        }
+
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+        }
+    }
+
+  Ptr<NetDevice> netDev = receiver->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                      rxParams, receiver);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                           rxParams, receiver);
+    }
+}
+
 void
 MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
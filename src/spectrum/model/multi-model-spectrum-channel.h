@@ -149,6 +149,33 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Convert a transmitted PSD to the SpectrumModel of a receiver.
+   *
+   * \param txInfoIterator The entry of the TX SpectrumModel in m_txSpectrumModelInfoMap.
+   * \param txPowerSpectrum The transmitted PSD.
+   * \param rxSpectrumModelUid The RX SpectrumModel.
+   * \return The converted PSD, the transmitted PSD itself if both models
+   * are the same, or 0 if they are orthogonal.
+   */
+  Ptr<SpectrumValue> ConvertTxPowerSpectrum (TxSpectrumModelInfoMap_t::const_iterator txInfoIterator,
+                                             Ptr<SpectrumValue> txPowerSpectrum,
+                                             SpectrumModelUid_t rxSpectrumModelUid) const;
+
+  /**
+   * Used internally to compute the signal received by one receiver,
+   * and schedule its reception unless it is out of range.  The signal
+   * parameters are only copied once the receiver is known to be in
+   * range.
+   *
+   * \param txParams The parameters of the transmitted signal.
+   * \param txMobility The mobility model of the transmitter.
+   * \param convertedTxPowerSpectrum The transmitted PSD, converted to the receiver SpectrumModel.
+   * \param receiver The receiver.
+   */
+  void StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                  Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> receiver);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
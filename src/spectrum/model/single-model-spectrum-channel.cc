@@ -33,6 +33,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
+#include <limits>
 
 
 #include "single-model-spectrum-channel.h"
@@ -76,6 +77,7 @@ SingleModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
   m_phyList.push_back (phy);
+  AddRxToIndex (phy);
 }
 
 
@@ -106,87 +108,122 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
   Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
 
-  for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
-       rxPhyIterator != m_phyList.end ();
-       ++rxPhyIterator)
+  std::vector<Ptr<SpectrumPhy> > candidates;
+  if (GetRxCandidates (senderMobility, candidates))
     {
-      if ((*rxPhyIterator) != txParams->txPhy)
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = candidates.begin ();
+           rxPhyIterator != candidates.end ();
+           ++rxPhyIterator)
         {
-          Time delay  = MicroSeconds (0);
-
-          Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
-          NS_LOG_LOGIC ("copying signal parameters " << txParams);
-          Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-
-          if (senderMobility && receiverMobility)
-            {
-              double txAntennaGain = 0;
-              double rxAntennaGain = 0;
-              double propagationGainDb = 0;
-              double pathLossDb = 0;
-              if (rxParams->txAntenna != 0)
-                {
-                  Angles txAngles (receiverMobility->GetPosition (), senderMobility->GetPosition ());
-                  txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                  NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                  pathLossDb -= txAntennaGain;
-                }
-              Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-              if (rxAntenna != 0)
-                {
-                  Angles rxAngles (senderMobility->GetPosition (), receiverMobility->GetPosition ());
-                  rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                  NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                  pathLossDb -= rxAntennaGain;
-                }
-              if (m_propagationLoss)
-                {
-                  propagationGainDb = m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobility);
-                  NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                  pathLossDb -= propagationGainDb;
-                }                    
-              NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
-              // Gain trace
-              m_gainTrace (senderMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
-              // Pathloss trace
-              m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-              if ( pathLossDb > m_maxLossDb)
-                {
-                  // beyond range
-                  continue;
-                }
-              double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-              *(rxParams->psd) *= pathGainLinear;              
-
-              if (m_spectrumPropagationLoss)
-                {
-                  rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, senderMobility, receiverMobility);
-                }
-
-              if (m_propagationDelay)
-                {
-                  delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
-                }
-            }
-
-
-          Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-          if (netDev)
+          if ((*rxPhyIterator) != txParams->txPhy)
             {
-              // the receiver has a NetDevice, so we expect that it is attached to a Node
-              uint32_t dstNode =  netDev->GetNode ()->GetId ();
-              Simulator::ScheduleWithContext (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator);
+              StartTxTo (txParams, senderMobility, *rxPhyIterator);
             }
-          else
+        }
+    }
+  else
+    {
+      for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
+           rxPhyIterator != m_phyList.end ();
+           ++rxPhyIterator)
+        {
+          if ((*rxPhyIterator) != txParams->txPhy)
             {
-              // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-              Simulator::Schedule (delay, &SingleModelSpectrumChannel::StartRx, this,
-                                   rxParams, *rxPhyIterator);
+              StartTxTo (txParams, senderMobility, *rxPhyIterator);
             }
         }
     }
 }
 
+void
+SingleModelSpectrumChannel::StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> senderMobility,
+                                       Ptr<SpectrumPhy> receiver)
+{
+  NS_LOG_FUNCTION (this << txParams << receiver);
+  Time delay  = MicroSeconds (0);
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+  Ptr<SpectrumSignalParameters> rxParams;
+
+  if (senderMobility && receiverMobility)
+    {
+      if (m_maxRange < std::numeric_limits<double>::max ()
+          && CalculateDistance (senderMobility->GetPosition (), receiverMobility->GetPosition ()) > m_maxRange)
+        {
+          // beyond range
+          return;
+        }
+      double txAntennaGain = 0;
+      double rxAntennaGain = 0;
+      double propagationGainDb = 0;
+      double pathLossDb = 0;
+      if (txParams->txAntenna != 0)
+        {
+          Angles txAngles (receiverMobility->GetPosition (), senderMobility->GetPosition ());
+          txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = receiver->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (senderMobility->GetPosition (), receiverMobility->GetPosition ());
+          rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          propagationGainDb = m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobility);
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      // Gain trace
+      m_gainTrace (senderMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+      // Pathloss trace
+      m_pathLossTrace (txParams->txPhy, receiver, pathLossDb);
+      if ( pathLossDb > m_maxLossDb)
+        {
+          // beyond range, no need to copy the signal
+          return;
+        }
+      NS_LOG_LOGIC ("copying signal parameters " << txParams);
+      rxParams = txParams->Copy ();
+      double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+      *(rxParams->psd) *= pathGainLinear;
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, senderMobility, receiverMobility);
+        }
+
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
+        }
+    }
+  else
+    {
+      NS_LOG_LOGIC ("copying signal parameters " << txParams);
+      rxParams = txParams->Copy ();
+    }
+
+  Ptr<NetDevice> netDev = receiver->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, receiver);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &SingleModelSpectrumChannel::StartRx, this,
+                           rxParams, receiver);
+    }
+}
+
 void
 SingleModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
@@ -72,6 +72,17 @@ private:
    */
   void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Used internally to compute the signal received by one receiver,
+   * and schedule its reception unless it is out of range.
+   *
+   * \param txParams the parameters of the transmitted signal
+   * \param senderMobility the mobility model of the transmitter
+   * \param receiver the receiver
+   */
+  void StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> senderMobility,
+                  Ptr<SpectrumPhy> receiver);
+
   /**
    * List of SpectrumPhy instances attached to the channel.
    */
@@ -18,9 +18,11 @@
  * Author: Nicola Baldo <nbaldo@cttc.es>
  */
 
+#include <limits>
 #include <ns3/log.h>
 #include <ns3/double.h>
 #include <ns3/pointer.h>
+#include <ns3/spatial-index.h>
 
 #include "spectrum-channel.h"
 
@@ -32,8 +34,10 @@ NS_LOG_COMPONENT_DEFINE ("SpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED (SpectrumChannel);
 
 SpectrumChannel::SpectrumChannel ()
+  : m_maxRange (std::numeric_limits<double>::max ())
 {
   NS_LOG_FUNCTION (this);
+  m_spatialIndex = CreateObject<SpatialIndex> ();
 }
 
 SpectrumChannel::~SpectrumChannel ()
@@ -47,6 +51,10 @@ SpectrumChannel::DoDispose ()
   m_propagationLoss = 0;
   m_propagationDelay = 0;
   m_spectrumPropagationLoss = 0;
+  m_spatialIndex->Dispose ();
+  m_indexedRx.clear ();
+  m_unindexedRx.clear ();
+  m_knownRx.clear ();
 }
 
 TypeId
@@ -70,6 +78,18 @@ SpectrumChannel::GetTypeId (void)
                    MakeDoubleAccessor (&SpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
 
+    .AddAttribute ("MaxRange",
+                   "The distance in meters beyond which transmissions are "
+                   "not passed to the receiving PHY.  When set, only the "
+                   "receivers found near the transmitter by a spatial index "
+                   "are considered, instead of all the receivers.  The "
+                   "default value corresponds to considering all signals "
+                   "for reception.",
+                   DoubleValue (std::numeric_limits<double>::max ()),
+                   MakeDoubleAccessor (&SpectrumChannel::SetMaxRange,
+                                       &SpectrumChannel::GetMaxRange),
+                   MakeDoubleChecker<double> (0))
+
     .AddAttribute ("PropagationLossModel",
                    "A pointer to the propagation loss model attached to this channel.",
                    PointerValue (0),
@@ -149,5 +169,73 @@ SpectrumChannel::GetSpectrumPropagationLossModel (void)
   return m_spectrumPropagationLoss;
 }
 
+void
+SpectrumChannel::SetMaxRange (double maxRange)
+{
+  NS_LOG_FUNCTION (this << maxRange);
+  m_maxRange = maxRange;
+  if (maxRange > 0 && maxRange < std::numeric_limits<double>::max ())
+    {
+      m_spatialIndex->SetCellSize (maxRange);
+    }
+}
+
+double
+SpectrumChannel::GetMaxRange (void) const
+{
+  return m_maxRange;
+}
+
+void
+SpectrumChannel::AddRxToIndex (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  if (m_knownRx.insert (phy).second)
+    {
+      m_unindexedRx.push_back (phy);
+    }
+}
+
+bool
+SpectrumChannel::GetRxCandidates (Ptr<const MobilityModel> txMobility, std::vector<Ptr<SpectrumPhy> > &candidates)
+{
+  NS_LOG_FUNCTION (this << txMobility);
+  candidates.clear ();
+  if (m_maxRange == std::numeric_limits<double>::max () || txMobility == 0)
+    {
+      return false;
+    }
+
+  // The mobility model of a PHY is often set after the PHY is added
+  // to the channel, so the receivers are filed lazily
+  std::vector<Ptr<SpectrumPhy> > unindexed;
+  for (std::vector<Ptr<SpectrumPhy> >::const_iterator i = m_unindexedRx.begin (); i != m_unindexedRx.end (); ++i)
+    {
+      Ptr<MobilityModel> mobility = (*i)->GetMobility ();
+      if (mobility)
+        {
+          uint32_t index = m_spatialIndex->Add (mobility);
+          NS_ASSERT (index == m_indexedRx.size ());
+          m_indexedRx.push_back (*i);
+        }
+      else
+        {
+          unindexed.push_back (*i);
+        }
+    }
+  m_unindexedRx.swap (unindexed);
+
+  std::vector<uint32_t> indexes;
+  m_spatialIndex->GetCandidates (txMobility->GetPosition (), m_maxRange, indexes);
+  candidates.reserve (indexes.size () + m_unindexedRx.size ());
+  for (std::vector<uint32_t>::const_iterator i = indexes.begin (); i != indexes.end (); ++i)
+    {
+      candidates.push_back (m_indexedRx[*i]);
+    }
+  candidates.insert (candidates.end (), m_unindexedRx.begin (), m_unindexedRx.end ());
+  NS_LOG_LOGIC (candidates.size () << " candidate receivers out of " << m_knownRx.size ());
+  return true;
+}
+
 
 } // namespace
@@ -22,6 +22,8 @@
 #ifndef SPECTRUM_CHANNEL_H
 #define SPECTRUM_CHANNEL_H
 
+#include <set>
+#include <vector>
 #include <ns3/object.h>
 #include <ns3/nstime.h>
 #include <ns3/channel.h>
@@ -38,6 +40,7 @@ namespace ns3 {
 
 class PacketBurst;
 class SpectrumValue;
+class SpatialIndex;
 
 /**
  * \ingroup spectrum
@@ -95,6 +98,21 @@ public:
    */
   Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
+  /**
+   * Set the distance beyond which signals are not delivered.
+   *
+   * When set, StartTx only considers the receivers found by a
+   * SpatialIndex around the transmitter, whose cells are as large as
+   * this range, instead of all the receivers of the channel.
+   *
+   * \param maxRange the maximum range, in meters
+   */
+  void SetMaxRange (double maxRange);
+  /**
+   * \return the distance beyond which signals are not delivered, in meters
+   */
+  double GetMaxRange (void) const;
+
 
 
   /**
@@ -154,6 +172,30 @@ public:
 
 protected:
 
+  /**
+   * Make a receiver known to the spatial index.  To be called by
+   * AddRx; calling it again for the same receiver does nothing.
+   *
+   * The receiver is filed in the index with its mobility model at the
+   * next call to GetRxCandidates.  Receivers without a mobility model
+   * are candidates of every transmission.
+   *
+   * \param phy the receiver
+   */
+  void AddRxToIndex (Ptr<SpectrumPhy> phy);
+
+  /**
+   * Get the receivers which may be within MaxRange of a transmitter.
+   *
+   * \param txMobility the mobility model of the transmitter
+   * \param candidates the candidate receivers: the ones in range,
+   * possibly a few out of range, in the order they were added, followed
+   * by the receivers without a mobility model
+   * \return false if MaxRange is not set or the transmitter has no
+   * mobility model, in which case all the receivers are to be considered
+   */
+  bool GetRxCandidates (Ptr<const MobilityModel> txMobility, std::vector<Ptr<SpectrumPhy> > &candidates);
+
   /**
    * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
    * SpectrumPhy and a pathloss value, in dB.
@@ -194,6 +236,18 @@ protected:
    */
   Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
 
+  /**
+   * Maximum range [m].
+   *
+   * Any device farther away is considered out of range.
+   */
+  double m_maxRange;
+
+private:
+  Ptr<SpatialIndex> m_spatialIndex;             //!< Index of the receivers with a mobility model
+  std::vector<Ptr<SpectrumPhy> > m_indexedRx;    //!< Receivers filed in the index, by index
+  std::vector<Ptr<SpectrumPhy> > m_unindexedRx;  //!< Receivers not filed in the index yet
+  std::set<Ptr<SpectrumPhy> > m_knownRx;         //!< Receivers passed to AddRxToIndex
 
 };
 
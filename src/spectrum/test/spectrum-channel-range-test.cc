@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-model-ism2400MHz-res1MHz.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief A SpectrumPhy counting the signals it receives.
+ */
+class CountingSpectrumPhy : public SpectrumPhy
+{
+public:
+  CountingSpectrumPhy ()
+    : m_rxCount (0)
+  {
+  }
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+  }
+  virtual Ptr<NetDevice> GetDevice () const
+  {
+    return 0;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return SpectrumModelIsm2400MhzRes1Mhz;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    ++m_rxCount;
+  }
+  virtual void DoDispose ()
+  {
+    m_mobility = 0;
+    SpectrumPhy::DoDispose ();
+  }
+
+  uint32_t m_rxCount;               ///< number of signals received
+  Ptr<MobilityModel> m_mobility;    ///< mobility model
+};
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief Check which receivers of a SpectrumChannel get a signal
+ * when the MaxRange and MaxLossDb attributes are set.
+ */
+class SpectrumChannelRangeTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param channelType the TypeId name of the channel
+   * \param maxRange the MaxRange attribute, in meters, or 0 to keep the default
+   * \param maxLossDb the MaxLossDb attribute, or 0 to keep the default
+   */
+  SpectrumChannelRangeTestCase (std::string channelType, double maxRange, double maxLossDb);
+
+private:
+  virtual void DoRun (void);
+
+  std::string m_channelType;    ///< the TypeId name of the channel
+  double m_maxRange;            ///< the MaxRange attribute
+  double m_maxLossDb;           ///< the MaxLossDb attribute
+};
+
+SpectrumChannelRangeTestCase::SpectrumChannelRangeTestCase (std::string channelType, double maxRange, double maxLossDb)
+  : TestCase (channelType + " delivery with MaxRange=" + std::to_string (static_cast<int> (maxRange))
+              + " MaxLossDb=" + std::to_string (static_cast<int> (maxLossDb))),
+    m_channelType (channelType),
+    m_maxRange (maxRange),
+    m_maxLossDb (maxLossDb)
+{
+}
+
+void
+SpectrumChannelRangeTestCase::DoRun (void)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (m_channelType);
+  Ptr<SpectrumChannel> channel = factory.Create<SpectrumChannel> ();
+  if (m_maxRange > 0)
+    {
+      channel->SetAttribute ("MaxRange", DoubleValue (m_maxRange));
+    }
+  if (m_maxLossDb > 0)
+    {
+      channel->SetAttribute ("MaxLossDb", DoubleValue (m_maxLossDb));
+    }
+  Ptr<LogDistancePropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel> ();
+  channel->AddPropagationLossModel (loss);
+
+  // The receivers are 10 m apart on a line, and one has no mobility model
+  std::vector<Ptr<CountingSpectrumPhy> > phys;
+  for (uint32_t i = 0; i < 50; ++i)
+    {
+      Ptr<CountingSpectrumPhy> phy = CreateObject<CountingSpectrumPhy> ();
+      if (i > 0)
+        {
+          Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (Vector (10.0 * i, 0, 0));
+          phy->SetMobility (mobility);
+        }
+      channel->AddRx (phy);
+      phys.push_back (phy);
+    }
+  if (m_channelType == "ns3::MultiModelSpectrumChannel")
+    {
+      // Adding a receiver again, as after a SpectrumModel change, must
+      // not duplicate its signals
+      channel->AddRx (phys[3]);
+    }
+
+  Ptr<CountingSpectrumPhy> tx = CreateObject<CountingSpectrumPhy> ();
+  Ptr<MobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (200, 0, 0));
+  tx->SetMobility (txMobility);
+  channel->AddRx (tx);
+
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MicroSeconds (100);
+  params->txPhy = tx;
+  params->psd = Create<SpectrumValue> (SpectrumModelIsm2400MhzRes1Mhz);
+  Simulator::Schedule (Seconds (1), &SpectrumChannel::StartTx, channel, params);
+  // A receiver moving into range
+  Simulator::Schedule (Seconds (1.5), &MobilityModel::SetPosition, phys[49]->GetMobility (), Vector (220, 10, 0));
+  Simulator::Schedule (Seconds (2), &SpectrumChannel::StartTx, channel, params);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (tx->m_rxCount, 0, "The transmitter received its own signal");
+  NS_TEST_EXPECT_MSG_EQ (phys[0]->m_rxCount, 2, "The receiver without mobility model should always receive");
+  for (uint32_t i = 1; i < phys.size (); ++i)
+    {
+      double distance = CalculateDistance (phys[i]->GetMobility ()->GetPosition (), txMobility->GetPosition ());
+      double lossDb = -loss->CalcRxPower (0, txMobility, phys[i]->GetMobility ());
+      uint32_t expected = 0;
+      if ((m_maxRange == 0 || distance <= m_maxRange) && (m_maxLossDb == 0 || lossDb <= m_maxLossDb))
+        {
+          expected = 2;
+        }
+      if (i == 49)
+        {
+          // out of range during the first transmission unless nothing is filtered
+          expected = (m_maxRange == 0 && m_maxLossDb == 0) ? 2 : 1;
+        }
+      NS_TEST_EXPECT_MSG_EQ (phys[i]->m_rxCount, expected, "Wrong number of signals received at " << distance << "m");
+    }
+
+  Simulator::Destroy ();
+  for (uint32_t i = 0; i < phys.size (); ++i)
+    {
+      phys[i]->Dispose ();
+    }
+  tx->Dispose ();
+  channel->Dispose ();
+}
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief SpectrumChannel range Test Suite
+ */
+class SpectrumChannelRangeTestSuite : public TestSuite
+{
+public:
+  SpectrumChannelRangeTestSuite ();
+};
+
+SpectrumChannelRangeTestSuite::SpectrumChannelRangeTestSuite ()
+  : TestSuite ("spectrum-channel-range", UNIT)
+{
+  const char *channelTypes[] = { "ns3::SingleModelSpectrumChannel", "ns3::MultiModelSpectrumChannel" };
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      AddTestCase (new SpectrumChannelRangeTestCase (channelTypes[i], 0, 0), TestCase::QUICK);
+      AddTestCase (new SpectrumChannelRangeTestCase (channelTypes[i], 95, 0), TestCase::QUICK);
+      AddTestCase (new SpectrumChannelRangeTestCase (channelTypes[i], 0, 100), TestCase::QUICK);
+      AddTestCase (new SpectrumChannelRangeTestCase (channelTypes[i], 95, 100), TestCase::QUICK);
+    }
+}
+
+static SpectrumChannelRangeTestSuite g_spectrumChannelRangeTestSuite; ///< the test suite
@@ -55,6 +55,22 @@ public:
     m_max = std::max (x, m_max);
     m_size++;
   }
+  /**
+   * Add new samples
+   * \param values the samples
+   * \param n the number of samples
+   */
+  void UpdateBatch (T const *values, uint32_t n)
+  {
+    m_varianceCalculator.UpdateBatch (values, n);
+
+    for (uint32_t i = 0; i < n; i++)
+      {
+        m_min = std::min (values[i], m_min);
+        m_max = std::max (values[i], m_max);
+      }
+    m_size += n;
+  }
   /// Reset statistics
   void Reset ()
   {
@@ -53,6 +53,17 @@ public:
    * \param i value of type T to use for updating the calculator
    */
   void Update (const T i);
+  /**
+   * Updates all variables of MinMaxAvgTotalCalculator with a batch of
+   * values.  The statistics of the batch are computed first, in loops
+   * without a division per value, then merged with the current ones
+   * (Chan, Golub and LeVeque, "Updating formulae and a pairwise
+   * algorithm for computing sample variances", 1979).
+   * \param values the values, converted to type T
+   * \param n the number of values
+   */
+  template <typename U>
+  void UpdateBatch (const U *values, uint32_t n);
   /**
    * Reinitializes all variables of MinMaxAvgTotalCalculator
    */
@@ -230,6 +241,66 @@ MinMaxAvgTotalCalculator<T>::Update (const T i)
   // end MinMaxAvgTotalCalculator::Update
 }
 
+template <typename T>
+template <typename U>
+void
+MinMaxAvgTotalCalculator<T>::UpdateBatch (const U *values, uint32_t n)
+{
+  if (!m_enabled || n == 0)
+    {
+      return;
+    }
+
+  T total = 0;
+  T squareTotal = 0;
+  T min = static_cast<T> (values[0]);
+  T max = min;
+  double sum = 0;
+  for (uint32_t j = 0; j < n; j++)
+    {
+      T i = static_cast<T> (values[j]);
+      total       += i;
+      squareTotal += i*i;
+      min = (i < min) ? i : min;
+      max = (i > max) ? i : max;
+      sum += i;
+    }
+  double mean = sum / n;
+  double s = 0;
+  for (uint32_t j = 0; j < n; j++)
+    {
+      double d = static_cast<T> (values[j]) - mean;
+      s += d * d;
+    }
+
+  if (m_count == 0)
+    {
+      m_min      = min;
+      m_max      = max;
+      m_meanCurr = mean;
+      m_sCurr    = s;
+    }
+  else
+    {
+      m_min = (min < m_min) ? min : m_min;
+      m_max = (max > m_max) ? max : m_max;
+
+      // Save the previous values.
+      m_meanPrev = m_meanCurr;
+      m_sPrev    = m_sCurr;
+
+      // Merge the statistics of the batch.
+      double delta = mean - m_meanPrev;
+      double count = static_cast<double> (m_count) + n;
+      m_meanCurr = m_meanPrev + delta * n / count;
+      m_sCurr    = m_sPrev + s + delta * delta * m_count * n / count;
+    }
+  m_count       += n;
+  m_total       += total;
+  m_squareTotal += squareTotal;
+  m_varianceCurr = (m_count > 1) ? m_sCurr / (m_count - 1) : 0;
+}
+
 template <typename T>
 void
 MinMaxAvgTotalCalculator<T>::Reset ()
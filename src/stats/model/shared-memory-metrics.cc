@@ -0,0 +1,527 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/uinteger.h"
+#include "ns3/get-wildcard-matches.h"
+#include "shared-memory-metrics.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedMemoryMetrics");
+
+NS_OBJECT_ENSURE_REGISTERED (SharedMemoryMetrics);
+
+namespace {
+
+/**
+ * \ingroup stats
+ * Layout of the start of a metrics file.  It is followed by MaxMetrics
+ * names of NAME_LENGTH bytes, then by RingSize snapshots.
+ */
+struct MetricsHeader
+{
+  char magic[8];          //!< "NS3METRC"
+  uint32_t version;       //!< Layout version
+  uint32_t maxMetrics;    //!< Number of metric slots
+  uint32_t ringSize;      //!< Number of snapshots in the ring
+  volatile uint32_t count; //!< Number of metrics in use
+  volatile uint64_t head; //!< Number of snapshots written
+  uint8_t padding[32];    //!< Padding to 64 bytes
+};
+
+/**
+ * \ingroup stats
+ * Layout of a snapshot, followed by MaxMetrics values.  The sequence
+ * number is odd while the snapshot is being written, and 2 * n once
+ * the n-th snapshot is complete.
+ */
+struct MetricsSnapshot
+{
+  volatile uint64_t sequence; //!< Sequence number
+  int64_t time;               //!< Simulation time, in ns
+  int64_t wallTime;           //!< Wall clock time, in ns
+  uint64_t padding;           //!< Padding to 32 bytes
+};
+
+/// Magic number of metrics files
+const char METRICS_MAGIC[8] = { 'N', 'S', '3', 'M', 'E', 'T', 'R', 'C' };
+/// Layout version of metrics files
+const uint32_t METRICS_VERSION = 1;
+
+/// Identifiers of the built-in metrics
+enum
+{
+  METRIC_TIME = 0,
+  METRIC_EVENTS,
+  METRIC_EVENT_RATE,
+  METRIC_PENDING_EVENTS
+};
+
+/**
+ * \param maxMetrics the number of metric slots
+ * \returns the offset of the first snapshot
+ */
+uint32_t
+GetRingOffset (uint32_t maxMetrics)
+{
+  return sizeof (MetricsHeader) + maxMetrics * SharedMemoryMetrics::NAME_LENGTH;
+}
+
+/**
+ * \param maxMetrics the number of metric slots
+ * \returns the size of a snapshot
+ */
+uint32_t
+GetSnapshotSize (uint32_t maxMetrics)
+{
+  return sizeof (MetricsSnapshot) + maxMetrics * sizeof (double);
+}
+
+/// \returns the monotonic wall clock time, in ns
+int64_t
+GetWallTime (void)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>
+           (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+} // unnamed namespace
+
+TypeId
+SharedMemoryMetrics::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SharedMemoryMetrics")
+    .SetParent<Object> ()
+    .SetGroupName ("Stats")
+    .AddConstructor<SharedMemoryMetrics> ()
+    .AddAttribute ("Interval",
+                   "The simulation time between two snapshots.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&SharedMemoryMetrics::m_interval),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddAttribute ("MaxMetrics",
+                   "The number of metric slots in the file, including the built-in metrics.",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&SharedMemoryMetrics::m_maxMetrics),
+                   MakeUintegerChecker<uint32_t> (4))
+    .AddAttribute ("RingSize",
+                   "The number of snapshots kept in the file.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&SharedMemoryMetrics::m_ringSize),
+                   MakeUintegerChecker<uint32_t> (2))
+  ;
+  return tid;
+}
+
+SharedMemoryMetrics::SharedMemoryMetrics ()
+  : m_map (0),
+    m_mapSize (0),
+    m_fd (-1),
+    m_published (0),
+    m_lastEventCount (0),
+    m_lastWallTime (0)
+{
+  NS_LOG_FUNCTION (this);
+  AddMetric ("time");
+  AddMetric ("events");
+  AddMetric ("events-per-second");
+  AddMetric ("pending-events");
+}
+
+SharedMemoryMetrics::~SharedMemoryMetrics ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SharedMemoryMetrics::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+  for (std::vector<Ptr<Probe> >::iterator i = m_probes.begin (); i != m_probes.end (); ++i)
+    {
+      (*i)->Disable ();
+    }
+  m_probes.clear ();
+  Object::DoDispose ();
+}
+
+void
+SharedMemoryMetrics::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  NS_ABORT_MSG_IF (m_map != 0, "SharedMemoryMetrics::Open(): already open");
+  NS_ABORT_MSG_IF (m_names.size () > m_maxMetrics,
+                   "SharedMemoryMetrics::Open(): more than " << m_maxMetrics << " metrics");
+
+  m_mapSize = GetRingOffset (m_maxMetrics) + m_ringSize * GetSnapshotSize (m_maxMetrics);
+  m_fd = open (filename.c_str (), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  NS_ABORT_MSG_IF (m_fd < 0, "SharedMemoryMetrics::Open(): Unable to Open " << filename);
+  NS_ABORT_MSG_IF (ftruncate (m_fd, m_mapSize) != 0,
+                   "SharedMemoryMetrics::Open(): Unable to resize " << filename);
+  void *map = mmap (0, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  NS_ABORT_MSG_IF (map == MAP_FAILED, "SharedMemoryMetrics::Open(): Unable to map " << filename);
+  m_map = static_cast<uint8_t *> (map);
+
+  MetricsHeader *header = reinterpret_cast<MetricsHeader *> (m_map);
+  header->version = METRICS_VERSION;
+  header->maxMetrics = m_maxMetrics;
+  header->ringSize = m_ringSize;
+  for (uint32_t id = 0; id < m_names.size (); ++id)
+    {
+      WriteName (id);
+    }
+  header->count = static_cast<uint32_t> (m_names.size ());
+  header->head = 0;
+  // Readers check the magic number last
+  std::atomic_thread_fence (std::memory_order_release);
+  std::memcpy (header->magic, METRICS_MAGIC, sizeof (METRICS_MAGIC));
+
+  m_published = 0;
+  m_lastEventCount = Simulator::GetEventCount ();
+  m_lastWallTime = GetWallTime ();
+  m_event = Simulator::Schedule (m_interval, &SharedMemoryMetrics::PeriodicPublish, this);
+}
+
+void
+SharedMemoryMetrics::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_map == 0)
+    {
+      return;
+    }
+  m_event.Cancel ();
+  Publish ();
+  munmap (m_map, m_mapSize);
+  close (m_fd);
+  m_map = 0;
+  m_fd = -1;
+}
+
+void
+SharedMemoryMetrics::WriteName (uint32_t id)
+{
+  char *name = reinterpret_cast<char *> (m_map + sizeof (MetricsHeader) + id * NAME_LENGTH);
+  std::strncpy (name, m_names[id].c_str (), NAME_LENGTH - 1);
+  name[NAME_LENGTH - 1] = 0;
+}
+
+uint32_t
+SharedMemoryMetrics::AddMetric (std::string name)
+{
+  NS_LOG_FUNCTION (this << name);
+  if (name.size () >= NAME_LENGTH)
+    {
+      NS_LOG_WARN ("Metric name \"" << name << "\" truncated to " << NAME_LENGTH - 1 << " characters");
+    }
+  uint32_t id = static_cast<uint32_t> (m_names.size ());
+  m_names.push_back (name);
+  m_values.push_back (0);
+  if (m_map != 0)
+    {
+      NS_ABORT_MSG_IF (id >= m_maxMetrics,
+                       "SharedMemoryMetrics::AddMetric(): more than " << m_maxMetrics << " metrics");
+      WriteName (id);
+      std::atomic_thread_fence (std::memory_order_release);
+      reinterpret_cast<MetricsHeader *> (m_map)->count = id + 1;
+    }
+  return id;
+}
+
+void
+SharedMemoryMetrics::Set (uint32_t id, double value)
+{
+  NS_ASSERT (id < m_values.size ());
+  m_values[id] = value;
+}
+
+void
+SharedMemoryMetrics::Add (uint32_t id, double value)
+{
+  NS_ASSERT (id < m_values.size ());
+  m_values[id] += value;
+}
+
+double
+SharedMemoryMetrics::Get (uint32_t id) const
+{
+  NS_ASSERT (id < m_values.size ());
+  return m_values[id];
+}
+
+uint32_t
+SharedMemoryMetrics::GetNMetrics (void) const
+{
+  return static_cast<uint32_t> (m_names.size ());
+}
+
+void
+SharedMemoryMetrics::Publish (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_map == 0)
+    {
+      return;
+    }
+  int64_t wallTime = GetWallTime ();
+  uint64_t eventCount = Simulator::GetEventCount ();
+  m_values[METRIC_TIME] = Simulator::Now ().GetSeconds ();
+  m_values[METRIC_EVENTS] = static_cast<double> (eventCount);
+  if (wallTime > m_lastWallTime)
+    {
+      m_values[METRIC_EVENT_RATE] = (eventCount - m_lastEventCount) * 1e9 / (wallTime - m_lastWallTime);
+      m_lastEventCount = eventCount;
+      m_lastWallTime = wallTime;
+    }
+  m_values[METRIC_PENDING_EVENTS] = Simulator::GetPendingEventCount ();
+
+  MetricsHeader *header = reinterpret_cast<MetricsHeader *> (m_map);
+  uint8_t *slot = m_map + GetRingOffset (m_maxMetrics)
+    + (m_published % m_ringSize) * GetSnapshotSize (m_maxMetrics);
+  MetricsSnapshot *snapshot = reinterpret_cast<MetricsSnapshot *> (slot);
+  ++m_published;
+
+  snapshot->sequence = 2 * m_published - 1;
+  std::atomic_thread_fence (std::memory_order_release);
+  snapshot->time = Simulator::Now ().GetNanoSeconds ();
+  snapshot->wallTime = wallTime;
+  std::memcpy (slot + sizeof (MetricsSnapshot), &m_values[0],
+               std::min<uint32_t> (m_values.size (), m_maxMetrics) * sizeof (double));
+  std::atomic_thread_fence (std::memory_order_release);
+  snapshot->sequence = 2 * m_published;
+  header->head = m_published;
+}
+
+void
+SharedMemoryMetrics::PeriodicPublish (void)
+{
+  NS_LOG_FUNCTION (this);
+  Publish ();
+  // Do not keep the simulation running once every other event is gone
+  if (Simulator::GetPendingEventCount () > 0)
+    {
+      m_event = Simulator::Schedule (m_interval, &SharedMemoryMetrics::PeriodicPublish, this);
+    }
+}
+
+template <typename T>
+void
+SharedMemoryMetrics::ProbeSink (SharedMemoryMetrics *metrics, uint32_t id, enum MetricType type,
+                                T oldValue, T newValue)
+{
+  switch (type)
+    {
+    case GAUGE:
+      metrics->Set (id, newValue);
+      break;
+    case COUNTER:
+      metrics->Add (id, newValue);
+      break;
+    case EVENT_COUNTER:
+      metrics->Add (id, 1);
+      break;
+    }
+}
+
+void
+SharedMemoryMetrics::AddProbe (const std::string &typeId,
+                               const std::string &path,
+                               const std::string &probeTraceSource,
+                               const std::string &name,
+                               enum MetricType type)
+{
+  NS_LOG_FUNCTION (this << typeId << path << probeTraceSource << name << type);
+
+  if (path.find ("*") == std::string::npos)
+    {
+      ConnectProbe (typeId, path, probeTraceSource, name, type);
+      return;
+    }
+
+  // Match the traced objects, i.e., the path without the trace source
+  size_t lastSlash = path.find_last_of ("/");
+  std::string lastToken = path.substr (lastSlash + 1);
+  Config::MatchContainer matches = Config::LookupMatches (path.substr (0, lastSlash));
+  NS_ABORT_MSG_IF (matches.GetN () == 0, "Lookup of " << path << " got no matches");
+  for (uint32_t i = 0; i < matches.GetN (); ++i)
+    {
+      std::string matchedPath = matches.GetMatchedPath (i) + lastToken;
+      ConnectProbe (typeId, matchedPath, probeTraceSource,
+                    name + "[" + GetWildcardMatches (path, matchedPath, " ") + "]", type);
+    }
+}
+
+void
+SharedMemoryMetrics::ConnectProbe (const std::string &typeId,
+                                   const std::string &path,
+                                   const std::string &probeTraceSource,
+                                   const std::string &name,
+                                   enum MetricType type)
+{
+  NS_LOG_FUNCTION (this << typeId << path << probeTraceSource << name << type);
+
+  m_factory.SetTypeId (typeId);
+  Ptr<Probe> probe = m_factory.Create ()->GetObject<Probe> ();
+  NS_ABORT_MSG_IF (probe == 0, "The requested type is not a probe");
+  probe->ConnectByPath (path);
+  probe->Enable ();
+
+  uint32_t id = AddMetric (name);
+  bool connected;
+  if (typeId == "ns3::DoubleProbe" || typeId == "ns3::TimeProbe")
+    {
+      connected = probe->TraceConnectWithoutContext
+          (probeTraceSource, MakeBoundCallback (&SharedMemoryMetrics::ProbeSink<double>, this, id, type));
+    }
+  else if (typeId == "ns3::BooleanProbe")
+    {
+      connected = probe->TraceConnectWithoutContext
+          (probeTraceSource, MakeBoundCallback (&SharedMemoryMetrics::ProbeSink<bool>, this, id, type));
+    }
+  else if (typeId == "ns3::Uinteger8Probe")
+    {
+      connected = probe->TraceConnectWithoutContext
+          (probeTraceSource, MakeBoundCallback (&SharedMemoryMetrics::ProbeSink<uint8_t>, this, id, type));
+    }
+  else if (typeId == "ns3::Uinteger16Probe")
+    {
+      connected = probe->TraceConnectWithoutContext
+          (probeTraceSource, MakeBoundCallback (&SharedMemoryMetrics::ProbeSink<uint16_t>, this, id, type));
+    }
+  else
+    {
+      // Uinteger32Probe, and the "OutputBytes" trace source of the packet probes
+      connected = probe->TraceConnectWithoutContext
+          (probeTraceSource, MakeBoundCallback (&SharedMemoryMetrics::ProbeSink<uint32_t>, this, id, type));
+    }
+  NS_ABORT_MSG_UNLESS (connected, "Unable to connect to " << typeId << " trace source " << probeTraceSource);
+  m_probes.push_back (probe);
+}
+
+
+SharedMemoryMetricsReader::SharedMemoryMetricsReader (std::string filename)
+  : m_map (0),
+    m_mapSize (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      return;
+    }
+  struct stat st;
+  if (fstat (fd, &st) == 0 && st.st_size >= static_cast<off_t> (sizeof (MetricsHeader)))
+    {
+      void *map = mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (map != MAP_FAILED)
+        {
+          m_map = static_cast<const uint8_t *> (map);
+          m_mapSize = static_cast<uint32_t> (st.st_size);
+        }
+    }
+  close (fd);
+}
+
+SharedMemoryMetricsReader::~SharedMemoryMetricsReader ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_map != 0)
+    {
+      munmap (const_cast<uint8_t *> (m_map), m_mapSize);
+    }
+}
+
+bool
+SharedMemoryMetricsReader::Fail (void) const
+{
+  if (m_map == 0)
+    {
+      return true;
+    }
+  const MetricsHeader *header = reinterpret_cast<const MetricsHeader *> (m_map);
+  std::atomic_thread_fence (std::memory_order_acquire);
+  return std::memcmp (header->magic, METRICS_MAGIC, sizeof (METRICS_MAGIC)) != 0
+         || header->version != METRICS_VERSION
+         || GetRingOffset (header->maxMetrics)
+    + static_cast<uint64_t> (header->ringSize) * GetSnapshotSize (header->maxMetrics) > m_mapSize;
+}
+
+bool
+SharedMemoryMetricsReader::Read (Snapshot &snapshot) const
+{
+  NS_LOG_FUNCTION (this);
+  if (Fail ())
+    {
+      return false;
+    }
+  const MetricsHeader *header = reinterpret_cast<const MetricsHeader *> (m_map);
+  uint32_t maxMetrics = header->maxMetrics;
+  while (true)
+    {
+      uint64_t head = header->head;
+      uint32_t count = header->count;
+      count = std::min (count, maxMetrics);
+      std::atomic_thread_fence (std::memory_order_acquire);
+      if (head == 0)
+        {
+          return false;
+        }
+      const uint8_t *slot = m_map + GetRingOffset (maxMetrics)
+        + ((head - 1) % header->ringSize) * GetSnapshotSize (maxMetrics);
+      const MetricsSnapshot *data = reinterpret_cast<const MetricsSnapshot *> (slot);
+
+      uint64_t sequence = data->sequence;
+      std::atomic_thread_fence (std::memory_order_acquire);
+      snapshot.sequence = head;
+      snapshot.time = data->time / 1e9;
+      snapshot.wallTime = data->wallTime;
+      snapshot.values.resize (count);
+      if (count > 0)
+        {
+          std::memcpy (&snapshot.values[0], slot + sizeof (MetricsSnapshot), count * sizeof (double));
+        }
+      std::atomic_thread_fence (std::memory_order_acquire);
+      if (sequence != 2 * head || data->sequence != sequence)
+        {
+          // The writer overwrote this snapshot while we copied it
+          continue;
+        }
+
+      snapshot.names.resize (count);
+      for (uint32_t id = 0; id < count; ++id)
+        {
+          const char *name = reinterpret_cast<const char *> (m_map + sizeof (MetricsHeader)
+                                                             + id * SharedMemoryMetrics::NAME_LENGTH);
+          snapshot.names[id] = std::string (name, strnlen (name, SharedMemoryMetrics::NAME_LENGTH));
+        }
+      return true;
+    }
+}
+
+} // namespace ns3
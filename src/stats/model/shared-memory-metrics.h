@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SHARED_MEMORY_METRICS_H
+#define SHARED_MEMORY_METRICS_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/object-factory.h"
+#include "ns3/probe.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Export live counters and gauges of a running simulation
+ * through a memory-mapped file.
+ *
+ * The simulation thread updates the metrics in private memory, which
+ * costs a store per update.  Every Interval of simulation time, the
+ * current values are copied into the next slot of a ring of snapshots
+ * in the mapped file, so that an external process can poll them (see
+ * SharedMemoryMetricsReader and utils/print-live-metrics.cc) without
+ * any locking nor system call on the simulation side.  Each snapshot
+ * is guarded by a sequence number, which a reader uses to detect
+ * snapshots which were being overwritten while it copied them.
+ *
+ * The following metrics are always exported:
+ *  - "time": the simulation time, in seconds;
+ *  - "events": the number of events executed so far;
+ *  - "events-per-second": the number of events executed per second of
+ *    wall clock time since the previous snapshot;
+ *  - "pending-events": the number of events in the scheduler.
+ *
+ * Other metrics are added with AddMetric() and updated with Set() and
+ * Add(), or fed by a Probe connected to a trace source with AddProbe(),
+ * e.g., the QueueDisc "PacketsInQueue" trace source through an
+ * ns3::Uinteger32Probe, or the NetDevice "MacTx" trace source through
+ * an ns3::PacketProbe.
+ *
+ * The periodic snapshot event is not rescheduled once it is the last
+ * event left, so it does not keep an otherwise finished simulation
+ * running.  A final snapshot is written when the object is disposed.
+ */
+class SharedMemoryMetrics : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  SharedMemoryMetrics ();
+  virtual ~SharedMemoryMetrics ();
+
+  /// How the values emitted by a probe update a metric
+  enum MetricType
+  {
+    GAUGE,        //!< The metric is the last value
+    COUNTER,      //!< The metric is the sum of the values
+    EVENT_COUNTER //!< The metric is the number of values
+  };
+
+  /// Maximum length of a metric name, including the terminating null
+  static const uint32_t NAME_LENGTH = 48;
+
+  /**
+   * Create the file and schedule the first snapshot.
+   *
+   * The size of the file is set by the MaxMetrics and RingSize
+   * attributes; any existing file is overwritten.
+   * \param filename the name of the file
+   */
+  void Open (std::string filename);
+
+  /**
+   * Write a final snapshot and unmap the file.
+   */
+  void Close (void);
+
+  /**
+   * \param name the name of the metric
+   * \returns the identifier of the new metric
+   */
+  uint32_t AddMetric (std::string name);
+
+  /**
+   * \param id the metric identifier
+   * \param value the new value of the metric
+   */
+  void Set (uint32_t id, double value);
+
+  /**
+   * \param id the metric identifier
+   * \param value the value to add to the metric
+   */
+  void Add (uint32_t id, double value = 1);
+
+  /**
+   * \param id the metric identifier
+   * \returns the current value of the metric
+   */
+  double Get (uint32_t id) const;
+
+  /**
+   * \returns the number of metrics, including the built-in ones
+   */
+  uint32_t GetNMetrics (void) const;
+
+  /**
+   * Feed metrics from a trace source through a probe.
+   *
+   * If the path has wildcards, one probe and one metric are created per
+   * match, named after the wildcard matches, e.g. "tx[0 1]" for node 0,
+   * device 1.
+   *
+   * \param typeId the type of probe, e.g. "ns3::Uinteger32Probe"
+   * \param path the config path of the trace source to probe
+   * \param probeTraceSource the probe trace source to use, e.g. "Output"
+   * \param name the name of the metric
+   * \param type how the probed values update the metric
+   */
+  void AddProbe (const std::string &typeId,
+                 const std::string &path,
+                 const std::string &probeTraceSource,
+                 const std::string &name,
+                 enum MetricType type);
+
+  /**
+   * Write a snapshot of the current values now.
+   */
+  void Publish (void);
+
+private:
+  virtual void DoDispose (void);
+
+  /// Periodic snapshot event
+  void PeriodicPublish (void);
+
+  /**
+   * Create a probe and connect it to a metric.
+   * \param typeId the type of probe
+   * \param path the config path without wildcards
+   * \param probeTraceSource the probe trace source
+   * \param name the name of the metric
+   * \param type how the probed values update the metric
+   */
+  void ConnectProbe (const std::string &typeId,
+                     const std::string &path,
+                     const std::string &probeTraceSource,
+                     const std::string &name,
+                     enum MetricType type);
+
+  /**
+   * Update a metric from a probe.
+   * \param metrics the metrics object
+   * \param id the metric identifier
+   * \param type how the value updates the metric
+   * \param oldValue the previous value emitted by the probe
+   * \param newValue the value emitted by the probe
+   */
+  template <typename T>
+  static void ProbeSink (SharedMemoryMetrics *metrics, uint32_t id, enum MetricType type,
+                         T oldValue, T newValue);
+
+  /// Write the name of a metric into the mapped file
+  void WriteName (uint32_t id);
+
+  Time m_interval;            //!< Simulation time between snapshots
+  uint32_t m_maxMetrics;      //!< Number of metric slots in the file
+  uint32_t m_ringSize;        //!< Number of snapshots in the ring
+  std::vector<std::string> m_names; //!< Metric names
+  std::vector<double> m_values;     //!< Current metric values
+  uint8_t *m_map;             //!< Start of the mapped file
+  uint32_t m_mapSize;         //!< Size of the mapped file
+  int m_fd;                   //!< File descriptor of the mapped file
+  uint64_t m_published;       //!< Number of snapshots written
+  uint64_t m_lastEventCount;  //!< Event count at the previous snapshot
+  int64_t m_lastWallTime;     //!< Wall clock time at the previous snapshot, in ns
+  EventId m_event;            //!< Next snapshot event
+  ObjectFactory m_factory;    //!< Probe factory
+  std::vector<Ptr<Probe> > m_probes; //!< Probes feeding the metrics
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Read the snapshots written by SharedMemoryMetrics, possibly
+ * from another process.
+ */
+class SharedMemoryMetricsReader
+{
+public:
+  /// A consistent copy of the metrics at some point in time
+  struct Snapshot
+  {
+    uint64_t sequence;              //!< Snapshot number, from 1
+    double time;                    //!< Simulation time, in seconds
+    int64_t wallTime;               //!< Wall clock time of the snapshot, in ns
+    std::vector<std::string> names; //!< Metric names
+    std::vector<double> values;     //!< Metric values
+  };
+
+  /**
+   * Map the file read-only.
+   * \param filename the name of the file written by SharedMemoryMetrics
+   */
+  SharedMemoryMetricsReader (std::string filename);
+  ~SharedMemoryMetricsReader ();
+
+  /**
+   * \returns true if the file could not be mapped or is not a metrics file
+   */
+  bool Fail (void) const;
+
+  /**
+   * Copy the latest snapshot.
+   * \param snapshot the snapshot to fill
+   * \returns false if no snapshot was written yet
+   */
+  bool Read (Snapshot &snapshot) const;
+
+private:
+  const uint8_t *m_map; //!< Start of the mapped file
+  uint32_t m_mapSize;   //!< Size of the mapped file
+};
+
+} // namespace ns3
+
+#endif /* SHARED_MEMORY_METRICS_H */
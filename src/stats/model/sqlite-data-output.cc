@@ -24,6 +24,7 @@
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 #include "data-collector.h"
 #include "data-calculator.h"
@@ -36,6 +37,9 @@ NS_LOG_COMPONENT_DEFINE ("SqliteDataOutput");
 //--------------------------------------------------------------
 //----------------------------------------------
 SqliteDataOutput::SqliteDataOutput()
+  : m_db (0),
+    m_insertTimeSeriesStatement (0),
+    m_pendingRows (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -52,7 +56,14 @@ SqliteDataOutput::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SqliteDataOutput")
     .SetParent<DataOutputInterface> ()
     .SetGroupName ("Stats")
-    .AddConstructor<SqliteDataOutput> ();
+    .AddConstructor<SqliteDataOutput> ()
+    .AddAttribute ("BatchSize",
+                   "The number of streamed time series rows written "
+                   "to the database in each transaction.",
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&SqliteDataOutput::m_batchSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
   return tid;
 }
   
@@ -61,6 +72,7 @@ SqliteDataOutput::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  Close ();
   DataOutputInterface::DoDispose ();
   // end SqliteDataOutput::DoDispose
 }
@@ -110,11 +122,14 @@ SqliteDataOutput::Exec (std::string exe) {
   // end SqliteDataOutput::Exec
 }
 
-//----------------------------------------------
-void
-SqliteDataOutput::Output (DataCollector &dc)
+bool
+SqliteDataOutput::Open (void)
 {
-  NS_LOG_FUNCTION (this << &dc);
+  NS_LOG_FUNCTION (this);
+
+  if (m_db != 0) {
+      return true;
+    }
 
   std::string m_dbFile = m_filePrefix + ".db";
 
@@ -122,7 +137,98 @@ SqliteDataOutput::Output (DataCollector &dc)
       NS_LOG_ERROR ("Could not open sqlite3 database \"" << m_dbFile << "\"");
       NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
       sqlite3_close (m_db);
+      m_db = 0;
       /// \todo Better error reporting, management!
+      return false;
+    }
+
+  // Everything is written within one transaction, committed by Close
+  // (and, for streamed rows, every BatchSize rows)
+  Exec ("BEGIN");
+  m_pendingRows = 0;
+  return true;
+
+  // end SqliteDataOutput::Open
+}
+
+void
+SqliteDataOutput::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_db == 0) {
+      return;
+    }
+
+  if (m_insertTimeSeriesStatement != 0) {
+      sqlite3_finalize (m_insertTimeSeriesStatement);
+      m_insertTimeSeriesStatement = 0;
+    }
+  Exec ("COMMIT");
+  sqlite3_close (m_db);
+  m_db = 0;
+
+  // end SqliteDataOutput::Close
+}
+
+void
+SqliteDataOutput::StartStreaming (const DataCollector &dc)
+{
+  NS_LOG_FUNCTION (this << &dc);
+
+  if (!Open ()) {
+      return;
+    }
+
+  Exec ("create table if not exists TimeSeries (run text, name text, time real, value real)");
+
+  if (m_insertTimeSeriesStatement != 0) {
+      sqlite3_finalize (m_insertTimeSeriesStatement);
+    }
+  sqlite3_prepare_v2 (m_db,
+    "insert into TimeSeries (run, name, time, value) values (?, ?, ?, ?)",
+    -1,
+    &m_insertTimeSeriesStatement,
+    NULL
+  );
+  std::string run = dc.GetRunLabel ();
+  sqlite3_bind_text (m_insertTimeSeriesStatement, 1, run.c_str (), run.length (), SQLITE_TRANSIENT);
+
+  // end SqliteDataOutput::StartStreaming
+}
+
+void
+SqliteDataOutput::OutputTimeSeries (std::string name, double time, double value)
+{
+  NS_LOG_FUNCTION (this << name << time << value);
+
+  if (m_insertTimeSeriesStatement == 0) {
+      NS_LOG_WARN ("Time series row dropped: StartStreaming has not been called");
+      return;
+    }
+
+  sqlite3_reset (m_insertTimeSeriesStatement);
+  sqlite3_bind_text (m_insertTimeSeriesStatement, 2, name.c_str (), name.length (), SQLITE_TRANSIENT);
+  sqlite3_bind_double (m_insertTimeSeriesStatement, 3, time);
+  sqlite3_bind_double (m_insertTimeSeriesStatement, 4, value);
+  sqlite3_step (m_insertTimeSeriesStatement);
+
+  if (++m_pendingRows >= m_batchSize) {
+      Exec ("COMMIT");
+      Exec ("BEGIN");
+      m_pendingRows = 0;
+    }
+
+  // end SqliteDataOutput::OutputTimeSeries
+}
+
+//----------------------------------------------
+void
+SqliteDataOutput::Output (DataCollector &dc)
+{
+  NS_LOG_FUNCTION (this << &dc);
+
+  if (!Open ()) {
       return;
     }
 
@@ -172,15 +278,15 @@ SqliteDataOutput::Output (DataCollector &dc)
     }
   sqlite3_finalize (stmt);
 
-  Exec ("BEGIN");
-  SqliteOutputCallback callback (this, run);
-  for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
-       i != dc.DataCalculatorEnd (); i++) {
-      (*i)->Output (callback);
-    }
-  Exec ("COMMIT");
+  {
+    SqliteOutputCallback callback (this, run);
+    for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
+         i != dc.DataCalculatorEnd (); i++) {
+        (*i)->Output (callback);
+      }
+  }
 
-  sqlite3_close (m_db);
+  Close ();
 
   // end SqliteDataOutput::Output
 }
@@ -37,6 +37,26 @@ namespace ns3 {
  * \ingroup dataoutput
  * \class SqliteDataOutput
  * \brief Outputs data in a format compatible with SQLite
+ *
+ * All the rows written by Output are inserted within a single
+ * transaction, with one prepared statement per table.
+ *
+ * Time series can also be streamed to the database while the
+ * simulation runs, for instance from a TimeSeriesAdaptor fed by a
+ * probe:
+ *
+ * \code
+ *   Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+ *   output->StartStreaming (data);
+ *   adaptor->TraceConnect ("Output", "queue-length",
+ *                          MakeCallback (&SqliteDataOutput::OutputTimeSeries, output));
+ *   Simulator::Run ();
+ *   output->Output (data);
+ * \endcode
+ *
+ * Streamed rows go to the TimeSeries table and are committed every
+ * BatchSize rows.  The final Output call writes the remaining
+ * statistics and closes the database.
  */
 class SqliteDataOutput : public DataOutputInterface {
 public:
@@ -51,6 +71,25 @@ public:
   
   virtual void Output (DataCollector &dc);
 
+  /**
+   * Open the database and start accepting streamed time series rows.
+   * \param dc DataCollector object whose run label is used for the rows
+   */
+  void StartStreaming (const DataCollector &dc);
+
+  /**
+   * Append a row to the TimeSeries table.
+   *
+   * The signature matches the TimeSeriesAdaptor Output trace source
+   * when it is connected with a context, the context being used as the
+   * name of the series.
+   *
+   * \param name the name of the time series
+   * \param time the time of the sample, in seconds
+   * \param value the value of the sample
+   */
+  void OutputTimeSeries (std::string name, double time, double value);
+
 protected:
   virtual void DoDispose ();
 
@@ -144,6 +183,9 @@ private:
 
 
   sqlite3 *m_db; //!< pointer to the SQL database
+  sqlite3_stmt *m_insertTimeSeriesStatement; //!< Prepared time series insert statement
+  uint32_t m_batchSize; //!< Number of streamed rows per transaction
+  uint32_t m_pendingRows; //!< Streamed rows in the current transaction
 
   /**
    * \brief Execute a sqlite3 query
@@ -152,6 +194,17 @@ private:
    */
   int Exec (std::string exe);
 
+  /**
+   * \brief Open the database, if not already open, and begin a transaction
+   * \return true if the database is open
+   */
+  bool Open (void);
+
+  /**
+   * \brief Commit the current transaction and close the database
+   */
+  void Close (void);
+
   // end class SqliteDataOutput
 };
 
@@ -22,6 +22,7 @@
 
 #include "ns3/test.h"
 #include "ns3/basic-data-calculators.h"
+#include "ns3/average.h"
 
 using namespace ns3;
 
@@ -240,6 +241,74 @@ FiveDoublesTestCase::DoRun (void)
 }
 
 
+// ===========================================================================
+// Test case for batches of doubles.
+// ===========================================================================
+
+class BatchDoublesTestCase : public TestCase
+{
+public:
+  BatchDoublesTestCase ();
+  virtual ~BatchDoublesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BatchDoublesTestCase::BatchDoublesTestCase ()
+  : TestCase ("Basic Statistical Functions using Batches of Doubles")
+
+{
+}
+
+BatchDoublesTestCase::~BatchDoublesTestCase ()
+{
+}
+
+void
+BatchDoublesTestCase::DoRun (void)
+{
+  MinMaxAvgTotalCalculator<double> calculator;
+  MinMaxAvgTotalCalculator<double> batchCalculator;
+  Average<double> average;
+  Average<double> batchAverage;
+
+  // Batches of different sizes, the first one with a single value.
+  std::vector<double> values;
+  uint32_t batchSizes[] = { 1, 7, 100, 1000 };
+  for (uint32_t b = 0; b < 4; b++)
+    {
+      values.clear ();
+      for (uint32_t i = 0; i < batchSizes[b]; i++)
+        {
+          double value = 1000 + std::sin (values.size () + 10.0 * b) * (b + 1);
+          values.push_back (value);
+          calculator.Update (value);
+          average.Update (value);
+        }
+      batchCalculator.UpdateBatch (&values[0], values.size ());
+      batchAverage.UpdateBatch (&values[0], values.size ());
+    }
+  // An empty batch changes nothing.
+  batchCalculator.UpdateBatch (&values[0], 0);
+
+  double tolerance = 1e-9;
+  NS_TEST_ASSERT_MSG_EQ (batchCalculator.getCount (), calculator.getCount (), "Count value wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchCalculator.getSum (), calculator.getSum (), tolerance, "Sum value wrong");
+  NS_TEST_ASSERT_MSG_EQ (batchCalculator.getMin (), calculator.getMin (), "Min value wrong");
+  NS_TEST_ASSERT_MSG_EQ (batchCalculator.getMax (), calculator.getMax (), "Max value wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchCalculator.getMean (), calculator.getMean (), tolerance, "Mean value wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchCalculator.getVariance (), calculator.getVariance (), tolerance, "Variance value wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchCalculator.getSqrSum (), calculator.getSqrSum (), 1e-6, "SqrSum value wrong");
+
+  NS_TEST_ASSERT_MSG_EQ (batchAverage.Count (), average.Count (), "Average count wrong");
+  NS_TEST_ASSERT_MSG_EQ (batchAverage.Min (), average.Min (), "Average min wrong");
+  NS_TEST_ASSERT_MSG_EQ (batchAverage.Max (), average.Max (), "Average max wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchAverage.Avg (), average.Avg (), tolerance, "Average mean wrong");
+  NS_TEST_ASSERT_MSG_EQ_TOL (batchAverage.Var (), average.Var (), tolerance, "Average variance wrong");
+}
+
+
 class BasicDataCalculatorsTestSuite : public TestSuite
 {
 public:
@@ -252,6 +321,7 @@ BasicDataCalculatorsTestSuite::BasicDataCalculatorsTestSuite ()
   AddTestCase (new OneIntegerTestCase, TestCase::QUICK);
   AddTestCase (new FiveIntegersTestCase, TestCase::QUICK);
   AddTestCase (new FiveDoublesTestCase, TestCase::QUICK);
+  AddTestCase (new BatchDoublesTestCase, TestCase::QUICK);
 }
 
 static BasicDataCalculatorsTestSuite basicDataCalculatorsTestSuite;
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/names.h"
+#include "ns3/uinteger.h"
+#include "ns3/double-probe.h"
+#include "ns3/shared-memory-metrics.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Update metrics directly and through probes, and read the
+ * snapshots back through the mapped file.
+ */
+class SharedMemoryMetricsTestCase : public TestCase
+{
+public:
+  SharedMemoryMetricsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the latest snapshot while the simulation runs.
+   * \param filename the metrics file
+   */
+  void CheckSnapshot (std::string filename);
+
+  /**
+   * \param snapshot the snapshot
+   * \param name the name of a metric
+   * \returns the value of the metric, or -1 if not found
+   */
+  double GetValue (const SharedMemoryMetricsReader::Snapshot &snapshot, std::string name);
+
+  Ptr<SharedMemoryMetrics> m_metrics; //!< The metrics under test
+  uint32_t m_custom;                  //!< Custom metric
+  uint32_t m_checks;                  //!< Number of snapshots checked
+};
+
+SharedMemoryMetricsTestCase::SharedMemoryMetricsTestCase ()
+  : TestCase ("Check that metrics are exported through the shared memory file"),
+    m_checks (0)
+{
+}
+
+double
+SharedMemoryMetricsTestCase::GetValue (const SharedMemoryMetricsReader::Snapshot &snapshot, std::string name)
+{
+  for (uint32_t i = 0; i < snapshot.names.size (); ++i)
+    {
+      if (snapshot.names[i] == name)
+        {
+          return snapshot.values[i];
+        }
+    }
+  return -1;
+}
+
+void
+SharedMemoryMetricsTestCase::CheckSnapshot (std::string filename)
+{
+  SharedMemoryMetricsReader reader (filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.Fail (), false, "Unable to map " << filename);
+  SharedMemoryMetricsReader::Snapshot snapshot;
+  NS_TEST_ASSERT_MSG_EQ (reader.Read (snapshot), true, "No snapshot");
+  // Snapshots are taken every second, and checked half a second later
+  NS_TEST_EXPECT_MSG_EQ (snapshot.sequence, m_checks + 1, "Unexpected snapshot number");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snapshot.time, Simulator::Now ().GetSeconds () - 0.5, 1e-9, "Unexpected time");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "custom"), m_checks + 1, "Unexpected custom metric");
+  NS_TEST_EXPECT_MSG_GT (GetValue (snapshot, "pending-events"), 0, "Unexpected pending events");
+  ++m_checks;
+}
+
+void
+SharedMemoryMetricsTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("metrics.shm");
+
+  Ptr<DoubleProbe> source = CreateObject<DoubleProbe> ();
+  Names::Add ("MetricsSource", source);
+
+  m_metrics = CreateObject<SharedMemoryMetrics> ();
+  m_metrics->SetAttribute ("MaxMetrics", UintegerValue (8));
+  m_metrics->SetAttribute ("RingSize", UintegerValue (4));
+  m_custom = m_metrics->AddMetric ("custom");
+  m_metrics->AddProbe ("ns3::DoubleProbe", "/Names/MetricsSource/Output", "Output",
+                       "gauge", SharedMemoryMetrics::GAUGE);
+  m_metrics->AddProbe ("ns3::DoubleProbe", "/Names/MetricsSource/Output", "Output",
+                       "counter", SharedMemoryMetrics::COUNTER);
+  m_metrics->AddProbe ("ns3::DoubleProbe", "/Names/MetricsSource/Output", "Output",
+                       "samples", SharedMemoryMetrics::EVENT_COUNTER);
+  NS_TEST_EXPECT_MSG_EQ (m_metrics->GetNMetrics (), 8, "Unexpected number of metrics");
+  m_metrics->Open (filename);
+
+  const uint32_t nSeconds = 10;
+  for (uint32_t i = 0; i < nSeconds; ++i)
+    {
+      Simulator::Schedule (Seconds (i + 0.25), &SharedMemoryMetrics::Add, m_metrics, m_custom, 1.0);
+      Simulator::Schedule (Seconds (i + 0.25), &DoubleProbe::SetValue, source, i + 1.0);
+      Simulator::Schedule (Seconds (i + 1.5), &SharedMemoryMetricsTestCase::CheckSnapshot, this, filename);
+    }
+  Simulator::Run ();
+
+  // The snapshot event must not keep the simulation running
+  NS_TEST_EXPECT_MSG_EQ (m_checks, nSeconds, "Unexpected number of checks");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (nSeconds + 1), "Simulation kept running");
+
+  // Disposing the metrics writes a final snapshot
+  m_metrics->Dispose ();
+  SharedMemoryMetricsReader reader (filename);
+  SharedMemoryMetricsReader::Snapshot snapshot;
+  NS_TEST_ASSERT_MSG_EQ (reader.Read (snapshot), true, "No snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshot.names.size (), 8, "Unexpected number of metrics");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "custom"), nSeconds, "Unexpected custom metric");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "gauge"), nSeconds, "Unexpected gauge");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "counter"), nSeconds * (nSeconds + 1) / 2, "Unexpected counter");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "samples"), nSeconds, "Unexpected sample count");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "events"), Simulator::GetEventCount (), "Unexpected event count");
+  NS_TEST_EXPECT_MSG_EQ (GetValue (snapshot, "time"), Simulator::Now ().GetSeconds (), "Unexpected time");
+
+  Simulator::Destroy ();
+  Names::Clear ();
+  m_metrics = 0;
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SharedMemoryMetrics TestSuite
+ */
+class SharedMemoryMetricsTestSuite : public TestSuite
+{
+public:
+  SharedMemoryMetricsTestSuite ();
+};
+
+SharedMemoryMetricsTestSuite::SharedMemoryMetricsTestSuite ()
+  : TestSuite ("shared-memory-metrics", UNIT)
+{
+  AddTestCase (new SharedMemoryMetricsTestCase, TestCase::QUICK);
+}
+
+static SharedMemoryMetricsTestSuite g_sharedMemoryMetricsTestSuite; //!< Static variable for test initialization
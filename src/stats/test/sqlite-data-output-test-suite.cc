@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sqlite3.h>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-collector.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/time-series-adaptor.h"
+#include "ns3/sqlite-data-output.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Stream time series rows to a SqliteDataOutput, then write the
+ * statistics of a DataCollector, and read the database back.
+ */
+class SqliteDataOutputTestCase : public TestCase
+{
+public:
+  SqliteDataOutputTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run a single-value SQL query.
+   * \param db the database
+   * \param query the query
+   * \returns the value of the first column of the first row
+   */
+  double Query (sqlite3 *db, std::string query);
+};
+
+SqliteDataOutputTestCase::SqliteDataOutputTestCase ()
+  : TestCase ("Check batched and streamed SqliteDataOutput rows")
+{
+}
+
+double
+SqliteDataOutputTestCase::Query (sqlite3 *db, std::string query)
+{
+  sqlite3_stmt *stmt;
+  double value = -1;
+  if (sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, NULL) == SQLITE_OK)
+    {
+      if (sqlite3_step (stmt) == SQLITE_ROW)
+        {
+          value = sqlite3_column_double (stmt, 0);
+        }
+      sqlite3_finalize (stmt);
+    }
+  return value;
+}
+
+void
+SqliteDataOutputTestCase::DoRun (void)
+{
+  const uint32_t nSamples = 25;
+  std::string prefix = CreateTempDirFilename ("sqlite-data-output");
+
+  DataCollector data;
+  data.DescribeRun ("experiment", "strategy", "input", "run-1");
+
+  Ptr<CounterCalculator<> > counter = CreateObject<CounterCalculator<> > ();
+  counter->SetKey ("counter");
+  counter->SetContext ("node[0]");
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      counter->Update ();
+    }
+  data.AddDataCalculator (counter);
+
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetAttribute ("BatchSize", UintegerValue (7));
+  output->SetFilePrefix (prefix);
+  output->StartStreaming (data);
+
+  Ptr<TimeSeriesAdaptor> adaptor = CreateObject<TimeSeriesAdaptor> ();
+  adaptor->TraceConnect ("Output", "series",
+                         MakeCallback (&SqliteDataOutput::OutputTimeSeries, output));
+  for (uint32_t i = 0; i < nSamples; ++i)
+    {
+      Simulator::Schedule (Seconds (i), &TimeSeriesAdaptor::TraceSinkDouble, adaptor, 0.0, 2.0 * i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  output->Output (data);
+
+  sqlite3 *db;
+  std::string filename = prefix + ".db";
+  NS_TEST_ASSERT_MSG_EQ (sqlite3_open (filename.c_str (), &db), SQLITE_OK, "Unable to open " << filename);
+
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from TimeSeries where run = 'run-1' and name = 'series'"),
+                         nSamples, "Unexpected number of time series rows");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from TimeSeries"),
+                         nSamples * (nSamples - 1), "Unexpected time series values");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select max(time) from TimeSeries"),
+                         nSamples - 1, "Unexpected time series times");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select value from Singletons where run = 'run-1' and name = 'node[0]' and variable = 'counter'"),
+                         3, "Unexpected counter value");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from Experiments where run = 'run-1'"),
+                         1, "Unexpected number of experiments");
+  sqlite3_close (db);
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SqliteDataOutput TestSuite
+ */
+class SqliteDataOutputTestSuite : public TestSuite
+{
+public:
+  SqliteDataOutputTestSuite ();
+};
+
+SqliteDataOutputTestSuite::SqliteDataOutputTestSuite ()
+  : TestSuite ("sqlite-data-output", UNIT)
+{
+  AddTestCase (new SqliteDataOutputTestCase, TestCase::QUICK);
+}
+
+static SqliteDataOutputTestSuite sqliteDataOutputTestSuite; //!< Static variable for test initialization
@@ -216,6 +216,12 @@ VisualSimulatorImpl::GetContext (void) const
   return m_simulator->GetContext ();
 }
 
+uint32_t
+VisualSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_simulator->GetPendingEventCount ();
+}
+
 uint64_t
 VisualSimulatorImpl::GetEventCount (void) const
 {
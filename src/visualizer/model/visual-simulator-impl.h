@@ -72,6 +72,7 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;;
+  virtual uint32_t GetPendingEventCount (void) const;
 
   /// calls Run() in the wrapped simulator
   void RunRealSimulator (void);
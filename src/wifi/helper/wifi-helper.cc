@@ -59,6 +59,12 @@ AsciiPhyTransmitSinkWithContext (
   uint8_t txLevel)
 {
   NS_LOG_FUNCTION (stream << context << p << mode << preamble << txLevel);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('t', context, p);
+      return;
+    }
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << context << " " << mode << " " << *p << std::endl;
 }
 
@@ -79,6 +85,12 @@ AsciiPhyTransmitSinkWithoutContext (
   uint8_t txLevel)
 {
   NS_LOG_FUNCTION (stream << p << mode << preamble << txLevel);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('t', "", p);
+      return;
+    }
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << mode << " " << *p << std::endl;
 }
 
@@ -101,6 +113,12 @@ AsciiPhyReceiveSinkWithContext (
   WifiPreamble preamble)
 {
   NS_LOG_FUNCTION (stream << context << p << snr << mode << preamble);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('r', context, p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << mode << "" << context << " " << *p << std::endl;
 }
 
@@ -121,6 +139,12 @@ AsciiPhyReceiveSinkWithoutContext (
   WifiPreamble preamble)
 {
   NS_LOG_FUNCTION (stream << p << snr << mode << preamble);
+  Ptr<ColumnarTraceFile> columnar = stream->GetColumnarTraceFile ();
+  if (columnar)
+    {
+      columnar->Write ('r', "", p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << mode << " " << *p << std::endl;
 }
 
@@ -290,7 +290,7 @@ ChannelAccessManager::RequestAccess (Ptr<Txop> state, bool isCfPeriod)
     {
       state->NotifyAccessRequested ();
       Time delay = (MostRecent (GetAccessGrantStart (true), Simulator::Now ()) - Simulator::Now ());
-      m_accessTimeout = Simulator::Schedule (delay, &ChannelAccessManager::DoGrantPcfAccess, this, state);
+      m_pcfAccessTimeout = Simulator::Schedule (delay, &ChannelAccessManager::DoGrantPcfAccess, this, state);
       return;
     }
   UpdateBackoff ();
@@ -514,6 +514,11 @@ void
 ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_rxing)
+    {
+      Simulator::Remove (m_accessTimeout);
+      return;
+    }
   /**
    * Is there a Txop which needs to access the medium, and,
    * if there is one, how many slots for AIFS+backoff does it require ?
@@ -539,9 +544,9 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
       NS_LOG_DEBUG ("expected backoff end=" << expectedBackoffEnd);
       Time expectedBackoffDelay = expectedBackoffEnd - Simulator::Now ();
       if (m_accessTimeout.IsRunning ()
-          && Simulator::GetDelayLeft (m_accessTimeout) > expectedBackoffDelay)
+          && Simulator::GetDelayLeft (m_accessTimeout) != expectedBackoffDelay)
         {
-          m_accessTimeout.Cancel ();
+          Simulator::Remove (m_accessTimeout);
         }
       if (m_accessTimeout.IsExpired ())
         {
@@ -549,6 +554,10 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
                                                  &ChannelAccessManager::AccessTimeout, this);
         }
     }
+  else
+    {
+      Simulator::Remove (m_accessTimeout);
+    }
 }
 
 void
@@ -560,6 +569,7 @@ ChannelAccessManager::NotifyRxStartNow (Time duration)
   m_lastRxStart = Simulator::Now ();
   m_lastRxDuration = duration;
   m_rxing = true;
+  DoRestartAccessTimeoutIfNeeded ();
 }
 
 void
@@ -570,6 +580,7 @@ ChannelAccessManager::NotifyRxEndOkNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = true;
   m_rxing = false;
+  DoRestartAccessTimeoutIfNeeded ();
 }
 
 void
@@ -580,6 +591,7 @@ ChannelAccessManager::NotifyRxEndErrorNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = false;
   m_rxing = false;
+  DoRestartAccessTimeoutIfNeeded ();
 }
 
 void
@@ -600,6 +612,7 @@ ChannelAccessManager::NotifyTxStartNow (Time duration)
   UpdateBackoff ();
   m_lastTxStart = Simulator::Now ();
   m_lastTxDuration = duration;
+  DoRestartAccessTimeoutIfNeeded ();
 }
 
 void
@@ -650,6 +663,10 @@ ChannelAccessManager::NotifySwitchingStartNow (Time duration)
     {
       m_accessTimeout.Cancel ();
     }
+  if (m_pcfAccessTimeout.IsRunning ())
+    {
+      m_pcfAccessTimeout.Cancel ();
+    }
 
   //Reset backoffs
   for (States::iterator i = m_states.begin (); i != m_states.end (); i++)
@@ -682,6 +699,10 @@ ChannelAccessManager::NotifySleepNow (void)
     {
       m_accessTimeout.Cancel ();
     }
+  if (m_pcfAccessTimeout.IsRunning ())
+    {
+      m_pcfAccessTimeout.Cancel ();
+    }
 
   //Reset backoffs
   for (States::iterator i = m_states.begin (); i != m_states.end (); i++)
@@ -696,11 +717,23 @@ ChannelAccessManager::NotifyOffNow (void)
 {
   NS_LOG_FUNCTION (this);
   m_off = true;
+  if (m_rxing)
+    {
+      //the PHY is turned off during a reception, whose end is not notified
+      m_lastRxEnd = Simulator::Now ();
+      m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
+      m_lastRxReceivedOk = true;
+      m_rxing = false;
+    }
   //Cancel timeout
   if (m_accessTimeout.IsRunning ())
     {
       m_accessTimeout.Cancel ();
     }
+  if (m_pcfAccessTimeout.IsRunning ())
+    {
+      m_pcfAccessTimeout.Cancel ();
+    }
 
   //Reset backoffs
   for (States::iterator i = m_states.begin (); i != m_states.end (); i++)
@@ -294,6 +294,14 @@ private:
    */
   Time GetBackoffEndFor (Ptr<Txop> state);
 
+  /**
+   * Move the access timeout to the earliest backoff end of the Txops
+   * requesting access, if any.  While the PHY is receiving, no access
+   * timeout is kept: the end of the reception calls this method again.
+   * A timeout made obsolete by a change of the medium is removed from
+   * the scheduler rather than cancelled, so that a single event per
+   * manager is ever pending.
+   */
   void DoRestartAccessTimeoutIfNeeded (void);
 
   /**
@@ -343,6 +351,7 @@ private:
   bool m_off;                   //!< flag whether it is in off state
   Time m_eifsNoDifs;            //!< EIFS no DIFS time
   EventId m_accessTimeout;      //!< the access timeout ID
+  EventId m_pcfAccessTimeout;   //!< the ID of the access timeout during the CFP
   Time m_slot;                  //!< the slot time
   Time m_sifs;                  //!< the SIFS time
   PhyListener* m_phyListener;   //!< the phy listener
@@ -19,6 +19,7 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <algorithm>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -30,6 +31,38 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("InterferenceHelper");
 
+namespace {
+
+/**
+ * Order the NiChanges by time.
+ *
+ * \param a a NiChange
+ * \param moment a time
+ * \return true if the NiChange is earlier than the time
+ */
+template <typename T>
+bool
+IsEarlier (const std::pair<Time, T> &a, const Time &moment)
+{
+  return a.first < moment;
+}
+
+/**
+ * Order the NiChanges by time.
+ *
+ * \param moment a time
+ * \param a a NiChange
+ * \return true if the time is earlier than the NiChange
+ */
+template <typename T>
+bool
+IsLater (const Time &moment, const std::pair<Time, T> &a)
+{
+  return moment < a.first;
+}
+
+} // unnamed namespace
+
 /****************************************************************
  *       Phy event class
  ****************************************************************/
@@ -207,14 +240,25 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
     {
       m_firstPower = previousPowerStart;
       // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
+      m_niChanges.erase (m_niChanges.begin () + 1,
                          GetNextPosition (event->GetStartTime ()));
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  else
+    {
+      // The changes before the start of the signal being received are
+      // no longer looked at: the later signals and the queries start
+      // after it
+      auto end = GetFirstPosition (m_rxStart);
+      if (end > m_niChanges.begin () + 1)
+        {
+          m_niChanges.erase (m_niChanges.begin () + 1, end);
+        }
+    }
+  std::size_t first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
+  std::size_t last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
+  for (std::size_t i = first; i != last; ++i)
     {
-      i->second.AddPower (event->GetRxPowerW ());
+      m_niChanges[i].second.AddPower (event->GetRxPowerW ());
     }
 }
 
@@ -234,20 +278,22 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges::const_iterator *first,
+                                                 NiChanges::const_iterator *last) const
 {
   double noiseInterference = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
+  auto it = GetFirstPosition (event->GetStartTime ());
   for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it)
     {
       noiseInterference = it->second.GetPower ();
     }
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
+  NS_ASSERT_MSG (it != m_niChanges.end (), "Start of the event not found");
+  *first = it;
   while (++it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      ni->insert (*it);
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  NS_ASSERT_MSG (it != m_niChanges.end (), "End of the event not found");
+  *last = it;
   return noiseInterference;
 }
 
@@ -274,12 +320,13 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges::const_iterator first,
+                                             NiChanges::const_iterator last) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
+  auto j = first;
   Time previous = j->first;
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = txVector.GetPreambleType ();
@@ -289,8 +336,9 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
   double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  while (j != last)
     {
+      ++j;
       Time current = j->first;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
@@ -322,12 +370,13 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *
 }
 
 double
-InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges::const_iterator first,
+                                            NiChanges::const_iterator last) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
+  auto j = first;
   Time previous = j->first;
   WifiPreamble preamble = txVector.GetPreambleType ();
   WifiMode mcsHeaderMode;
@@ -353,8 +402,9 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *n
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
   double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  while (j != last)
     {
+      ++j;
       Time current = j->first;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
@@ -739,8 +789,9 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *n
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator first;
+  NiChanges::const_iterator last;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &first, &last);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -748,7 +799,7 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the packet and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpPayloadPer (event, &ni);
+  double per = CalculatePlcpPayloadPer (event, first, last);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -759,8 +810,9 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator first;
+  NiChanges::const_iterator last;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &first, &last);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -768,7 +820,7 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpHeaderPer (event, &ni);
+  double per = CalculatePlcpHeaderPer (event, first, last);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -776,6 +828,29 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
   return snrPer;
 }
 
+void
+InterferenceHelper::CalculateStartSnrPer (Ptr<Event> event, struct SnrPer *header, struct SnrPer *payload) const
+{
+  NiChanges::const_iterator first;
+  NiChanges::const_iterator last;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &first, &last);
+  double snr = CalculateSnr (event->GetRxPowerW (),
+                             noiseInterferenceW,
+                             event->GetTxVector ().GetChannelWidth ());
+
+  /* the error rates are computed over a single chunk, from the start
+   * to the end of the packet
+   */
+  NiChanges changes;
+  changes.push_back (*first);
+  changes.push_back (std::make_pair (event->GetEndTime (), NiChange (first->second.GetPower (), event)));
+
+  header->snr = snr;
+  header->per = CalculatePlcpHeaderPer (event, changes.begin (), changes.begin () + 1);
+  payload->snr = snr;
+  payload->per = CalculatePlcpPayloadPer (event, changes.begin (), changes.begin () + 1);
+}
+
 void
 InterferenceHelper::EraseEvents (void)
 {
@@ -789,7 +864,13 @@ InterferenceHelper::EraseEvents (void)
 InterferenceHelper::NiChanges::const_iterator
 InterferenceHelper::GetNextPosition (Time moment) const
 {
-  return m_niChanges.upper_bound (moment);
+  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), moment, IsLater<NiChange>);
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::GetFirstPosition (Time moment) const
+{
+  return std::lower_bound (m_niChanges.begin (), m_niChanges.end (), moment, IsEarlier<NiChange>);
 }
 
 InterferenceHelper::NiChanges::const_iterator
@@ -802,10 +883,12 @@ InterferenceHelper::GetPreviousPosition (Time moment) const
   return it;
 }
 
-InterferenceHelper::NiChanges::iterator
+std::size_t
 InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
 {
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  // The insertion may reallocate the vector: take begin () after it
+  auto it = m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  return it - m_niChanges.begin ();
 }
 
 void
@@ -813,6 +896,7 @@ InterferenceHelper::NotifyRxStart ()
 {
   NS_LOG_FUNCTION (this);
   m_rxing = true;
+  m_rxStart = Simulator::Now ();
 }
 
 void
@@ -821,7 +905,11 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
+  auto it = GetFirstPosition (Simulator::Now ());
+  if (it != m_niChanges.end () && it->first != Simulator::Now ())
+    {
+      it = m_niChanges.end ();
+    }
   it--;
   m_firstPower = it->second.GetPower ();
 }
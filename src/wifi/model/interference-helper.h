@@ -23,7 +23,7 @@
 
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
-#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -189,6 +189,17 @@ public:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<Event> event) const;
+  /**
+   * Calculate the SNIR at the start of the packet, and the error rates
+   * of the plcp header and of the plcp payload if this SNIR lasted for
+   * the whole packet.  The later signals are ignored, hence the packet
+   * need not have ended.
+   *
+   * \param event the event corresponding to the first time the corresponding packet arrives
+   * \param header set to the SNR and PER of the plcp header
+   * \param payload set to the SNR and PER of the plcp payload
+   */
+  void CalculateStartSnrPer (Ptr<Event> event, struct SnrPer *header, struct SnrPer *payload) const;
 
   /**
    * Notify that RX has started.
@@ -244,9 +255,15 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a list of NiChanges, sorted by time, and in insertion
+   * order for the same time.
+   *
+   * A sorted vector rather than a multimap: a new signal starts now,
+   * after all the recorded changes but those of the signals still on
+   * the air, so inserting its changes only moves these few ones, and
+   * the changes are scanned from contiguous memory.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
 
   /**
    * Append the given Event.
@@ -255,14 +272,17 @@ private:
    */
   void AppendEvent (Ptr<Event> event);
   /**
-   * Calculate noise and interference power in W.
+   * Calculate noise and interference power in W, and find the
+   * NiChanges of the given event.
    *
    * \param event
-   * \param ni
+   * \param first set to the NiChange at the start of the event
+   * \param last set to the NiChange at the end of the event
    *
    * \return noise and interference power
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges::const_iterator *first,
+                                      NiChanges::const_iterator *last) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    * (Mode is not currently used)
@@ -291,21 +311,25 @@ private:
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param first the NiChange at the start of the event
+   * \param last the NiChange at the end of the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges::const_iterator first,
+                                  NiChanges::const_iterator last) const;
   /**
    * Calculate the error rate of the plcp header. The plcp header can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param first the NiChange at the start of the event
+   * \param last the NiChange at the end of the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges::const_iterator first,
+                                 NiChanges::const_iterator last) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
@@ -314,6 +338,7 @@ private:
   NiChanges m_niChanges;
   double m_firstPower; ///< first power
   bool m_rxing; ///< flag whether it is in receiving state
+  Time m_rxStart; ///< start of the signal being received
 
   /**
    * Returns an iterator to the first nichange that is later than moment
@@ -323,12 +348,12 @@ private:
    */
   NiChanges::const_iterator GetNextPosition (Time moment) const;
   /**
-   * Returns an iterator to the first nichange that is later than moment
+   * Returns an iterator to the first nichange that is not earlier than moment
    *
    * \param moment time to check from
    * \returns an iterator to the list of NiChanges
    */
-  //NiChanges::iterator GetNextPosition (Time moment);
+  NiChanges::const_iterator GetFirstPosition (Time moment) const;
   /**
    * Returns an iterator to the last nichange that is before than moment
    *
@@ -339,13 +364,14 @@ private:
 
   /**
    * Add NiChange to the list at the appropriate position and
-   * return the iterator of the new event.
+   * return the position of the new event.  The position, unlike an
+   * iterator, stays valid when NiChanges are added after it.
    *
    * \param moment
    * \param change
-   * \returns the iterator of the new event
+   * \returns the index of the new event in the list
    */
-  NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change);
+  std::size_t AddNiChangeEvent (Time moment, NiChange change);
 };
 
 } //namespace ns3
@@ -2586,7 +2586,7 @@ MacLow::AggregateToAmpdu (Ptr<const Packet> packet, const WifiMacHeader hdr)
       Time tstamp;
       uint8_t tid = GetTid (packet, hdr);
       Ptr<WifiMacQueue> queue;
-      Ptr<Packet> aggPacket;
+      Ptr<const Packet> aggPacket;
       AcIndex ac = QosUtilsMapTidToAc (tid);
       std::map<AcIndex, Ptr<QosTxop> >::const_iterator edcaIt = m_edca.find (ac);
       NS_ASSERT (edcaIt != m_edca.end ());
@@ -2607,7 +2607,7 @@ MacLow::AggregateToAmpdu (Ptr<const Packet> packet, const WifiMacHeader hdr)
               uint8_t blockAckSize = 0;
               bool aggregated = false;
               uint8_t i = 0;
-              aggPacket = newPacket->Copy ();
+              aggPacket = packet;
 
               if (!hdr.IsBlockAckReq ())
                 {
@@ -2689,7 +2689,7 @@ MacLow::AggregateToAmpdu (Ptr<const Packet> packet, const WifiMacHeader hdr)
                     }
 
                   newPacket = peekedPacket->Copy ();
-                  aggPacket = newPacket->Copy ();
+                  aggPacket = peekedPacket;
 
                   newPacket->AddHeader (peekedHdr);
                   AddWifiMacTrailer (newPacket);
@@ -2799,7 +2799,7 @@ MacLow::AggregateToAmpdu (Ptr<const Packet> packet, const WifiMacHeader hdr)
                     {
                       newPacket = packet->Copy ();
                       peekedHdr = hdr;
-                      aggPacket = newPacket->Copy ();
+                      aggPacket = packet;
                       m_aggregateQueue[tid]->Enqueue (Create<WifiMacQueueItem> (aggPacket, peekedHdr));
                       newPacket->AddHeader (peekedHdr);
                       AddWifiMacTrailer (newPacket);
@@ -64,24 +64,12 @@ bool
 MpduAggregator::Aggregate (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const
 {
   NS_LOG_FUNCTION (this);
-  Ptr<Packet> currentPacket;
-  AmpduSubframeHeader currentHdr;
-
   uint8_t padding = CalculatePadding (aggregatedPacket);
   uint32_t actualSize = aggregatedPacket->GetSize ();
 
   if ((4 + packet->GetSize () + actualSize + padding) <= GetMaxAmpduSize ())
     {
-      if (padding)
-        {
-          Ptr<Packet> pad = Create<Packet> (padding);
-          aggregatedPacket->AddAtEnd (pad);
-        }
-      currentHdr.SetLength (static_cast<uint16_t> (packet->GetSize ()));
-      currentPacket = packet->Copy ();
-
-      currentPacket->AddHeader (currentHdr);
-      aggregatedPacket->AddAtEnd (currentPacket);
+      AddSubframe (packet, aggregatedPacket);
       return true;
     }
   return false;
@@ -91,22 +79,19 @@ void
 MpduAggregator::AggregateSingleMpdu (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const
 {
   NS_LOG_FUNCTION (this);
-  Ptr<Packet> currentPacket;
-  AmpduSubframeHeader currentHdr;
-
-  uint8_t padding = CalculatePadding (aggregatedPacket);
-  if (padding)
-    {
-      Ptr<Packet> pad = Create<Packet> (padding);
-      aggregatedPacket->AddAtEnd (pad);
-    }
-
-  currentHdr.SetEof (1);
-  currentHdr.SetLength (static_cast<uint16_t> (packet->GetSize ()));
-  currentPacket = packet->Copy ();
+  AddSubframe (packet, aggregatedPacket);
+}
 
-  currentPacket->AddHeader (currentHdr);
-  aggregatedPacket->AddAtEnd (currentPacket);
+void
+MpduAggregator::AddSubframe (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const
+{
+  NS_LOG_FUNCTION (this << packet->GetSize () << aggregatedPacket->GetSize ());
+  // The padding of the previous subframe, the A-MPDU subframe header and
+  // the MPDU are appended as a single zero-filled area, which the Buffer
+  // merges with the zero-filled area of the aggregated packet without
+  // copying any byte.
+  uint32_t subframeSize = CalculatePadding (aggregatedPacket) + 4 + packet->GetSize ();
+  aggregatedPacket->AddAtEnd (Create<Packet> (subframeSize));
 }
 
 void
@@ -165,7 +150,7 @@ MpduAggregator::Deaggregate (Ptr<Packet> aggregatedPacket)
   DeaggregatedMpdus set;
 
   AmpduSubframeHeader hdr;
-  Ptr<Packet> extractedMpdu = Create<Packet> ();
+  Ptr<Packet> extractedMpdu;
   uint32_t maxSize = aggregatedPacket->GetSize ();
   uint16_t extractedLength;
   uint32_t padding;
@@ -175,6 +160,16 @@ MpduAggregator::Deaggregate (Ptr<Packet> aggregatedPacket)
     {
       deserialized += aggregatedPacket->RemoveHeader (hdr);
       extractedLength = hdr.GetLength ();
+      uint32_t trailing = aggregatedPacket->GetSize () - extractedLength;
+      if (trailing < 4)
+        {
+          // Last subframe (MacLow sends each MPDU in its own packet, so
+          // this is the only one): drop the padding and hand over the
+          // packet itself rather than a fragment of it.
+          aggregatedPacket->RemoveAtEnd (trailing);
+          set.push_back (std::make_pair (aggregatedPacket, hdr));
+          break;
+        }
       extractedMpdu = aggregatedPacket->CreateFragment (0, static_cast<uint32_t> (extractedLength));
       aggregatedPacket->RemoveAtStart (extractedLength);
       deserialized += extractedLength;
@@ -77,13 +77,19 @@ public:
    *
    * Adds <i>packet</i> to <i>aggregatedPacket</i>. In concrete aggregator's implementation is
    * specified how and if <i>packet</i> can be added to <i>aggregatedPacket</i>.
+   *
+   * The bytes of <i>packet</i> are not copied: <i>aggregatedPacket</i> only
+   * gets a zero-filled subframe of the same size, so that its size is the
+   * size of the A-MPDU.  The MPDUs are kept by the MacLow, which serializes
+   * them one by one with AddHeaderAndPad when the A-MPDU is sent.
    */
   bool Aggregate (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const;
   /**
    * \param packet the packet we want to insert into <i>aggregatedPacket</i>.
    * \param aggregatedPacket packet that will contain the packet of size <i>packetSize</i>, if aggregation is possible.
    *
-   * This method performs a VHT/HE single MPDU aggregation.
+   * This method performs a VHT/HE single MPDU aggregation.  As with Aggregate,
+   * only the size of <i>packet</i> is added to <i>aggregatedPacket</i>.
    */
   void AggregateSingleMpdu (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const;
   /**
@@ -108,6 +114,10 @@ public:
   /**
    * Deaggregates an A-MPDU by removing the A-MPDU subframe header and padding.
    *
+   * The last MPDU is not copied: it is <i>aggregatedPacket</i> itself,
+   * once the preceding subframes, the subframe header and the padding
+   * have been removed.
+   *
    * \param aggregatedPacket the aggregated packet
    * \return list of deaggragted packets and their A-MPDU subframe headers
    */
@@ -123,6 +133,14 @@ private:
    * Each A-MPDU subframe is padded so that its length is multiple of 4 octets.
    */
   uint8_t CalculatePadding (Ptr<const Packet> packet) const;
+  /**
+   * Add to <i>aggregatedPacket</i> the padding of its last subframe and a
+   * zero-filled subframe of the size of <i>packet</i>.
+   *
+   * \param packet the MPDU
+   * \param aggregatedPacket the A-MPDU
+   */
+  void AddSubframe (Ptr<const Packet> packet, Ptr<Packet> aggregatedPacket) const;
 
   uint16_t m_maxAmpduLength; //!< Maximum length in bytes of A-MPDUs
 };
@@ -160,6 +160,19 @@ GetTid (Ptr<const Packet> packet, const WifiMacHeader hdr)
     }
 }
 
+uint64_t
+QosUtilsGetStationTidKey (Mac48Address address, uint8_t tid)
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t key = tid;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return key;
+}
+
 uint8_t
 SelectQueueByDSField (Ptr<QueueItem> item)
 {
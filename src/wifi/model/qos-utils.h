@@ -22,6 +22,7 @@
 #define QOS_UTILS_H
 
 #include "ns3/ptr.h"
+#include "ns3/mac48-address.h"
 
 namespace ns3 {
 
@@ -135,6 +136,18 @@ bool QosUtilsIsOldPacket (uint16_t startingSeq, uint16_t seqNumber);
  */
 uint8_t GetTid (Ptr<const Packet> packet, const WifiMacHeader hdr);
 
+/**
+ * \ingroup wifi
+ * Combine a station address and a TID into a single integer, used as
+ * the key of the per-station, per-TID tables.
+ *
+ * \param address the address of the station
+ * \param tid the TID
+ *
+ * \return the key of the station and TID
+ */
+uint64_t QosUtilsGetStationTidKey (Mac48Address address, uint8_t tid);
+
   /**
    * \ingroup wifi
    * \brief Determine the tx queue for a given packet
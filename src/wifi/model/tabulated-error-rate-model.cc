@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <limits>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "tabulated-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TabulatedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TabulatedErrorRateModel);
+
+namespace {
+
+/// Number of chunk lengths in the tables, of 1, 16, 256, ... bits
+const uint32_t N_LENGTHS = 7;
+
+/**
+ * \param length the index of a chunk length of the tables
+ * \return the number of bits of this chunk length
+ */
+uint64_t
+GetLengthBits (uint32_t length)
+{
+  return static_cast<uint64_t> (1) << (4 * length);
+}
+
+/**
+ * Interpolate the error rate per bit between two SNRs of a table.
+ *
+ * The logarithm of the error rate per bit is nearly linear in the SNR
+ * when the errors are rare, but not when the success rate per bit
+ * falls towards 0, which is then interpolated instead.
+ *
+ * \param row the logarithms of the error rates per bit at the two SNRs
+ * \param fraction the position between the two SNRs, from 0 to 1
+ * \return the error rate per bit, or NaN if it cannot be interpolated
+ */
+double
+Interpolate (const double *row, double fraction)
+{
+  if (row[0] == row[1])
+    {
+      // Including a success rate of 0 or 1 at both SNRs
+      return std::exp (row[0]);
+    }
+  if (std::isinf (row[0]) || std::isinf (row[1]))
+    {
+      // A success rate of 0 or 1 at one of the SNRs only
+      return std::numeric_limits<double>::quiet_NaN ();
+    }
+  if (row[0] <= 0 && row[1] <= 0)
+    {
+      return std::exp (row[0] + (row[1] - row[0]) * fraction);
+    }
+  double first = std::exp (-std::exp (row[0]));
+  double second = std::exp (-std::exp (row[1]));
+  return -std::log (first + (second - first) * fraction);
+}
+
+} // unnamed namespace
+
+TypeId
+TabulatedErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TabulatedErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TabulatedErrorRateModel> ()
+    .AddAttribute ("ErrorRateModel",
+                   "The error rate model whose chunk success rates are tabulated. "
+                   "A NistErrorRateModel is used if none is set.",
+                   PointerValue (),
+                   MakePointerAccessor (&TabulatedErrorRateModel::m_model),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr",
+                   "The lowest SNR of the tables, in dB.",
+                   DoubleValue (-20.0),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_minSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The highest SNR of the tables, in dB.",
+                   DoubleValue (60.0),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_maxSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("SnrStep",
+                   "The SNR step of the tables, in dB.",
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_snrStepDb),
+                   MakeDoubleChecker<double> (1e-6))
+  ;
+  return tid;
+}
+
+TabulatedErrorRateModel::TabulatedErrorRateModel ()
+  : m_minSnrDb (-20.0),
+    m_maxSnrDb (60.0),
+    m_snrStepDb (0.05)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TabulatedErrorRateModel::~TabulatedErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TabulatedErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_model = 0;
+  m_tables.clear ();
+  ErrorRateModel::DoDispose ();
+}
+
+Ptr<ErrorRateModel>
+TabulatedErrorRateModel::GetModel (void) const
+{
+  if (m_model == 0)
+    {
+      m_model = CreateObject<NistErrorRateModel> ();
+    }
+  return m_model;
+}
+
+void
+TabulatedErrorRateModel::ComputeTable (WifiMode mode, WifiTxVector txVector, std::vector<double> &table) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector);
+  Ptr<ErrorRateModel> model = GetModel ();
+  uint32_t nSnrs = static_cast<uint32_t> (std::floor ((m_maxSnrDb - m_minSnrDb) / m_snrStepDb)) + 1;
+  table.resize (N_LENGTHS * nSnrs);
+  for (uint32_t length = 0; length < N_LENGTHS; ++length)
+    {
+      uint64_t nbits = GetLengthBits (length);
+      for (uint32_t i = 0; i < nSnrs; ++i)
+        {
+          double snr = std::pow (10.0, (m_minSnrDb + i * m_snrStepDb) / 10.0);
+          double psr = std::min (model->GetChunkSuccessRate (mode, txVector, snr, nbits), 1.0);
+          // Infinite when the success rate is 0, -infinite when it is 1
+          table[length * nSnrs + i] = std::log (-std::log (psr) / nbits);
+        }
+    }
+}
+
+double
+TabulatedErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  double x = (10.0 * std::log10 (snr) - m_minSnrDb) / m_snrStepDb;
+  uint32_t nSnrs = static_cast<uint32_t> (std::floor ((m_maxSnrDb - m_minSnrDb) / m_snrStepDb)) + 1;
+  if (nbits == 0 || !(x >= 0) || x >= nSnrs - 1)
+    {
+      return GetModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+
+  uint64_t key = mode.GetUid ()
+    | (static_cast<uint64_t> (txVector.GetChannelWidth ()) << 16)
+    | (static_cast<uint64_t> (txVector.GetGuardInterval ()) << 32)
+    | (static_cast<uint64_t> (txVector.GetNss ()) << 48);
+  std::vector<double> &table = m_tables[key];
+  if (table.empty ())
+    {
+      ComputeTable (mode, txVector, table);
+    }
+
+  uint32_t i = static_cast<uint32_t> (x);
+  double fraction = x - i;
+  uint32_t length = 0;
+  while (length + 1 < N_LENGTHS && GetLengthBits (length + 1) <= nbits)
+    {
+      ++length;
+    }
+  double errorPerBit = Interpolate (&table[length * nSnrs + i], fraction);
+  if (std::isnan (errorPerBit))
+    {
+      // The success rate reaches 0 or 1 between the two SNRs
+      return GetModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  if (length + 1 < N_LENGTHS)
+    {
+      // The longer chunks may have a success rate of 0, and then only
+      // the shorter ones tell the error rate per bit
+      double next = Interpolate (&table[(length + 1) * nSnrs + i], fraction);
+      if (std::isfinite (errorPerBit) && std::isfinite (next))
+        {
+          errorPerBit += (next - errorPerBit) * (nbits - GetLengthBits (length))
+            / (GetLengthBits (length + 1) - GetLengthBits (length));
+        }
+    }
+  return std::exp (-errorPerBit * nbits);
+}
+
+} //namespace ns3
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABULATED_ERROR_RATE_MODEL_H
+#define TABULATED_ERROR_RATE_MODEL_H
+
+#include <map>
+#include <vector>
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model interpolating tables of the chunk success rates
+ * of another error rate model, NistErrorRateModel by default.
+ *
+ * A table is computed the first time a WifiMode is used with a given
+ * channel width, guard interval and number of spatial streams.  It
+ * holds, for SNRs evenly spaced in dB between MinSnr and MaxSnr, and
+ * for chunks of 1, 16, 256, ... 16^6 bits, the logarithm of the error
+ * rate per bit -ln (psr) / nbits.  This quantity does not depend on the
+ * number of bits for the models of the form (1 - pe)^nbits, like the
+ * Nist, Yans and DSSS models.  The success rate of a chunk is
+ * interpolated from it linearly in SNR (dB), or from the success rate
+ * per bit where this one is low, and then linearly in number of bits.
+ * The SNRs outside of the table are passed on to the tabulated model.
+ *
+ * With the default attributes, the success rates of the Nist and Yans
+ * models are reproduced within 1e-3 for the chunks of more than a few
+ * bits.
+ *
+ * The tabulated model must only depend on the mode, the channel width,
+ * the guard interval and the number of spatial streams of the
+ * transmission, and the attributes must be set before the model is
+ * first used.
+ */
+class TabulatedErrorRateModel : public ErrorRateModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TabulatedErrorRateModel ();
+  virtual ~TabulatedErrorRateModel ();
+
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * \return the tabulated model, created if not set
+   */
+  Ptr<ErrorRateModel> GetModel (void) const;
+  /**
+   * Compute the table of a mode.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector a TXVECTOR using this mode
+   * \param table the table to fill
+   */
+  void ComputeTable (WifiMode mode, WifiTxVector txVector, std::vector<double> &table) const;
+
+  mutable Ptr<ErrorRateModel> m_model; //!< Tabulated error rate model
+  double m_minSnrDb;                   //!< Lowest SNR of the tables, in dB
+  double m_maxSnrDb;                   //!< Highest SNR of the tables, in dB
+  double m_snrStepDb;                  //!< SNR step of the tables, in dB
+  /// Tables by mode, channel width, guard interval and number of spatial streams
+  mutable std::map<uint64_t, std::vector<double> > m_tables;
+};
+
+} //namespace ns3
+
+#endif /* TABULATED_ERROR_RATE_MODEL_H */
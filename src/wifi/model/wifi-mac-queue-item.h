@@ -24,6 +24,7 @@
 #ifndef WIFI_MAC_QUEUE_ITEM_H
 #define WIFI_MAC_QUEUE_ITEM_H
 
+#include <list>
 #include "ns3/nstime.h"
 #include "ns3/queue.h"
 #include "wifi-mac-header.h"
@@ -31,12 +32,16 @@
 namespace ns3 {
 
 class QosBlockedDestinations;
+class WifiMacQueue;
 
 /**
  * \ingroup wifi
  *
  * WifiMacQueueItem stores (const) packets along with their Wifi MAC headers
  * and the time when they were enqueued.
+ *
+ * An item also holds its positions in the lists with which a WifiMacQueue
+ * finds it, hence it must not be in two WifiMacQueues at the same time.
  */
 class WifiMacQueueItem : public SimpleRefCount<WifiMacQueueItem>
 {
@@ -102,9 +107,18 @@ private:
    */
   WifiMacQueueItem &operator = (const WifiMacQueueItem &);
 
+  friend class WifiMacQueue;
+
+  /// Position of an item in a WifiMacQueue
+  typedef std::list<Ptr<WifiMacQueueItem> >::const_iterator Position;
+  /// Position of an item in a list of positions of a WifiMacQueue
+  typedef std::list<Position>::iterator PositionListIterator;
+
   Ptr<const Packet> m_packet;  //!< The packet contained in this queue item
   WifiMacHeader m_header;      //!< Wifi MAC header associated with the packet
   Time m_tstamp;               //!< timestamp when the packet arrived at the queue
+  PositionListIterator m_byAge;           //!< position in the WifiMacQueue list by timestamp
+  PositionListIterator m_byTidAndAddress; //!< position in the WifiMacQueue list of the TID and destination
 };
 
 
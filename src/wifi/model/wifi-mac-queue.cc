@@ -21,9 +21,11 @@
  *          Stefano Avallone <stavallo@unina.it>
  */
 
+#include <iterator>
 #include "ns3/simulator.h"
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
+#include "qos-utils.h"
 
 namespace ns3 {
 
@@ -74,20 +76,80 @@ WifiMacQueue::GetMaxDelay (void) const
   return m_maxDelay;
 }
 
-bool
-WifiMacQueue::TtlExceeded (ConstIterator &it)
+void
+WifiMacQueue::RemoveExpired (void)
 {
   NS_LOG_FUNCTION (this);
-
-  if (Simulator::Now () > (*it)->GetTimeStamp () + m_maxDelay)
+  Time now = Simulator::Now ();
+  while (!m_byAge.empty () && now > (*m_byAge.front ())->GetTimeStamp () + m_maxDelay)
     {
       NS_LOG_DEBUG ("Removing packet that stayed in the queue for too long (" <<
-                    Simulator::Now () - (*it)->GetTimeStamp () << ")");
-      auto curr = it++;
-      DoRemove (curr);
-      return true;
+                    now - (*m_byAge.front ())->GetTimeStamp () << ")");
+      Drop (m_byAge.front ());
     }
-  return false;
+}
+
+bool
+WifiMacQueue::Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+  NS_ASSERT (pos == Head () || pos == Tail ());
+  bool atTail = (pos == Tail ());
+  if (!DoEnqueue (pos, item))
+    {
+      return false;
+    }
+  ConstIterator it = std::prev (pos);
+
+  // Items are usually enqueued at the time they are created, hence after
+  // all the others
+  PositionList::iterator age = m_byAge.end ();
+  while (age != m_byAge.begin () && (*(*std::prev (age)))->GetTimeStamp () > item->GetTimeStamp ())
+    {
+      age--;
+    }
+  item->m_byAge = m_byAge.insert (age, it);
+
+  if (item->GetHeader ().IsQosData ())
+    {
+      PositionList &list = m_byTidAndAddress[QosUtilsGetStationTidKey (item->GetDestinationAddress (), item->GetHeader ().GetQosTid ())];
+      item->m_byTidAndAddress = list.insert (atTail ? list.end () : list.begin (), it);
+    }
+  return true;
+}
+
+void
+WifiMacQueue::Unlink (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<WifiMacQueueItem> item = *pos;
+  m_byAge.erase (item->m_byAge);
+  if (item->GetHeader ().IsQosData ())
+    {
+      auto listIt = m_byTidAndAddress.find (QosUtilsGetStationTidKey (item->GetDestinationAddress (), item->GetHeader ().GetQosTid ()));
+      NS_ASSERT (listIt != m_byTidAndAddress.end ());
+      listIt->second.erase (item->m_byTidAndAddress);
+      if (listIt->second.empty ())
+        {
+          m_byTidAndAddress.erase (listIt);
+        }
+    }
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::Extract (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  Unlink (pos);
+  return DoDequeue (pos);
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::Drop (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  Unlink (pos);
+  return DoRemove (pos);
 }
 
 bool
@@ -97,24 +159,20 @@ WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
+  // if the queue is full, remove the stale packets (if any) in order to make
+  // room for the new packet.
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
     {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
+      RemoveExpired ();
     }
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      Drop (Head ());
     }
 
-  return DoEnqueue (Tail (), item);
+  return Insert (Tail (), item);
 }
 
 bool
@@ -124,36 +182,30 @@ WifiMacQueue::PushFront (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
+  // if the queue is full, remove the stale packets (if any) in order to make
+  // room for the new packet.
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
     {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
+      RemoveExpired ();
     }
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      Drop (Head ());
     }
 
-  return DoEnqueue (Head (), item);
+  return Insert (Head (), item);
 }
 
 Ptr<WifiMacQueueItem>
 WifiMacQueue::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  if (Head () != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoDequeue (it);
-        }
+      return Extract (Head ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -163,17 +215,12 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
+          return Extract (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -184,18 +231,11 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  auto listIt = m_byTidAndAddress.find (QosUtilsGetStationTidKey (dest, tid));
+  if (listIt != m_byTidAndAddress.end ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
-        }
+      return Extract (listIt->second.front ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -205,17 +245,13 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if (!(*it)->GetHeader ().IsQosData ()
+          || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
         {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
+          return Extract (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -243,18 +279,11 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  auto listIt = m_byTidAndAddress.find (QosUtilsGetStationTidKey (dest, tid));
+  if (listIt != m_byTidAndAddress.end ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoPeek (it);
-            }
-
-          it++;
-        }
+      return DoPeek (listIt->second.front ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -264,17 +293,13 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if (!(*it)->GetHeader ().IsQosData ()
+          || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
         {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoPeek (it);
-            }
-
-          it++;
+          return DoPeek (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -285,13 +310,10 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::Remove (void)
 {
   NS_LOG_FUNCTION (this);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  if (Head () != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoRemove (it);
-        }
+      return Drop (Head ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -301,17 +323,13 @@ bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << packet);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpired ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetPacket () == packet)
         {
-          if ((*it)->GetPacket () == packet)
-            {
-              DoRemove (it);
-              return true;
-            }
-
-          it++;
+          Drop (it);
+          return true;
         }
     }
   NS_LOG_DEBUG ("Packet " << packet << " not found in the queue");
@@ -322,19 +340,13 @@ uint32_t
 WifiMacQueue::GetNPacketsByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
+  RemoveExpired ();
   uint32_t nPackets = 0;
-
-  for (auto it = Head (); it != Tail (); )
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              nPackets++;
-            }
-
-          it++;
+          nPackets++;
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
@@ -345,19 +357,12 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
+  RemoveExpired ();
   uint32_t nPackets = 0;
-  for (auto it = Head (); it != Tail (); )
+  auto listIt = m_byTidAndAddress.find (QosUtilsGetStationTidKey (dest, tid));
+  if (listIt != m_byTidAndAddress.end ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
+      nPackets = static_cast<uint32_t> (listIt->second.size ());
     }
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
@@ -367,16 +372,10 @@ bool
 WifiMacQueue::IsEmpty (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          NS_LOG_DEBUG ("returns false");
-          return false;
-        }
-    }
-  NS_LOG_DEBUG ("returns true");
-  return true;
+  RemoveExpired ();
+  bool empty = QueueBase::IsEmpty ();
+  NS_LOG_DEBUG ("returns " << (empty ? "true" : "false"));
+  return empty;
 }
 
 uint32_t
@@ -384,13 +383,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNPackets ();
 }
 
@@ -399,13 +392,7 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNBytes ();
 }
 
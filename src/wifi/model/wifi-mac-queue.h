@@ -24,6 +24,7 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
+#include <unordered_map>
 #include "wifi-mac-queue-item.h"
 
 namespace ns3 {
@@ -44,6 +45,12 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * Besides the FIFO order, the queue keeps its items in a list sorted by
+ * timestamp, so that the stale items are found without scanning the queue,
+ * and the QoS data items in a list per destination and TID, in FIFO order.
+ * Hence PeekByTidAndAddress, DequeueByTidAndAddress and
+ * GetNPacketsByTidAndAddress take a constant time.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -219,18 +226,48 @@ public:
   uint32_t GetNBytes (void);
 
 private:
+  /// List of positions of items in the queue
+  typedef std::list<ConstIterator> PositionList;
+
+  /**
+   * Remove the items that have been in the queue for too long.
+   */
+  void RemoveExpired (void);
+  /**
+   * Insert an item at the head or at the tail of the queue, and add it
+   * to the lists of positions.
+   *
+   * \param pos Head () or Tail ()
+   * \param item the item to enqueue
+   * \return true if success, false if the packet has been dropped
+   */
+  bool Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item);
+  /**
+   * Dequeue the item at the given position.
+   *
+   * \param pos the position of the item
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> Extract (ConstIterator pos);
+  /**
+   * Drop the item at the given position.
+   *
+   * \param pos the position of the item
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> Drop (ConstIterator pos);
   /**
-   * Remove the item pointed to by the iterator <i>it</i> if it has been in the
-   * queue for too long. If the item is removed, the iterator is updated to
-   * point to the item that followed the erased one.
+   * Remove the item at the given position from the lists of positions.
    *
-   * \param it an iterator pointing to the item
-   * \return true if the item is removed, false otherwise
+   * \param pos the position of the item
    */
-  bool TtlExceeded (ConstIterator &it);
+  void Unlink (ConstIterator pos);
 
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
+  PositionList m_byAge;                     //!< Items by increasing timestamp
+  /// Hash table of the QoS data items of each destination and TID, in FIFO order
+  std::unordered_map<uint64_t, PositionList> m_byTidAndAddress;
 
   NS_LOG_TEMPLATE_DECLARE;                  //!< redefinition of the log component
 };
@@ -217,31 +217,31 @@ WifiMac::SetMaxPropagationDelay (Time delay)
 void
 WifiMac::NotifyTx (Ptr<const Packet> packet)
 {
-  m_macTxTrace (packet);
+  NS_TRACE_OPTIONAL (m_macTxTrace, packet);
 }
 
 void
 WifiMac::NotifyTxDrop (Ptr<const Packet> packet)
 {
-  m_macTxDropTrace (packet);
+  NS_TRACE_OPTIONAL (m_macTxDropTrace, packet);
 }
 
 void
 WifiMac::NotifyRx (Ptr<const Packet> packet)
 {
-  m_macRxTrace (packet);
+  NS_TRACE_OPTIONAL (m_macRxTrace, packet);
 }
 
 void
 WifiMac::NotifyPromiscRx (Ptr<const Packet> packet)
 {
-  m_macPromiscRxTrace (packet);
+  NS_TRACE_OPTIONAL (m_macPromiscRxTrace, packet);
 }
 
 void
 WifiMac::NotifyRxDrop (Ptr<const Packet> packet)
 {
-  m_macRxDropTrace (packet);
+  NS_TRACE_OPTIONAL (m_macRxDropTrace, packet);
 }
 
 void
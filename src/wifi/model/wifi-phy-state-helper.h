@@ -185,7 +185,7 @@ public:
    * \param packet the packet that we failed to received
    * \param snr the SNR of the received packet
    */
-  void SwitchFromRxEndError (Ptr<Packet> packet, double snr);
+  void SwitchFromRxEndError (Ptr<const Packet> packet, double snr);
   /**
    * Switch to CCA busy.
    *
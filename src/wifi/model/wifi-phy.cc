@@ -304,6 +304,15 @@ WifiPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiPhy::m_frameCaptureModel),
                    MakePointerChecker <FrameCaptureModel> ())
+    .AddAttribute ("Abstraction",
+                   "If true, the reception of a packet is resolved from the SNIR at its start: "
+                   "the error rates of the PLCP header and payload are computed at once, "
+                   "and the signals arriving later are ignored. This saves an event and "
+                   "the interference computations per received packet, at the cost of accuracy "
+                   "when the interference changes during the packet.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WifiPhy::m_abstraction),
+                   MakeBooleanChecker ())
     .AddTraceSource ("PhyTxBegin",
                      "Trace source indicating a packet "
                      "has begun transmitting over the channel medium",
@@ -373,7 +382,9 @@ WifiPhy::WifiPhy ()
     m_totalAmpduSize (0),
     m_totalAmpduNumSymbols (0),
     m_currentEvent (0),
-    m_wifiRadioEnergyModel (0)
+    m_abstraction (false),
+    m_wifiRadioEnergyModel (0),
+    m_randomBlockIndex (0)
 {
   NS_LOG_FUNCTION (this);
   m_random = CreateObject<UniformRandomVariable> ();
@@ -2241,49 +2252,49 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t fre
 void
 WifiPhy::NotifyTxBegin (Ptr<const Packet> packet)
 {
-  m_phyTxBeginTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyTxBeginTrace, packet);
 }
 
 void
 WifiPhy::NotifyTxEnd (Ptr<const Packet> packet)
 {
-  m_phyTxEndTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyTxEndTrace, packet);
 }
 
 void
 WifiPhy::NotifyTxDrop (Ptr<const Packet> packet)
 {
-  m_phyTxDropTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyTxDropTrace, packet);
 }
 
 void
 WifiPhy::NotifyRxBegin (Ptr<const Packet> packet)
 {
-  m_phyRxBeginTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyRxBeginTrace, packet);
 }
 
 void
 WifiPhy::NotifyRxEnd (Ptr<const Packet> packet)
 {
-  m_phyRxEndTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyRxEndTrace, packet);
 }
 
 void
 WifiPhy::NotifyRxDrop (Ptr<const Packet> packet)
 {
-  m_phyRxDropTrace (packet);
+  NS_TRACE_OPTIONAL (m_phyRxDropTrace, packet);
 }
 
 void
 WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu, SignalNoiseDbm signalNoise)
 {
-  m_phyMonitorSniffRxTrace (packet, channelFreqMhz, txVector, aMpdu, signalNoise);
+  NS_TRACE_OPTIONAL (m_phyMonitorSniffRxTrace, packet, channelFreqMhz, txVector, aMpdu, signalNoise);
 }
 
 void
 WifiPhy::NotifyMonitorSniffTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu)
 {
-  m_phyMonitorSniffTxTrace (packet, channelFreqMhz, txVector, aMpdu);
+  NS_TRACE_OPTIONAL (m_phyMonitorSniffTxTrace, packet, channelFreqMhz, txVector, aMpdu);
 }
 
 void
@@ -2329,10 +2340,13 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, MpduType m
       //send the first MPDU in an MPDU
       m_txMpduReferenceNumber++;
     }
-  MpduInfo aMpdu;
-  aMpdu.type = mpdutype;
-  aMpdu.mpduRefNumber = m_txMpduReferenceNumber;
-  NotifyMonitorSniffTx (packet, GetFrequency (), txVector, aMpdu);
+  if (NS_TRACE_OPTIONAL_ENABLED (m_phyMonitorSniffTxTrace))
+    {
+      MpduInfo aMpdu;
+      aMpdu.type = mpdutype;
+      aMpdu.mpduRefNumber = m_txMpduReferenceNumber;
+      NotifyMonitorSniffTx (packet, GetFrequency (), txVector, aMpdu);
+    }
   m_state->SwitchToTx (txDuration, packet, GetPowerDbm (txVector.GetTxPowerLevel ()), txVector);
 
   Ptr<Packet> newPacket = packet->Copy (); // obtain non-const Packet
@@ -2355,10 +2369,10 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, MpduType m
 }
 
 void
-WifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet, double rxPowerW, Time rxDuration)
+WifiPhy::StartReceivePreambleAndHeader (Ptr<const Packet> packet, double rxPowerW, Time rxDuration)
 {
   WifiPhyTag tag;
-  bool found = packet->RemovePacketTag (tag);
+  bool found = packet->PeekPacketTag (tag);
   if (!found)
     {
       NS_FATAL_ERROR ("Received Wi-Fi Signal with no WifiPhyTag");
@@ -2500,7 +2514,7 @@ WifiPhy::MaybeCcaBusyDuration ()
 }
 
 void
-WifiPhy::StartReceivePacket (Ptr<Packet> packet,
+WifiPhy::StartReceivePacket (Ptr<const Packet> packet,
                              WifiTxVector txVector,
                              MpduType mpdutype,
                              Ptr<Event> event)
@@ -2508,14 +2522,19 @@ WifiPhy::StartReceivePacket (Ptr<Packet> packet,
   NS_LOG_FUNCTION (this << packet << txVector.GetMode () << txVector.GetPreambleType () << +mpdutype);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
-  WifiMode txMode = txVector.GetMode ();
-
-  InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpHeaderSnrPer (event);
+  ReceivePlcpHeader (packet, txVector, m_interference.CalculatePlcpHeaderSnrPer (event));
+}
 
+void
+WifiPhy::ReceivePlcpHeader (Ptr<const Packet> packet,
+                            WifiTxVector txVector,
+                            InterferenceHelper::SnrPer snrPer)
+{
+  NS_LOG_FUNCTION (this << packet << txVector.GetMode ());
+  WifiMode txMode = txVector.GetMode ();
   NS_LOG_DEBUG ("snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per);
 
-  if (m_random->GetValue () > snrPer.per) //plcp reception succeeded
+  if (GetRandomValue () > snrPer.per) //plcp reception succeeded
     {
       if (IsModeSupported (txMode) || IsMcsSupported (txMode))
         {
@@ -2538,14 +2557,21 @@ WifiPhy::StartReceivePacket (Ptr<Packet> packet,
 }
 
 void
-WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event)
+WifiPhy::EndReceive (Ptr<const Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event)
 {
   NS_LOG_FUNCTION (this << packet << event);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
 
   InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  if (m_abstraction)
+    {
+      snrPer = m_startPayloadSnrPer;
+    }
+  else
+    {
+      snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+    }
   m_interference.NotifyRxEnd ();
   m_currentEvent = 0;
 
@@ -2554,17 +2580,24 @@ WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutyp
       NS_LOG_DEBUG ("mode=" << (event->GetPayloadMode ().GetDataRate (event->GetTxVector ())) <<
                     ", snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per << ", size=" << packet->GetSize ());
 
-      if (m_random->GetValue () > snrPer.per)
+      if (GetRandomValue () > snrPer.per)
         {
-          NotifyRxEnd (packet);
-          SignalNoiseDbm signalNoise;
-          signalNoise.signal = WToDbm (event->GetRxPowerW ());
-          signalNoise.noise = WToDbm (event->GetRxPowerW () / snrPer.snr);
-          MpduInfo aMpdu;
-          aMpdu.type = mpdutype;
-          aMpdu.mpduRefNumber = m_rxMpduReferenceNumber;
-          NotifyMonitorSniffRx (packet, GetFrequency (), event->GetTxVector (), aMpdu, signalNoise);
-          m_state->SwitchFromRxEndOk (packet, snrPer.snr, event->GetTxVector ());
+          // the MAC modifies the packet, hence copy the shared packet
+          Ptr<Packet> copy = packet->Copy ();
+          WifiPhyTag tag;
+          copy->RemovePacketTag (tag);
+          NotifyRxEnd (copy);
+          if (NS_TRACE_OPTIONAL_ENABLED (m_phyMonitorSniffRxTrace))
+            {
+              SignalNoiseDbm signalNoise;
+              signalNoise.signal = WToDbm (event->GetRxPowerW ());
+              signalNoise.noise = WToDbm (event->GetRxPowerW () / snrPer.snr);
+              MpduInfo aMpdu;
+              aMpdu.type = mpdutype;
+              aMpdu.mpduRefNumber = m_rxMpduReferenceNumber;
+              NotifyMonitorSniffRx (copy, GetFrequency (), event->GetTxVector (), aMpdu, signalNoise);
+            }
+          m_state->SwitchFromRxEndOk (copy, snrPer.snr, event->GetTxVector ());
         }
       else
         {
@@ -3615,7 +3648,7 @@ WifiPhy::AbortCurrentReception ()
 }
 
 void
-WifiPhy::StartRx (Ptr<Packet> packet, WifiTxVector txVector, MpduType mpdutype, double rxPowerW, Time rxDuration, Ptr<Event> event)
+WifiPhy::StartRx (Ptr<const Packet> packet, WifiTxVector txVector, MpduType mpdutype, double rxPowerW, Time rxDuration, Ptr<Event> event)
 {
   NS_LOG_FUNCTION (this << packet << txVector << +mpdutype << rxPowerW << rxDuration);
   if (rxPowerW > m_edThresholdW) //checked here, no need to check in the payload reception (current implementation assumes constant rx power over the packet duration)
@@ -3668,7 +3701,17 @@ WifiPhy::StartRx (Ptr<Packet> packet, WifiTxVector txVector, MpduType mpdutype,
       NotifyRxBegin (packet);
       m_interference.NotifyRxStart ();
 
-      if (preamble != WIFI_PREAMBLE_NONE)
+      if (m_abstraction)
+        {
+          //the whole reception is decided now, from the SNIR at the start of the packet
+          InterferenceHelper::SnrPer headerSnrPer;
+          m_interference.CalculateStartSnrPer (event, &headerSnrPer, &m_startPayloadSnrPer);
+          if (preamble != WIFI_PREAMBLE_NONE)
+            {
+              ReceivePlcpHeader (packet, txVector, headerSnrPer);
+            }
+        }
+      else if (preamble != WIFI_PREAMBLE_NONE)
         {
           NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
           Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector);
@@ -3695,9 +3738,23 @@ WifiPhy::AssignStreams (int64_t stream)
 {
   NS_LOG_FUNCTION (this << stream);
   m_random->SetStream (stream);
+  m_randomBlock.clear ();
+  m_randomBlockIndex = 0;
   return 1;
 }
 
+double
+WifiPhy::GetRandomValue (void)
+{
+  if (m_randomBlockIndex == m_randomBlock.size ())
+    {
+      m_randomBlock.resize (64);
+      m_random->GetValues (&m_randomBlock[0], m_randomBlock.size ());
+      m_randomBlockIndex = 0;
+    }
+  return m_randomBlock[m_randomBlockIndex++];
+}
+
 std::ostream& operator<< (std::ostream& os, WifiPhyState state)
 {
   switch (state)
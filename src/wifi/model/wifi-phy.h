@@ -22,6 +22,7 @@
 #ifndef WIFI_PHY_H
 #define WIFI_PHY_H
 
+#include <map>
 #include "ns3/event-id.h"
 #include "wifi-mpdu-type.h"
 #include "wifi-phy-standard.h"
@@ -107,11 +108,15 @@ public:
   /**
    * Starting receiving the plcp of a packet (i.e. the first bit of the preamble has arrived).
    *
+   * The packet, which still carries its WifiPhyTag, may be shared by
+   * all the receivers of the transmission, so it is not modified: it
+   * is only copied if it is successfully received and handed to the MAC.
+   *
    * \param packet the arriving packet
    * \param rxPowerW the receive power in W
    * \param rxDuration the duration needed for the reception of the packet
    */
-  void StartReceivePreambleAndHeader (Ptr<Packet> packet,
+  void StartReceivePreambleAndHeader (Ptr<const Packet> packet,
                                       double rxPowerW,
                                       Time rxDuration);
 
@@ -123,7 +128,7 @@ public:
    * \param mpdutype the type of the MPDU as defined in WifiPhy::MpduType.
    * \param event the corresponding event of the first time the packet arrives
    */
-  void StartReceivePacket (Ptr<Packet> packet,
+  void StartReceivePacket (Ptr<const Packet> packet,
                            WifiTxVector txVector,
                            MpduType mpdutype,
                            Ptr<Event> event);
@@ -136,7 +141,7 @@ public:
    * \param mpdutype the type of the MPDU as defined in WifiPhy::MpduType.
    * \param event the corresponding event of the first time the packet arrives
    */
-  void EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event);
+  void EndReceive (Ptr<const Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event);
 
   /**
    * \param packet the packet to send
@@ -1519,6 +1524,14 @@ private:
    * DoInitialize () is called.
    */
   void InitializeFrequencyChannelNumber (void);
+  /**
+   * Draw the uniform value against which a packet error rate is
+   * checked.  The values are drawn from m_random in blocks, in the
+   * same order as one at a time.
+   *
+   * \return a uniform value in [0, 1)
+   */
+  double GetRandomValue (void);
   /**
    * Configure WifiPhy with appropriate channel frequency and
    * supported rates for 802.11a standard.
@@ -1623,13 +1636,24 @@ private:
    * \param rxDuration the duration needed for the reception of the packet
    * \param event the corresponding event of the first time the packet arrives
    */
-  void StartRx (Ptr<Packet> packet,
+  void StartRx (Ptr<const Packet> packet,
                 WifiTxVector txVector,
                 MpduType mpdutype,
                 double rxPowerW,
                 Time rxDuration,
                 Ptr<Event> event);
 
+  /**
+   * Decide whether the PLCP preamble and header of a packet are received.
+   *
+   * \param packet the arriving packet
+   * \param txVector the TXVECTOR of the arriving packet
+   * \param snrPer the SNR and PER of the PLCP header
+   */
+  void ReceivePlcpHeader (Ptr<const Packet> packet,
+                          WifiTxVector txVector,
+                          InterferenceHelper::SnrPer snrPer);
+
   /**
    * The trace source fired when a packet begins the transmission process on
    * the medium.
@@ -1789,8 +1813,13 @@ private:
 
   Ptr<Event> m_currentEvent; //!< Hold the current event
   Ptr<FrameCaptureModel> m_frameCaptureModel; //!< Frame capture model
+  bool m_abstraction;                         //!< Flag if the receptions are resolved from the SNIR at their start
+  InterferenceHelper::SnrPer m_startPayloadSnrPer; //!< SNR and PER of the payload being received, in abstraction mode
   Ptr<WifiRadioEnergyModel> m_wifiRadioEnergyModel; //!< Wifi radio energy model
 
+  std::vector<double> m_randomBlock; //!< Uniform values drawn in advance from m_random
+  std::size_t m_randomBlockIndex;    //!< Index of the next value in m_randomBlock
+
   Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
 };
 
@@ -21,6 +21,7 @@
 #ifndef WIFI_REMOTE_STATION_MANAGER_H
 #define WIFI_REMOTE_STATION_MANAGER_H
 
+#include <unordered_map>
 #include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
@@ -1395,13 +1396,13 @@ private:
   uint32_t GetNFragments (const WifiMacHeader *header, Ptr<const Packet> packet);
 
   /**
-   * A vector of WifiRemoteStations
+   * A hash table of WifiRemoteStations, by address and TID
    */
-  typedef std::vector <WifiRemoteStation *> Stations;
+  typedef std::unordered_map <uint64_t, WifiRemoteStation *> Stations;
   /**
-   * A vector of WifiRemoteStationStates
+   * A hash table of WifiRemoteStationStates, by address
    */
-  typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef std::unordered_map <uint64_t, WifiRemoteStationState *> StationStates;
 
   /**
    * This is a pointer to the WifiPhy associated with this
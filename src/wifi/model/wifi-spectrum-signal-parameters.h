@@ -54,7 +54,7 @@ struct WifiSpectrumSignalParameters : public SpectrumSignalParameters
   /**
    * The packet being transmitted with this signal
    */
-  Ptr<Packet> packet;
+  Ptr<const Packet> packet;
 };
 
 }  // namespace ns3
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <limits>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -27,6 +28,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
+#include "ns3/spatial-index.h"
+#include "ns3/double.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
@@ -52,13 +55,29 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The distance beyond which transmissions are not delivered, in meters. "
+                   "The receivers within range are found with a spatial index.",
+                   DoubleValue (std::numeric_limits<double>::max ()),
+                   MakeDoubleAccessor (&YansWifiChannel::SetMaxRange,
+                                       &YansWifiChannel::GetMaxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MinRxPower",
+                   "The received power, including the receiver gain, below which "
+                   "transmissions are not delivered, in dBm.",
+                   DoubleValue (-std::numeric_limits<double>::max ()),
+                   MakeDoubleAccessor (&YansWifiChannel::m_minRxPowerDbm),
+                   MakeDoubleChecker<double> ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (std::numeric_limits<double>::max ()),
+    m_minRxPowerDbm (-std::numeric_limits<double>::max ())
 {
   NS_LOG_FUNCTION (this);
+  m_index = CreateObject<SpatialIndex> ();
 }
 
 YansWifiChannel::~YansWifiChannel ()
@@ -87,42 +106,76 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  if (m_maxRange == std::numeric_limits<double>::max ())
     {
-      if (sender != (*i))
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
-            {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-            }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
+          SendTo (sender, senderMobility, *i, packet, txPowerDbm, duration);
         }
+      return;
     }
+
+  // Index the PHYs added since the last transmission, when their
+  // mobility models are known
+  for (uint32_t i = m_index->GetN (); i < m_phyList.size (); i++)
+    {
+      m_index->Add (m_phyList[i]->GetMobility ());
+    }
+  std::vector<uint32_t> candidates;
+  m_index->GetCandidates (senderMobility->GetPosition (), m_maxRange, candidates);
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      SendTo (sender, senderMobility, m_phyList[*i], packet, txPowerDbm, duration);
+    }
+}
+
+void
+YansWifiChannel::SendTo (Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                         Ptr<const Packet> packet, double txPowerDbm, Time duration) const
+{
+  if (sender == receiver)
+    {
+      return;
+    }
+  //For now don't account for inter channel interference nor channel bonding
+  if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+  if (m_maxRange != std::numeric_limits<double>::max ()
+      && senderMobility->GetDistanceFrom (receiverMobility) > m_maxRange)
+    {
+      return;
+    }
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  if (rxPowerDbm + receiver->GetRxGain () < m_minRxPowerDbm)
+    {
+      NS_LOG_DEBUG ("not delivered below " << m_minRxPowerDbm << "dbm");
+      return;
+    }
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, packet, rxPowerDbm, duration);
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<Packet> packet, double rxPowerDbm, Time duration)
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const Packet> packet, double rxPowerDbm, Time duration)
 {
   NS_LOG_FUNCTION (phy << packet << rxPowerDbm << duration.GetSeconds ());
   phy->StartReceivePreambleAndHeader (packet, DbmToW (rxPowerDbm + phy->GetRxGain ()), duration);
@@ -156,4 +209,22 @@ YansWifiChannel::AssignStreams (int64_t stream)
   return (currentStream - stream);
 }
 
+void
+YansWifiChannel::SetMaxRange (double maxRange)
+{
+  NS_LOG_FUNCTION (this << maxRange);
+  m_maxRange = maxRange;
+  if (maxRange != std::numeric_limits<double>::max () && maxRange > 0)
+    {
+      // The transmissions then look up three by three cells
+      m_index->SetCellSize (maxRange);
+    }
+}
+
+double
+YansWifiChannel::GetMaxRange (void) const
+{
+  return m_maxRange;
+}
+
 } //namespace ns3
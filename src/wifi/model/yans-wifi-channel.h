@@ -26,6 +26,8 @@
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
+class SpatialIndex;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
@@ -40,6 +42,15 @@ class Time;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, every transmission is delivered to every other PHY on the
+ * same channel number, however weak.  The MaxRange attribute restricts
+ * the deliveries to the PHYs within range, found with a SpatialIndex
+ * of the receivers, and the MinRxPower attribute drops the deliveries
+ * received below a power threshold, after computing the loss.  Both
+ * change the results, since the weak signals no longer add to the
+ * interference, and the random propagation loss models draw fewer
+ * values.
  */
 class YansWifiChannel : public Channel
 {
@@ -97,6 +108,17 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \param maxRange the distance beyond which transmissions are not
+   * delivered, in meters
+   */
+  void SetMaxRange (double maxRange);
+  /**
+   * \return the distance beyond which transmissions are not delivered,
+   * in meters
+   */
+  double GetMaxRange (void) const;
+
 
 private:
   /**
@@ -109,16 +131,34 @@ private:
    * The method then calls the corresponding YansWifiPhy that the first
    * bit of the packet has arrived.
    *
+   * The packet is shared by all the receivers: it is only copied by a
+   * receiver which hands it to its MAC.
+   *
    * \param receiver the device to which the packet is destined
    * \param packet the packet being sent
    * \param txPowerDbm the tx power associated to the packet being sent (dBm)
    * \param duration the transmission duration associated with the packet being sent
    */
-  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const Packet> packet, double txPowerDbm, Time duration);
+  /**
+   * Schedule the reception of a packet by one PHY, unless culled.
+   *
+   * \param sender the phy object from which the packet is originating
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the phy object which may receive the packet
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet, in dBm
+   * \param duration the transmission duration associated with the packet
+   */
+  void SendTo (Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+               Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Distance beyond which transmissions are not delivered (m)
+  double m_minRxPowerDbm;              //!< Power below which receptions are not delivered (dBm)
+  Ptr<SpatialIndex> m_index;           //!< Spatial index of the PHYs, used with a finite range
 };
 
 } //namespace ns3
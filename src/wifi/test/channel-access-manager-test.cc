@@ -264,6 +264,16 @@ private:
    * \param duration the duration
    */
   void AddRxStartEvt (uint64_t at, uint64_t duration);
+  /**
+   * Add PHY off event function
+   * \param at the event time
+   */
+  void AddOffEvt (uint64_t at);
+  /**
+   * Add PHY on event function
+   * \param at the event time
+   */
+  void AddOnEvt (uint64_t at);
 
   typedef std::vector<Ptr<TxopTest> > TxopTests; //!< the TXOP tests typedef
 
@@ -587,6 +597,20 @@ ChannelAccessManagerTest::AddRxStartEvt (uint64_t at, uint64_t duration)
                        MicroSeconds (duration));
 }
 
+void
+ChannelAccessManagerTest::AddOffEvt (uint64_t at)
+{
+  Simulator::Schedule (MicroSeconds (at) - Now (),
+                       &ChannelAccessManager::NotifyOffNow, m_ChannelAccessManager);
+}
+
+void
+ChannelAccessManagerTest::AddOnEvt (uint64_t at)
+{
+  Simulator::Schedule (MicroSeconds (at) - Now (),
+                       &ChannelAccessManager::NotifyOnNow, m_ChannelAccessManager);
+}
+
 void
 ChannelAccessManagerTest::DoRun (void)
 {
@@ -867,6 +891,21 @@ ChannelAccessManagerTest::DoRun (void)
   ExpectCollision (51, 0, 0);
   EndTest ();
 
+  //  20     30    40            45   46
+  //   |  rx  | off |              | tx |
+  //                 |             |
+  //                 on           45 access request.
+  //
+  // The PHY notifies no end of the reception it was turned off in.
+  //
+  StartTest (1, 3, 10);
+  AddDcfState (1);
+  AddRxStartEvt (20, 40);
+  AddOffEvt (30);
+  AddOnEvt (40);
+  AddAccessRequest (45, 1, 45, 0);
+  EndTest ();
+
   //  20     30          50     53      54   55
   //   | busy | switching | sifs | aifsn | tx |
   //                        |
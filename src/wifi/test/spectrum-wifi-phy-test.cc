@@ -28,6 +28,7 @@
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/wifi-phy-listener.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 using namespace ns3;
 
@@ -308,6 +309,74 @@ SpectrumWifiPhyListenerTest::DoRun (void)
   delete m_listener;
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a packet hit by an interferer after its start is
+ * lost with the full reception model, and received in abstraction mode,
+ * which only looks at the SNIR at the start of the packet.
+ */
+class SpectrumWifiPhyAbstractionTest : public SpectrumWifiPhyBasicTest
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param abstraction the Abstraction attribute of the PHY
+   */
+  SpectrumWifiPhyAbstractionTest (bool abstraction);
+  virtual ~SpectrumWifiPhyAbstractionTest ();
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  bool m_abstraction; ///< the Abstraction attribute of the PHY
+  TestPhyListener* m_listener; ///< listener
+};
+
+SpectrumWifiPhyAbstractionTest::SpectrumWifiPhyAbstractionTest (bool abstraction)
+  : SpectrumWifiPhyBasicTest (std::string ("SpectrumWifiPhy test interference after the start of a packet with Abstraction=")
+                              + (abstraction ? "true" : "false")),
+    m_abstraction (abstraction)
+{
+}
+
+SpectrumWifiPhyAbstractionTest::~SpectrumWifiPhyAbstractionTest ()
+{
+}
+
+void
+SpectrumWifiPhyAbstractionTest::DoSetup (void)
+{
+  SpectrumWifiPhyBasicTest::DoSetup ();
+  m_phy->SetAttribute ("Abstraction", BooleanValue (m_abstraction));
+  m_listener = new TestPhyListener;
+  m_phy->RegisterListener (m_listener);
+}
+
+void
+SpectrumWifiPhyAbstractionTest::DoRun (void)
+{
+  double txPowerWatts = 0.010;
+  // A packet alone, received in both modes
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhyAbstractionTest::SendSignal, this, txPowerWatts);
+  // A packet followed during its payload by an interferer as strong
+  Simulator::Schedule (Seconds (2), &SpectrumWifiPhyAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (Seconds (2) + MicroSeconds (100), &SpectrumWifiPhyAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_count, 2, "Didn't end the reception of the right number of packets");
+  NS_TEST_ASSERT_MSG_EQ (m_listener->m_notifyRxStart, 2, "Didn't receive NotifyRxStart");
+  // The abstraction misses the interferer starting after the sync
+  uint32_t expectedOk = m_abstraction ? 2 : 1;
+  uint32_t expectedError = m_abstraction ? 0 : 1;
+  NS_TEST_ASSERT_MSG_EQ (m_listener->m_notifyRxEndOk, expectedOk, "Wrong number of packets received");
+  NS_TEST_ASSERT_MSG_EQ (m_listener->m_notifyRxEndError, expectedError, "Wrong number of packets lost");
+
+  Simulator::Destroy ();
+  delete m_listener;
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -325,6 +394,8 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
 {
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyAbstractionTest (false), TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyAbstractionTest (true), TestCase::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
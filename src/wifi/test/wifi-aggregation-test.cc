@@ -28,6 +28,7 @@
 #include "ns3/mac-tx-middle.h"
 #include "ns3/msdu-aggregator.h"
 #include "ns3/mpdu-aggregator.h"
+#include "ns3/ampdu-subframe-header.h"
 #include "ns3/mgt-headers.h"
 #include "ns3/wifi-remote-station-manager.h"
 
@@ -405,6 +406,69 @@ TwoLevelAggregationTest::DoRun (void)
 }
 
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief A-MPDU Deaggregation Test
+ */
+class AmpduDeaggregationTest : public TestCase
+{
+public:
+  AmpduDeaggregationTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AmpduDeaggregationTest::AmpduDeaggregationTest ()
+  : TestCase ("Check the deaggregation of A-MPDU subframes")
+{
+}
+
+void
+AmpduDeaggregationTest::DoRun (void)
+{
+  Ptr<MpduAggregator> aggregator = CreateObject<MpduAggregator> ();
+
+  // Subframes as sent by MacLow: one MPDU per packet, padded unless last
+  Ptr<Packet> first = Create<Packet> (1001);
+  aggregator->AddHeaderAndPad (first, false, false);
+  Ptr<Packet> last = Create<Packet> (1001);
+  aggregator->AddHeaderAndPad (last, true, false);
+
+  MpduAggregator::DeaggregatedMpdus mpdus = MpduAggregator::Deaggregate (first);
+  NS_TEST_EXPECT_MSG_EQ (mpdus.size (), 1, "Unexpected number of MPDUs");
+  NS_TEST_EXPECT_MSG_EQ (mpdus.front ().first->GetSize (), 1001, "Padding not removed");
+  NS_TEST_EXPECT_MSG_EQ (mpdus.front ().first, first, "MPDU copied");
+  NS_TEST_EXPECT_MSG_EQ (mpdus.front ().second.GetLength (), 1001, "Unexpected subframe length");
+
+  mpdus = MpduAggregator::Deaggregate (last);
+  NS_TEST_EXPECT_MSG_EQ (mpdus.size (), 1, "Unexpected number of MPDUs");
+  NS_TEST_EXPECT_MSG_EQ (mpdus.front ().first->GetSize (), 1001, "Unexpected MPDU size");
+
+  // Several subframes in the same packet
+  Ptr<Packet> ampdu = Create<Packet> (1001);
+  aggregator->AddHeaderAndPad (ampdu, false, false);
+  Ptr<Packet> mpdu = Create<Packet> (500);
+  aggregator->AddHeaderAndPad (mpdu, false, false);
+  ampdu->AddAtEnd (mpdu);
+  mpdu = Create<Packet> (10);
+  aggregator->AddHeaderAndPad (mpdu, true, false);
+  ampdu->AddAtEnd (mpdu);
+
+  mpdus = MpduAggregator::Deaggregate (ampdu);
+  NS_TEST_ASSERT_MSG_EQ (mpdus.size (), 3, "Unexpected number of MPDUs");
+  MpduAggregator::DeaggregatedMpdusCI it = mpdus.begin ();
+  NS_TEST_EXPECT_MSG_EQ ((it++)->first->GetSize (), 1001, "Unexpected size of the first MPDU");
+  NS_TEST_EXPECT_MSG_EQ ((it++)->first->GetSize (), 500, "Unexpected size of the second MPDU");
+  NS_TEST_EXPECT_MSG_EQ (it->first->GetSize (), 10, "Unexpected size of the last MPDU");
+  NS_TEST_EXPECT_MSG_EQ (it->first, ampdu, "Last MPDU copied");
+
+  Simulator::Destroy ();
+}
+
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -422,6 +486,7 @@ WifiAggregationTestSuite::WifiAggregationTestSuite ()
 {
   AddTestCase (new AmpduAggregationTest, TestCase::QUICK);
   AddTestCase (new TwoLevelAggregationTest, TestCase::QUICK);
+  AddTestCase (new AmpduDeaggregationTest, TestCase::QUICK);
 }
 
 static WifiAggregationTestSuite g_wifiAggregationTestSuite; ///< the test suite
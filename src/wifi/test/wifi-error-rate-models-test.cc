@@ -22,6 +22,9 @@
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/tabulated-error-rate-model.h"
+#include "ns3/pointer.h"
 #include "ns3/wifi-tx-vector.h"
 
 using namespace ns3;
@@ -291,6 +294,65 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Tabulated
+ *
+ * Compare the chunk success rates interpolated by TabulatedErrorRateModel
+ * with those of the NIST and YANS models.
+ */
+class WifiErrorRateModelsTestCaseTabulated : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTabulated ();
+  virtual ~WifiErrorRateModelsTestCaseTabulated ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiErrorRateModelsTestCaseTabulated::WifiErrorRateModelsTestCaseTabulated ()
+  : TestCase ("WifiErrorRateModel test case tabulated")
+{
+}
+
+WifiErrorRateModelsTestCaseTabulated::~WifiErrorRateModelsTestCaseTabulated ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::DoRun (void)
+{
+  const char *modes[] = { "OfdmRate6Mbps", "OfdmRate12Mbps", "OfdmRate24Mbps", "OfdmRate54Mbps",
+                          "HtMcs0", "HtMcs3", "HtMcs7", "VhtMcs8", "DsssRate1Mbps" };
+  uint64_t sizes[] = { 7, 24, 100, 1000, 16000, 123456 };
+  Ptr<ErrorRateModel> models[] = { CreateObject<NistErrorRateModel> (), CreateObject<YansErrorRateModel> () };
+  WifiTxVector txVector;
+  for (uint32_t m = 0; m < 2; ++m)
+    {
+      Ptr<TabulatedErrorRateModel> tabulated = CreateObject<TabulatedErrorRateModel> ();
+      tabulated->SetAttribute ("ErrorRateModel", PointerValue (models[m]));
+      for (uint32_t i = 0; i < sizeof (modes) / sizeof (modes[0]); ++i)
+        {
+          WifiMode mode (modes[i]);
+          txVector.SetMode (mode);
+          for (uint32_t j = 0; j < sizeof (sizes) / sizeof (sizes[0]); ++j)
+            {
+              // Outside of the tables, and within
+              for (double snr = -30; snr < 70; snr += 0.13)
+                {
+                  double expected = models[m]->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), sizes[j]);
+                  double ps = tabulated->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), sizes[j]);
+                  NS_TEST_ASSERT_MSG_EQ_TOL (ps, expected, 1e-3, "Wrong success rate of " << sizes[j] << " bits of "
+                                             << mode << " at " << snr << " dB");
+                }
+            }
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +370,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTabulated, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
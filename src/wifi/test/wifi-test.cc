@@ -43,6 +43,10 @@
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/mgt-headers.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/double.h"
+#include "ns3/wifi-mac-queue.h"
+#include <limits>
 
 using namespace ns3;
 
@@ -1690,6 +1694,344 @@ StaWifiMacScanningTestCase::DoRun (void)
   }
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that the MaxRange and MinRxPower attributes of
+ * YansWifiChannel stop the deliveries beyond range or below the
+ * power threshold, and only those.
+ *
+ * A node broadcasts one packet to three receivers at 10m, 100m and
+ * 1000m.  The receiver at 100m has a larger loss than the others.
+ */
+class YansWifiChannelCullingTest : public TestCase
+{
+public:
+  YansWifiChannelCullingTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Broadcast one packet from a node to three receivers, and count
+   * the packets successfully received by each receiver.
+   * \param maxRange the MaxRange attribute of the channel
+   * \param minRxPower the MinRxPower attribute of the channel
+   * \returns the number of packets received at 10m, 100m and 1000m
+   */
+  std::vector<uint32_t> Run (double maxRange, double minRxPower);
+  /**
+   * Count a packet successfully received.
+   * \param count the counter of the receiver
+   * \param packet the packet
+   */
+  static void RxEnd (uint32_t *count, Ptr<const Packet> packet);
+};
+
+YansWifiChannelCullingTest::YansWifiChannelCullingTest ()
+  : TestCase ("Check the culling of the deliveries of YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelCullingTest::RxEnd (uint32_t *count, Ptr<const Packet> packet)
+{
+  (*count)++;
+}
+
+std::vector<uint32_t>
+YansWifiChannelCullingTest::Run (double maxRange, double minRxPower)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("MinRxPower", DoubleValue (minRxPower));
+  Ptr<MatrixPropagationLossModel> loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (50);
+  channel->SetPropagationLossModel (loss);
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  ObjectFactory mac;
+  mac.SetTypeId ("ns3::AdhocWifiMac");
+  ObjectFactory manager;
+  manager.SetTypeId ("ns3::ConstantRateWifiManager");
+  double distances[] = { 0, 10, 100, 1000 };
+  std::vector<uint32_t> counts (3, 0);
+  std::vector<Ptr<WifiNetDevice> > devices;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+      Ptr<WifiMac> wifiMac = mac.Create<WifiMac> ();
+      wifiMac->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (distances[i], 0, 0));
+      node->AggregateObject (mobility);
+      Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+      phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+      phy->SetChannel (channel);
+      phy->SetDevice (dev);
+      phy->SetMobility (mobility);
+      phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      if (i > 0)
+        {
+          phy->TraceConnectWithoutContext ("PhyRxEnd", MakeBoundCallback (&YansWifiChannelCullingTest::RxEnd, &counts[i - 1]));
+        }
+      wifiMac->SetAddress (Mac48Address::Allocate ());
+      dev->SetMac (wifiMac);
+      dev->SetPhy (phy);
+      dev->SetRemoteStationManager (manager.Create<WifiRemoteStationManager> ());
+      node->AddDevice (dev);
+      devices.push_back (dev);
+    }
+  loss->SetLoss (devices[0]->GetNode ()->GetObject<MobilityModel> (),
+                 devices[2]->GetNode ()->GetObject<MobilityModel> (), 80);
+
+  Simulator::Schedule (Seconds (1.0), &WifiNetDevice::Send, devices[0],
+                       Create<Packet> (1000), devices[0]->GetBroadcast (), 1);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return counts;
+}
+
+void
+YansWifiChannelCullingTest::DoRun (void)
+{
+  std::vector<uint32_t> counts = Run (std::numeric_limits<double>::max (), -std::numeric_limits<double>::max ());
+  NS_TEST_EXPECT_MSG_EQ (counts[0], 1, "Packet not received at 10m without culling");
+  NS_TEST_EXPECT_MSG_EQ (counts[1], 1, "Packet not received at 100m without culling");
+  NS_TEST_EXPECT_MSG_EQ (counts[2], 1, "Packet not received at 1000m without culling");
+
+  counts = Run (500, -std::numeric_limits<double>::max ());
+  NS_TEST_EXPECT_MSG_EQ (counts[0], 1, "Packet not received at 10m within range");
+  NS_TEST_EXPECT_MSG_EQ (counts[1], 1, "Packet not received at 100m within range");
+  NS_TEST_EXPECT_MSG_EQ (counts[2], 0, "Packet received at 1000m beyond range");
+
+  counts = Run (std::numeric_limits<double>::max (), -50);
+  NS_TEST_EXPECT_MSG_EQ (counts[0], 1, "Packet not received at 10m above the threshold");
+  NS_TEST_EXPECT_MSG_EQ (counts[1], 0, "Packet received at 100m below the threshold");
+  NS_TEST_EXPECT_MSG_EQ (counts[2], 1, "Packet not received at 1000m above the threshold");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that the receivers of a broadcast share the packet
+ * delivered by YansWifiChannel, and that each receiver still forwards
+ * the whole payload up, after its MAC removed the headers.
+ */
+class YansWifiChannelSharedDeliveryTest : public TestCase
+{
+public:
+  YansWifiChannelSharedDeliveryTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Record the packet whose reception begins.
+   * \param packets the packets received by the PHYs
+   * \param packet the packet
+   */
+  static void RxBegin (std::vector<const Packet *> *packets, Ptr<const Packet> packet);
+  /**
+   * Record the size of a packet forwarded up by a device.
+   * \param sizes the sizes of the packets forwarded up
+   * \param device the device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the sender address
+   * \return true
+   */
+  static bool Receive (std::vector<uint32_t> *sizes, Ptr<NetDevice> device, Ptr<const Packet> packet,
+                       uint16_t protocol, const Address &from);
+};
+
+YansWifiChannelSharedDeliveryTest::YansWifiChannelSharedDeliveryTest ()
+  : TestCase ("Check that YansWifiChannel shares a broadcast packet between the receivers")
+{
+}
+
+void
+YansWifiChannelSharedDeliveryTest::RxBegin (std::vector<const Packet *> *packets, Ptr<const Packet> packet)
+{
+  packets->push_back (PeekPointer (packet));
+}
+
+bool
+YansWifiChannelSharedDeliveryTest::Receive (std::vector<uint32_t> *sizes, Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                            uint16_t protocol, const Address &from)
+{
+  sizes->push_back (packet->GetSize ());
+  return true;
+}
+
+void
+YansWifiChannelSharedDeliveryTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  ObjectFactory mac;
+  mac.SetTypeId ("ns3::AdhocWifiMac");
+  ObjectFactory manager;
+  manager.SetTypeId ("ns3::ConstantRateWifiManager");
+  std::vector<const Packet *> packets;
+  std::vector<uint32_t> sizes;
+  std::vector<Ptr<WifiNetDevice> > devices;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+      Ptr<WifiMac> wifiMac = mac.Create<WifiMac> ();
+      wifiMac->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (10.0 * i, 0, 0));
+      node->AggregateObject (mobility);
+      Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+      phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+      phy->SetChannel (channel);
+      phy->SetDevice (dev);
+      phy->SetMobility (mobility);
+      phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      phy->TraceConnectWithoutContext ("PhyRxBegin", MakeBoundCallback (&YansWifiChannelSharedDeliveryTest::RxBegin, &packets));
+      wifiMac->SetAddress (Mac48Address::Allocate ());
+      dev->SetMac (wifiMac);
+      dev->SetPhy (phy);
+      dev->SetRemoteStationManager (manager.Create<WifiRemoteStationManager> ());
+      node->AddDevice (dev);
+      dev->SetReceiveCallback (MakeBoundCallback (&YansWifiChannelSharedDeliveryTest::Receive, &sizes));
+      devices.push_back (dev);
+    }
+
+  Simulator::Schedule (Seconds (1.0), &WifiNetDevice::Send, devices[0],
+                       Create<Packet> (1000), devices[0]->GetBroadcast (), 1);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (packets.size (), 3, "Packet not received by all the PHYs");
+  NS_TEST_EXPECT_MSG_EQ (packets[1], packets[0], "Packet not shared by the receivers");
+  NS_TEST_EXPECT_MSG_EQ (packets[2], packets[0], "Packet not shared by the receivers");
+  NS_TEST_ASSERT_MSG_EQ (sizes.size (), 3, "Packet not forwarded up by all the receivers");
+  for (uint32_t i = 0; i < sizes.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (sizes[i], 1000, "Wrong size of the packet forwarded up");
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that WifiMacQueue finds the QoS data frames of a
+ * destination and TID in FIFO order, including the frames pushed to the
+ * front of the queue, and drops the frames which stayed too long in it.
+ */
+class WifiMacQueueTidAndAddressTest : public TestCase
+{
+public:
+  WifiMacQueueTidAndAddressTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Enqueue a QoS data frame.
+   *
+   * \param queue the queue
+   * \param dest the destination
+   * \param tid the TID
+   * \param size the size of the packet
+   * \param front whether to push the frame to the front of the queue
+   */
+  void Enqueue (Ptr<WifiMacQueue> queue, Mac48Address dest, uint8_t tid, uint32_t size, bool front);
+  /// Check the queue after the first frames expired
+  void CheckExpired (void);
+
+  Ptr<WifiMacQueue> m_queue; ///< the queue
+  Mac48Address m_first;      ///< the first destination
+  Mac48Address m_second;     ///< the second destination
+};
+
+WifiMacQueueTidAndAddressTest::WifiMacQueueTidAndAddressTest ()
+  : TestCase ("Test the access to a WifiMacQueue by destination and TID")
+{
+}
+
+void
+WifiMacQueueTidAndAddressTest::Enqueue (Ptr<WifiMacQueue> queue, Mac48Address dest, uint8_t tid, uint32_t size, bool front)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetAddr1 (dest);
+  hdr.SetQosTid (tid);
+  Ptr<WifiMacQueueItem> item = Create<WifiMacQueueItem> (Create<Packet> (size), hdr);
+  if (front)
+    {
+      queue->PushFront (item);
+    }
+  else
+    {
+      queue->Enqueue (item);
+    }
+}
+
+void
+WifiMacQueueTidAndAddressTest::CheckExpired (void)
+{
+  // The frames enqueued at 0 s are dropped, not the one enqueued at 50 ms
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_first), 0, "Frames of TID 0 not dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (5, m_first), 1, "Frame of TID 5 dropped too early");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 1, "Wrong number of frames left in the queue");
+  Ptr<const WifiMacQueueItem> item = m_queue->PeekByTidAndAddress (5, m_first);
+  NS_TEST_ASSERT_MSG_NE (item, 0, "Frame of TID 5 not found");
+  NS_TEST_EXPECT_MSG_EQ (item->GetPacket ()->GetSize (), 500, "Wrong frame of TID 5");
+}
+
+void
+WifiMacQueueTidAndAddressTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (100));
+  m_first = Mac48Address ("00:00:00:00:00:01");
+  m_second = Mac48Address ("00:00:00:00:00:02");
+
+  Enqueue (m_queue, m_first, 0, 100, false);
+  Enqueue (m_queue, m_second, 0, 200, false);
+  Enqueue (m_queue, m_first, 0, 101, false);
+  Enqueue (m_queue, m_first, 3, 300, false);
+  Enqueue (m_queue, m_first, 0, 99, true);
+
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_first), 3, "Wrong number of frames of TID 0");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_second), 1, "Wrong number of frames of TID 0");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (3, m_first), 1, "Wrong number of frames of TID 3");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (3, m_second), 0, "Wrong number of frames of TID 3");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (3, m_second), 0, "Unexpected frame of TID 3");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByAddress (m_first), 4, "Wrong number of frames");
+
+  uint32_t expected[] = {99, 100, 101};
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<const WifiMacQueueItem> peeked = m_queue->PeekByTidAndAddress (0, m_first);
+      Ptr<WifiMacQueueItem> item = m_queue->DequeueByTidAndAddress (0, m_first);
+      NS_TEST_ASSERT_MSG_NE (item, 0, "Frame of TID 0 not found");
+      NS_TEST_EXPECT_MSG_EQ (peeked, item, "The peeked frame is not the dequeued one");
+      NS_TEST_EXPECT_MSG_EQ (item->GetPacket ()->GetSize (), expected[i], "Frames not dequeued in FIFO order");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (0, m_first), 0, "Unexpected frame of TID 0");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 2, "Wrong number of frames left in the queue");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue ()->GetPacket ()->GetSize (), 200, "Wrong frame at the head of the queue");
+
+  Enqueue (m_queue, m_first, 0, 102, false);
+  Simulator::Schedule (MilliSeconds (50), &WifiMacQueueTidAndAddressTest::Enqueue, this, m_queue, m_first, 5, 500, false);
+  Simulator::Schedule (MilliSeconds (120), &WifiMacQueueTidAndAddressTest::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_queue = 0;
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1715,6 +2057,9 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2483TestCase, TestCase::QUICK); //Bug 2483
   AddTestCase (new Bug2831TestCase, TestCase::QUICK); //Bug 2831
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
+  AddTestCase (new YansWifiChannelCullingTest, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelSharedDeliveryTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueTidAndAddressTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the time spent building A-MPDUs.  A VHT station keeps its
+ * best effort queue full of frames to its access point, so that every
+ * transmission is an A-MPDU of up to 64 MPDUs.  The frames received
+ * and the wall clock time are printed.
+ *
+ *   ./waf --run "bench-ampdu --size=1000 --time=10"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+namespace {
+
+uint64_t g_received = 0;  //!< Frames received by the access point
+
+void
+MacRx (Ptr<const Packet> packet)
+{
+  ++g_received;
+}
+
+void
+Fill (Ptr<WifiNetDevice> device, Address to, uint32_t size, Time interval)
+{
+  device->Send (Create<Packet> (size), to, 0x0800);
+  Simulator::Schedule (interval, &Fill, device, to, size, interval);
+}
+
+} // unnamed namespace
+
+int main (int argc, char *argv[])
+{
+  uint32_t size = 1000;
+  double time = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("size", "Size of the frames, in bytes", size);
+  cmd.AddValue ("time", "Simulated time, in seconds", time);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  MobilityHelper mobility;
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ac);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("VhtMcs9"),
+                                "ControlMode", StringValue ("VhtMcs0"));
+  Ssid ssid = Ssid ("bench");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes.Get (0));
+  mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (ssid));
+  devices.Add (wifi.Install (phy, mac, nodes.Get (1)));
+  wifi.AssignStreams (devices, 1);
+
+  Config::ConnectWithoutContext ("/NodeList/0/DeviceList/*/$ns3::WifiNetDevice/Mac/MacRx", MakeCallback (&MacRx));
+  // A frame every 10 us is more than the medium can carry
+  Simulator::Schedule (Seconds (1), &Fill, DynamicCast<WifiNetDevice> (devices.Get (1)),
+                       devices.Get (0)->GetAddress (), size, MicroSeconds (10));
+  Simulator::Stop (Seconds (1 + time));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  uint64_t elapsed = clock.End ();
+
+  std::cout << g_received << " frames received, " << elapsed << " ms, "
+            << (g_received > 0 ? elapsed * 1e6 / g_received : 0) << " ns per frame" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
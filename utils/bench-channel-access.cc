@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the events spent on channel access in a saturated network.
+ * Stations close to each other keep their queue full of frames to a
+ * single receiver, so that every MAC contends for the medium all the
+ * time.  The frames received, the simulator events executed
+ * (including the cancelled ones) and the wall clock time are printed.
+ *
+ *   ./waf --run "bench-channel-access --n=20 --time=10"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+namespace {
+
+uint64_t g_received = 0;  //!< Frames received by the receiver
+
+void
+MacRx (Ptr<const Packet> packet)
+{
+  ++g_received;
+}
+
+void
+Fill (Ptr<WifiNetDevice> device, Address to, uint32_t size, Time interval)
+{
+  device->Send (Create<Packet> (size), to, 0x0800);
+  Simulator::Schedule (interval, &Fill, device, to, size, interval);
+}
+
+} // unnamed namespace
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 20;
+  uint32_t size = 1000;
+  double time = 10;
+  bool qos = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "Number of saturated stations", n);
+  cmd.AddValue ("size", "Size of the frames, in bytes", size);
+  cmd.AddValue ("time", "Simulated time, in seconds", time);
+  cmd.AddValue ("qos", "Use QoS MACs, sending on the best effort AC", qos);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (n + 1);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (1.0),
+                                 "GridWidth", UintegerValue (10));
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac", "QosSupported", BooleanValue (qos));
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"),
+                                "ControlMode", StringValue ("OfdmRate24Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  Config::ConnectWithoutContext ("/NodeList/0/DeviceList/*/$ns3::WifiNetDevice/Mac/MacRx", MakeCallback (&MacRx));
+  // A frame every ms from each station is more than the medium can carry
+  for (uint32_t i = 1; i <= n; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (i), &Fill, DynamicCast<WifiNetDevice> (devices.Get (i)),
+                           devices.Get (0)->GetAddress (), size, MilliSeconds (1));
+    }
+  Simulator::Stop (Seconds (time));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  uint64_t elapsed = clock.End ();
+
+  std::cout << g_received << " frames received from " << n << " stations, "
+            << Simulator::GetEventCount () << " events, " << elapsed << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the time spent by the InterferenceHelper of one receiver
+ * hearing many overlapping transmitters.  Every transmitter sends
+ * frames back to back, so that about n signals overlap at any time;
+ * the receiver syncs on a frame whenever it is idle, and computes the
+ * PLCP header and payload error rates as WifiPhy does, with the
+ * NistErrorRateModel or with its tables.
+ *
+ *   ./waf --run "bench-interference --n=200 --time=10 --tabulated=1"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/interference-helper.h"
+
+using namespace ns3;
+
+namespace {
+
+InterferenceHelper g_interference;      //!< The interference of the receiver
+Ptr<UniformRandomVariable> g_random;     //!< Random gaps and powers
+WifiTxVector g_txVector;                 //!< TXVECTOR of all the frames
+Time g_duration;                         //!< Duration of all the frames
+bool g_rxing = false;                    //!< Whether the receiver is synced on a frame
+uint64_t g_frames = 0;                   //!< Frames added to the interference
+uint64_t g_received = 0;                 //!< Frames on which the receiver synced
+double g_perSum = 0;                     //!< Sum of the payload error rates
+
+void
+EndRx (Ptr<Event> event)
+{
+  InterferenceHelper::SnrPer header = g_interference.CalculatePlcpHeaderSnrPer (event);
+  InterferenceHelper::SnrPer payload = g_interference.CalculatePlcpPayloadSnrPer (event);
+  g_interference.NotifyRxEnd ();
+  g_perSum += 1 - (1 - header.per) * (1 - payload.per);
+  g_rxing = false;
+}
+
+void
+Transmit (void)
+{
+  double rxPowerW = DbmToW (g_random->GetValue (-95, -60));
+  Ptr<Event> event = g_interference.Add (Create<Packet> (1000), g_txVector, g_duration, rxPowerW);
+  ++g_frames;
+  if (!g_rxing)
+    {
+      g_rxing = true;
+      ++g_received;
+      g_interference.NotifyRxStart ();
+      Simulator::Schedule (g_duration, &EndRx, event);
+    }
+  else
+    {
+      // As WifiPhy::MaybeCcaBusyDuration
+      g_interference.GetEnergyDuration (DbmToW (-62));
+    }
+  Simulator::Schedule (g_duration + MicroSeconds (g_random->GetInteger (0, 100)), &Transmit);
+}
+
+} // unnamed namespace
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 200;
+  double time = 10;
+  bool tabulated = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "Number of overlapping transmitters", n);
+  cmd.AddValue ("time", "Simulated time, in seconds", time);
+  cmd.AddValue ("tabulated", "Use a TabulatedErrorRateModel", tabulated);
+  cmd.Parse (argc, argv);
+
+  g_random = CreateObject<UniformRandomVariable> ();
+  g_txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  g_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  g_txVector.SetChannelWidth (20);
+  g_duration = CreateObject<YansWifiPhy> ()->CalculateTxDuration (1000, g_txVector, 5180);
+  if (tabulated)
+    {
+      g_interference.SetErrorRateModel (CreateObject<TabulatedErrorRateModel> ());
+    }
+  else
+    {
+      g_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+    }
+  g_interference.SetNoiseFigure (DbToRatio (7));
+
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (g_random->GetInteger (0, g_duration.GetMicroSeconds ())), &Transmit);
+    }
+  Simulator::Stop (Seconds (time));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  uint64_t elapsed = clock.End ();
+
+  std::cout << g_frames << " frames from " << n << " transmitters, "
+            << g_received << " received (mean PER " << (g_received > 0 ? g_perSum / g_received : 0)
+            << ") in " << elapsed << " ms, "
+            << (g_received > 0 ? elapsed * 1000.0 / g_received : 0) << " us per received frame" << std::endl;
+
+  g_interference.EraseEvents ();
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Compare the full reception model of YansWifiPhy with its abstraction
+ * mode, which resolves every reception from the SNIR at its start.
+ * Nodes scattered on a square broadcast frames at random, and the same
+ * scenario is run in both modes.  For each run, the frames received by
+ * the MACs, the PHY receptions ending with and without error, the
+ * simulator events and the wall clock time are printed.
+ *
+ *   ./waf --run "bench-phy-abstraction --n=50 --time=10 --tabulated=1"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+namespace {
+
+uint64_t g_sent = 0;      //!< Frames sent by the nodes
+uint64_t g_macRx = 0;     //!< Frames received by the MACs
+uint64_t g_rxOk = 0;      //!< PHY receptions ending without error
+uint64_t g_rxError = 0;   //!< PHY receptions ending with error
+
+void
+MacRx (Ptr<const Packet> packet)
+{
+  ++g_macRx;
+}
+
+void
+RxOk (Ptr<const Packet> packet, double snr, WifiMode mode, WifiPreamble preamble)
+{
+  ++g_rxOk;
+}
+
+void
+RxError (Ptr<const Packet> packet, double snr)
+{
+  ++g_rxError;
+}
+
+void
+Send (Ptr<NetDevice> device, Ptr<ExponentialRandomVariable> interval, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x0800);
+  ++g_sent;
+  Simulator::Schedule (Seconds (interval->GetValue ()), &Send, device, interval, size);
+}
+
+/**
+ * Run the scenario once.
+ *
+ * \param abstraction the Abstraction attribute of the PHYs
+ * \param tabulated whether to use a TabulatedErrorRateModel
+ * \param n the number of nodes
+ * \param side the side of the square, in meters
+ * \param interval the mean interval between the frames of a node, in seconds
+ * \param size the size of the frames, in bytes
+ * \param time the simulated time, in seconds
+ */
+void
+Run (bool abstraction, bool tabulated, uint32_t n, double side, double interval, uint32_t size, double time)
+{
+  g_sent = g_macRx = g_rxOk = g_rxError = 0;
+  RngSeedManager::SetRun (1);
+
+  NodeContainer nodes;
+  nodes.Create (n);
+  MobilityHelper mobility;
+  std::ostringstream bound;
+  bound << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue (bound.str ()),
+                                 "Y", StringValue (bound.str ()));
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("Abstraction", BooleanValue (abstraction));
+  if (tabulated)
+    {
+      phy.SetErrorRateModel ("ns3::TabulatedErrorRateModel");
+    }
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/MacRx", MakeCallback (&MacRx));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/State/RxOk", MakeCallback (&RxOk));
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/State/RxError", MakeCallback (&RxError));
+
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  start->SetStream (0);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Ptr<ExponentialRandomVariable> gaps = CreateObject<ExponentialRandomVariable> ();
+      gaps->SetAttribute ("Mean", DoubleValue (interval));
+      gaps->SetStream (i + 1);
+      Simulator::Schedule (Seconds (start->GetValue (0, interval)), &Send, devices.Get (i), gaps, size);
+    }
+  Simulator::Stop (Seconds (time));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  uint64_t elapsed = clock.End ();
+
+  std::cout << (abstraction ? "abstraction: " : "full:        ")
+            << g_sent << " frames sent, " << g_macRx << " received by the MACs, "
+            << g_rxOk << " PHY receptions ok, " << g_rxError << " in error, "
+            << Simulator::GetEventCount () << " events, " << elapsed << " ms" << std::endl;
+
+  Simulator::Destroy ();
+}
+
+} // unnamed namespace
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 50;
+  double side = 300;
+  double interval = 0.05;
+  uint32_t size = 1000;
+  double time = 10;
+  bool tabulated = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "Number of nodes", n);
+  cmd.AddValue ("side", "Side of the square holding the nodes, in meters", side);
+  cmd.AddValue ("interval", "Mean interval between the frames of a node, in seconds", interval);
+  cmd.AddValue ("size", "Size of the frames, in bytes", size);
+  cmd.AddValue ("time", "Simulated time, in seconds", time);
+  cmd.AddValue ("tabulated", "Use a TabulatedErrorRateModel", tabulated);
+  cmd.Parse (argc, argv);
+
+  Run (false, tabulated, n, side, interval, size, time);
+  Run (true, tabulated, n, side, interval, size, time);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the time spent by the WifiRemoteStationManager of an AP
+ * looking up its stations.  For every frame exchanged with a random
+ * station on a random TID, the TXVECTOR is selected, the ACK is
+ * reported and a frame from the station is received, as the MAC does.
+ *
+ *   ./waf --run "bench-station-manager --stations=500 --frames=1000000"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t stations = 500;
+  uint32_t frames = 1000000;
+  std::string manager = "ns3::IdealWifiManager";
+
+  CommandLine cmd;
+  cmd.AddValue ("stations", "Number of stations known by the AP", stations);
+  cmd.AddValue ("frames", "Number of frames exchanged", frames);
+  cmd.AddValue ("manager", "TypeId of the WifiRemoteStationManager", manager);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (1);
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac", "QosSupported", BooleanValue (true));
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager (manager);
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  // Initialize the rate control before the simulation starts
+  nodes.Get (0)->Initialize ();
+  Ptr<WifiRemoteStationManager> stationManager = DynamicCast<WifiNetDevice> (devices.Get (0))->GetRemoteStationManager ();
+
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < stations; ++i)
+    {
+      Mac48Address address = Mac48Address::Allocate ();
+      stationManager->AddAllSupportedModes (address);
+      stationManager->SetQosSupport (address, true);
+      stationManager->RecordGotAssocTxOk (address);
+      addresses.push_back (address);
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Ptr<Packet> packet = Create<Packet> (1000);
+  WifiMacHeader header;
+  header.SetType (WIFI_MAC_QOSDATA);
+  WifiMode ackMode = WifiPhy::GetOfdmRate24Mbps ();
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < frames; ++i)
+    {
+      Mac48Address address = addresses[random->GetInteger (0, stations - 1)];
+      header.SetAddr1 (address);
+      header.SetQosTid (random->GetInteger (0, 7));
+      stationManager->GetDataTxVector (address, &header, packet);
+      stationManager->ReportDataOk (address, &header, 30, ackMode, 30, packet->GetSize ());
+      stationManager->ReportRxOk (address, &header, 30, ackMode);
+    }
+  uint64_t elapsed = clock.End ();
+
+  std::cout << frames << " frames with " << stations << " stations in " << elapsed << " ms, "
+            << elapsed * 1e6 / frames << " ns per frame" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the time spent creating and configuring WifiNetDevices
+ * through the helpers.  Device setup is dominated by ObjectFactory
+ * and attribute lookups, so this is a convenient benchmark for
+ * TypeId::LookupAttributeByName and friends.
+ *
+ *   ./waf --run "bench-wifi-install --n=100000"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000;
+  bool config = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "Number of WifiNetDevices to create", n);
+  cmd.AddValue ("config", "Also set an attribute on every device through Config::Set", config);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (n);
+
+  SystemWallClockMs time;
+  time.Start ();
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  uint64_t install = time.End ();
+
+  uint64_t set = 0;
+  if (config)
+    {
+      time.Start ();
+      Config::Set ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mtu", UintegerValue (1500));
+      set = time.End ();
+    }
+
+  std::cout << devices.GetN () << " devices installed in " << install << " ms";
+  if (config)
+    {
+      std::cout << ", Config::Set in " << set << " ms";
+    }
+  std::cout << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measure the time spent by the WifiMacQueue of an AP finding the frames
+ * of a destination and TID.  The queue is kept full of QoS data frames
+ * to random stations, and for each frame enqueued, the frames of a random
+ * station are peeked, counted and dequeued as an A-MPDU is built.
+ *
+ *   ./waf --run "bench-wifi-mac-queue --stations=100 --frames=100000"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t stations = 100;
+  uint32_t frames = 100000;
+  uint32_t queueSize = 2000;
+
+  CommandLine cmd;
+  cmd.AddValue ("stations", "Number of stations served by the AP", stations);
+  cmd.AddValue ("frames", "Number of frames enqueued", frames);
+  cmd.AddValue ("queueSize", "Number of frames in the queue", queueSize);
+  cmd.Parse (argc, argv);
+
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  queue->SetMaxSize (QueueSize (QueueSizeUnit::PACKETS, queueSize + 1));
+  queue->SetMaxDelay (Seconds (1000));
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < stations; ++i)
+    {
+      addresses.push_back (Mac48Address::Allocate ());
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Ptr<Packet> packet = Create<Packet> (1000);
+  WifiMacHeader header;
+  header.SetType (WIFI_MAC_QOSDATA);
+  header.SetQosTid (0);
+  uint64_t dequeued = 0;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < frames; ++i)
+    {
+      header.SetAddr1 (addresses[random->GetInteger (0, stations - 1)]);
+      queue->Enqueue (Create<WifiMacQueueItem> (packet, header));
+      if (queue->GetNPackets () < queueSize)
+        {
+          continue;
+        }
+      Mac48Address address = addresses[random->GetInteger (0, stations - 1)];
+      uint32_t count = queue->GetNPacketsByTidAndAddress (0, address);
+      for (uint32_t j = 0; j < count && j < 64; ++j)
+        {
+          queue->PeekByTidAndAddress (0, address);
+          queue->DequeueByTidAndAddress (0, address);
+          ++dequeued;
+        }
+    }
+  uint64_t elapsed = clock.End ();
+
+  std::cout << frames << " frames to " << stations << " stations, " << dequeued << " dequeued in "
+            << elapsed << " ms, " << elapsed * 1e6 / frames << " ns per frame" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
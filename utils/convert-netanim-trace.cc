@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/*
+ * Convert an animation trace file written by ns3::AnimationInterface
+ * in BINARY_FORMAT to the XML format read by NetAnim:
+ *
+ *   ./waf --run "convert-netanim-trace --in=anim.bin --out=anim.xml"
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/netanim-module.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string in;
+  std::string out;
+
+  CommandLine cmd;
+  cmd.AddValue ("in", "Binary animation trace file to read", in);
+  cmd.AddValue ("out", "XML animation trace file to write", out);
+  cmd.Parse (argc, argv);
+
+  if (in.empty () || out.empty ())
+    {
+      std::cerr << "Both --in and --out are required" << std::endl;
+      return 1;
+    }
+  if (!AnimationInterface::ConvertBinaryTrace (in, out))
+    {
+      std::cerr << "Unable to convert \"" << in << "\" to \"" << out << "\"" << std::endl;
+      return 1;
+    }
+  return 0;
+}
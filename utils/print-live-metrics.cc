@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Poll the metrics file of a running simulation, written by
+ * ns3::SharedMemoryMetrics, and print each new snapshot as one line
+ * of name=value pairs:
+ *
+ *   ./waf --run "print-live-metrics --file=metrics.shm --period=2"
+ *
+ * Reading the file does not interact with the simulation process.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "ns3/core-module.h"
+#include "ns3/shared-memory-metrics.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string file;
+  double period = 1;
+  uint32_t count = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("file", "Metrics file to poll", file);
+  cmd.AddValue ("period", "Wall clock time between two polls, in seconds", period);
+  cmd.AddValue ("count", "Number of snapshots to print, or 0 to poll forever", count);
+  cmd.Parse (argc, argv);
+
+  SharedMemoryMetricsReader reader (file);
+  if (reader.Fail ())
+    {
+      std::cerr << "Unable to map metrics file \"" << file << "\"" << std::endl;
+      return 1;
+    }
+
+  uint64_t last = 0;
+  uint32_t printed = 0;
+  SharedMemoryMetricsReader::Snapshot snapshot;
+  while (count == 0 || printed < count)
+    {
+      if (reader.Read (snapshot) && snapshot.sequence != last)
+        {
+          last = snapshot.sequence;
+          std::cout << snapshot.sequence;
+          for (uint32_t i = 0; i < snapshot.names.size (); ++i)
+            {
+              std::cout << " " << snapshot.names[i] << "=" << snapshot.values[i];
+            }
+          std::cout << std::endl;
+          ++printed;
+        }
+      std::this_thread::sleep_for (std::chrono::duration<double> (period));
+    }
+  return 0;
+}